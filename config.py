@@ -8,6 +8,25 @@ def configure(env):
     pass
 
 
+def get_opts(platform):
+    """Return build options for the ExecuTorch module."""
+    from SCons.Variables import BoolVariable, PathVariable
+
+    return [
+        BoolVariable(
+            "executorch_xnnpack",
+            "Link the ExecuTorch runtime with the XNNPACK CPU delegate (Linux only)",
+            False,
+        ),
+        PathVariable(
+            "executorch_dir",
+            "ExecuTorch checkout built by scripts/build_executorch.py (default: thirdparty/executorch in this module)",
+            "",
+            PathVariable.PathAccept,
+        ),
+    ]
+
+
 def get_doc_classes():
     """Return documentation classes."""
     return [
@@ -15,6 +34,9 @@ def get_doc_classes():
         "ExecuTorchResource",
         "ExecuTorchNode",
         "ExecuTorchLinearRegression",
+        "ExecuTorchPipeline",
+        "ExecuTorchInferenceContext",
+        "ExecuTorchStateSnapshot",
         "ExecuTorchModule",
         "ExecuTorchMemoryManager",
         "ModelContextProtocolServer",
@@ -0,0 +1,237 @@
+/**************************************************************************/
+/*  executorch_container.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "executorch_container.h"
+#include "core/object/worker_thread_pool.h"
+#include <atomic>
+#include <cstring>
+
+namespace {
+
+const char CONTAINER_MAGIC[4] = { 'P', 'T', 'E', 'Z' };
+const uint32_t MIN_CHUNK_SIZE = 4 * 1024;
+const uint32_t MAX_CHUNK_SIZE = 256 * 1024 * 1024;
+
+// One window of chunks, processed by a worker group with one element per chunk
+struct ChunkBatch {
+	Compression::Mode mode = Compression::MODE_ZSTD;
+	uint32_t chunk_size = 0;
+	uint64_t total_size = 0;
+	uint32_t first_chunk = 0;
+
+	uint8_t *uncompressed = nullptr; // Whole model buffer
+	uint8_t *compressed = nullptr; // This window's compressed bytes
+	Vector<uint64_t> compressed_offsets; // Per chunk in the window, plus the end
+	int64_t *compressed_sizes = nullptr; // Per chunk in the window, written by compression
+
+	std::atomic<bool> failed{ false };
+
+	uint64_t get_uncompressed_size(uint32_t chunk) const {
+		uint64_t offset = (uint64_t)chunk * chunk_size;
+		return MIN((uint64_t)chunk_size, total_size - offset);
+	}
+};
+
+void decompress_chunk(void *p_userdata, uint32_t p_index) {
+	ChunkBatch *batch = static_cast<ChunkBatch *>(p_userdata);
+	uint32_t chunk = batch->first_chunk + p_index;
+	uint64_t expected = batch->get_uncompressed_size(chunk);
+	const uint8_t *src = batch->compressed + batch->compressed_offsets[p_index];
+	uint64_t src_size = batch->compressed_offsets[p_index + 1] - batch->compressed_offsets[p_index];
+
+	int64_t written = Compression::decompress(batch->uncompressed + (uint64_t)chunk * batch->chunk_size, expected, src, src_size, batch->mode);
+	if (written != (int64_t)expected) {
+		batch->failed = true;
+	}
+}
+
+void compress_chunk(void *p_userdata, uint32_t p_index) {
+	ChunkBatch *batch = static_cast<ChunkBatch *>(p_userdata);
+	uint32_t chunk = batch->first_chunk + p_index;
+	int64_t written = Compression::compress(batch->compressed + batch->compressed_offsets[p_index], batch->uncompressed + (uint64_t)chunk * batch->chunk_size, batch->get_uncompressed_size(chunk), batch->mode);
+	if (written < 0) {
+		batch->failed = true;
+	}
+	batch->compressed_sizes[p_index] = written;
+}
+
+// Chunks per window: enough to keep every worker busy while bounding the staging buffer
+uint32_t get_window_chunks() {
+	return MAX(WorkerThreadPool::get_singleton()->get_thread_count(), 1) * 2;
+}
+
+} // namespace
+
+bool ExecuTorchContainer::is_container(const Ref<FileAccess> &file) {
+	uint64_t position = file->get_position();
+	char magic[4] = {};
+	bool found = file->get_buffer((uint8_t *)magic, 4) == 4 && memcmp(magic, CONTAINER_MAGIC, 4) == 0;
+	file->seek(position);
+	return found;
+}
+
+Error ExecuTorchContainer::read_header(const Ref<FileAccess> &file, Header &r_header) {
+	char magic[4] = {};
+	if (file->get_buffer((uint8_t *)magic, 4) != 4 || memcmp(magic, CONTAINER_MAGIC, 4) != 0) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	ERR_FAIL_COND_V_MSG(file->get_32() != FORMAT_VERSION, ERR_FILE_UNRECOGNIZED, "Unsupported .ptez format version.");
+
+	Header header;
+	uint32_t mode = file->get_32();
+	ERR_FAIL_COND_V_MSG(mode > Compression::MODE_GZIP, ERR_FILE_CORRUPT, "Unknown .ptez compression mode.");
+	header.mode = (Compression::Mode)mode;
+	header.chunk_size = file->get_32();
+	ERR_FAIL_COND_V_MSG(header.chunk_size < MIN_CHUNK_SIZE || header.chunk_size > MAX_CHUNK_SIZE, ERR_FILE_CORRUPT, "Invalid .ptez chunk size.");
+	header.uncompressed_size = file->get_64();
+
+	// The table must describe exactly the chunks the size implies, and fit in the file
+	uint32_t chunk_count = file->get_32();
+	uint64_t expected_count = (header.uncompressed_size + header.chunk_size - 1) / header.chunk_size;
+	ERR_FAIL_COND_V_MSG(chunk_count != expected_count, ERR_FILE_CORRUPT, "Corrupt .ptez chunk table.");
+	ERR_FAIL_COND_V_MSG(file->get_position() + (uint64_t)chunk_count * 8 > file->get_length(), ERR_FILE_CORRUPT, "Truncated .ptez chunk table.");
+
+	header.chunk_sizes.resize(chunk_count);
+	uint64_t compressed_total = 0;
+	uint64_t max_chunk = Compression::get_max_compressed_buffer_size(header.chunk_size, header.mode);
+	for (uint64_t &size : header.chunk_sizes) {
+		size = file->get_64();
+		ERR_FAIL_COND_V_MSG(size == 0 || size > max_chunk, ERR_FILE_CORRUPT, "Corrupt .ptez chunk table.");
+		compressed_total += size;
+	}
+	ERR_FAIL_COND_V_MSG(file->get_position() + compressed_total > file->get_length(), ERR_FILE_CORRUPT, "Truncated .ptez file.");
+
+	r_header = header;
+	return OK;
+}
+
+Error ExecuTorchContainer::read_chunks(const Ref<FileAccess> &file, const Header &header, uint8_t *r_data, const ProgressCallback &progress) {
+	const uint32_t chunk_count = header.chunk_sizes.size();
+	const uint32_t window_chunks = get_window_chunks();
+	Vector<uint8_t> staging;
+
+	for (uint32_t first = 0; first < chunk_count; first += window_chunks) {
+		uint32_t count = MIN(window_chunks, chunk_count - first);
+
+		ChunkBatch batch;
+		batch.mode = header.mode;
+		batch.chunk_size = header.chunk_size;
+		batch.total_size = header.uncompressed_size;
+		batch.first_chunk = first;
+		batch.uncompressed = r_data;
+		batch.compressed_offsets.resize(count + 1);
+		uint64_t window_bytes = 0;
+		for (uint32_t i = 0; i < count; i++) {
+			batch.compressed_offsets.write[i] = window_bytes;
+			window_bytes += header.chunk_sizes[first + i];
+		}
+		batch.compressed_offsets.write[count] = window_bytes;
+
+		// Only this window's compressed bytes are staged; the output goes straight to its place
+		if ((uint64_t)staging.size() < window_bytes) {
+			ERR_FAIL_COND_V(staging.resize(window_bytes) != OK, ERR_OUT_OF_MEMORY);
+		}
+		batch.compressed = staging.ptrw();
+		if (file->get_buffer(batch.compressed, window_bytes) != window_bytes) {
+			return ERR_FILE_CORRUPT;
+		}
+
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&decompress_chunk, &batch, count, -1, true, "ExecuTorch .ptez decompression");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		ERR_FAIL_COND_V_MSG(batch.failed.load(), ERR_FILE_CORRUPT, "Corrupt .ptez chunk.");
+
+		if (progress && !progress((float)(first + count) / chunk_count)) {
+			return ERR_SKIP;
+		}
+	}
+	return OK;
+}
+
+Error ExecuTorchContainer::write(const Ref<FileAccess> &file, const uint8_t *data, uint64_t size, uint32_t chunk_size, Compression::Mode mode) {
+	ERR_FAIL_COND_V_MSG(chunk_size < MIN_CHUNK_SIZE || chunk_size > MAX_CHUNK_SIZE, ERR_INVALID_PARAMETER, "Invalid .ptez chunk size.");
+	ERR_FAIL_COND_V_MSG(mode > Compression::MODE_GZIP, ERR_INVALID_PARAMETER, "Compression mode cannot write .ptez files.");
+
+	const uint32_t chunk_count = (size + chunk_size - 1) / chunk_size;
+	file->store_buffer((const uint8_t *)CONTAINER_MAGIC, 4);
+	file->store_32(FORMAT_VERSION);
+	file->store_32(mode);
+	file->store_32(chunk_size);
+	file->store_64(size);
+	file->store_32(chunk_count);
+
+	// Sizes are known only after compressing, so the table is filled in at the end
+	uint64_t table_position = file->get_position();
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		file->store_64(0);
+	}
+
+	Vector<uint64_t> chunk_sizes;
+	chunk_sizes.resize(chunk_count);
+	const uint32_t window_chunks = get_window_chunks();
+	const uint64_t max_chunk = Compression::get_max_compressed_buffer_size(chunk_size, mode);
+	Vector<uint8_t> staging;
+	ERR_FAIL_COND_V(staging.resize(max_chunk * window_chunks) != OK, ERR_OUT_OF_MEMORY);
+	Vector<int64_t> compressed_sizes;
+	compressed_sizes.resize(window_chunks);
+
+	for (uint32_t first = 0; first < chunk_count; first += window_chunks) {
+		uint32_t count = MIN(window_chunks, chunk_count - first);
+
+		ChunkBatch batch;
+		batch.mode = mode;
+		batch.chunk_size = chunk_size;
+		batch.total_size = size;
+		batch.first_chunk = first;
+		batch.uncompressed = const_cast<uint8_t *>(data); // Only read when compressing
+		batch.compressed = staging.ptrw();
+		batch.compressed_offsets.resize(count + 1);
+		for (uint32_t i = 0; i <= count; i++) {
+			batch.compressed_offsets.write[i] = i * max_chunk;
+		}
+		batch.compressed_sizes = compressed_sizes.ptrw();
+
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&compress_chunk, &batch, count, -1, true, "ExecuTorch .ptez compression");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		ERR_FAIL_COND_V_MSG(batch.failed.load(), ERR_BUG, "Failed to compress .ptez chunk.");
+
+		for (uint32_t i = 0; i < count; i++) {
+			file->store_buffer(batch.compressed + batch.compressed_offsets[i], batch.compressed_sizes[i]);
+			chunk_sizes.write[first + i] = batch.compressed_sizes[i];
+		}
+	}
+
+	uint64_t end_position = file->get_position();
+	file->seek(table_position);
+	for (uint64_t chunk_size_written : chunk_sizes) {
+		file->store_64(chunk_size_written);
+	}
+	file->seek(end_position);
+	return file->get_error() == OK ? OK : ERR_FILE_CANT_WRITE;
+}
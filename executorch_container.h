@@ -0,0 +1,74 @@
+/**************************************************************************/
+/*  executorch_container.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/compression.h"
+#include "core/io/file_access.h"
+#include "core/templates/vector.h"
+#include <cstdint>
+#include <functional>
+
+/**
+ * ExecuTorchContainer - Chunked, compressed wrapper around a .pte program (.ptez)
+ *
+ * The program is cut into fixed-size chunks that are compressed on their
+ * own (zstd by default) behind a header and a table of compressed sizes.
+ * Every chunk can therefore be decompressed straight into its place in the
+ * final buffer, in parallel with the others, without inflating the whole
+ * file anywhere else first.
+ *
+ * Layout, little endian:
+ *   "PTEZ" | u32 format version | u32 Compression::Mode | u32 chunk size |
+ *   u64 uncompressed size | u32 chunk count | u64 compressed size per chunk |
+ *   compressed chunks in order
+ */
+class ExecuTorchContainer {
+public:
+	static const uint32_t FORMAT_VERSION = 1;
+	static const uint32_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+	struct Header {
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		uint32_t chunk_size = DEFAULT_CHUNK_SIZE;
+		uint64_t uncompressed_size = 0;
+		Vector<uint64_t> chunk_sizes; // Compressed
+	};
+
+	// Called after each batch with the fraction done; return false to cancel
+	typedef std::function<bool(float progress)> ProgressCallback;
+
+	// Checks the magic at the current position without consuming it
+	static bool is_container(const Ref<FileAccess> &file);
+	static Error read_header(const Ref<FileAccess> &file, Header &r_header);
+	// Decompresses the chunks after the header into r_data, which holds uncompressed_size bytes; ERR_SKIP when cancelled
+	static Error read_chunks(const Ref<FileAccess> &file, const Header &header, uint8_t *r_data, const ProgressCallback &progress = ProgressCallback());
+	static Error write(const Ref<FileAccess> &file, const uint8_t *data, uint64_t size, uint32_t chunk_size = DEFAULT_CHUNK_SIZE, Compression::Mode mode = Compression::MODE_ZSTD);
+};
@@ -31,33 +31,50 @@
 #include "executorch_inference.h"
 #include "executorch_runtime.h"
 
+#include "core/io/resource_loader.h"
+
 ExecuTorchInference::ExecuTorchInference(bool auto_manage) :
-		auto_manage_runtime_(auto_manage) {
-	if (auto_manage_runtime_) {
-		runtime_ = std::make_unique<ExecuTorchRuntime>();
-	}
+		runtime_name_(ExecuTorchRuntimeRegistry::DEFAULT_RUNTIME), auto_manage_runtime_(auto_manage) {
 	model_ = Ref<ExecuTorchResource>();
 }
 
 ExecuTorchInference::~ExecuTorchInference() {
+	cancel_requests();
 }
 
 bool ExecuTorchInference::load_model(const std::string &file_path) {
-	if (auto_manage_runtime_ && runtime_) {
-		if (!runtime_->initialize()) {
-			print_error("Failed to initialize ExecuTorch runtime");
-			return false;
-		}
-	}
-
-	model_ = Ref<ExecuTorchResource>(memnew(ExecuTorchResource));
-	bool success = model_->load_from_file(String(file_path.c_str()));
-	if (!success) {
+	// Go through ResourceLoader so nodes pointing at the same path share one cached resource.
+	Error err = OK;
+	Ref<ExecuTorchResource> model = ResourceLoader::load(String(file_path.c_str()), "ExecuTorchResource", ResourceFormatLoader::CACHE_MODE_REUSE, &err);
+	if (err != OK || model.is_null()) {
 		print_error("Failed to load model from: " + String(file_path.c_str()));
+		cancel_requests();
 		model_ = Ref<ExecuTorchResource>();
 		return false;
 	}
 
+	cancel_requests();
+	request_queue_.reset();
+	model_ = model;
+
+	// The runtime belongs to the resource: a name set here moves it there,
+	// otherwise this inference follows whatever the resource already uses.
+	if (runtime_name_set_) {
+		model_->set_runtime_name(String::utf8(runtime_name_.c_str()));
+	} else {
+		runtime_name_ = model_->get_runtime_name().utf8().get_data();
+	}
+
+	// Shared runtimes are created and initialized once by the registry.
+	if (auto_manage_runtime_) {
+		runtime_ = ExecuTorchRuntimeRegistry::get_singleton()->acquire(runtime_name_);
+		if (!runtime_) {
+			print_error("Failed to initialize ExecuTorch runtime");
+			model_ = Ref<ExecuTorchResource>();
+			return false;
+		}
+	}
+
 	print_line("Successfully loaded model: " + String(file_path.c_str()));
 	return true;
 }
@@ -68,35 +85,109 @@ PackedFloat32Array ExecuTorchInference::predict(const PackedFloat32Array &input)
 		return PackedFloat32Array();
 	}
 
-	// Convert PackedFloat32Array to std::vector<float>
-	std::vector<float> input_vec;
-	input_vec.reserve(input.size());
-	for (int64_t i = 0; i < input.size(); i++) {
-		input_vec.push_back(input[i]);
-	}
+	Array input_names = model_->get_input_names();
+	Array output_names = model_->get_output_names();
+	ERR_FAIL_COND_V_MSG(input_names.is_empty() || output_names.is_empty(), PackedFloat32Array(), "Model declares no inputs or outputs.");
 
-	// Use the resource's forward method (check what methods are available)
+	// The array travels into the resource and back by copy-on-write reference.
 	Dictionary inputs;
-	inputs["input"] = input; // Pass the original PackedFloat32Array
+	inputs[input_names[0]] = input;
 	Dictionary outputs = model_->forward(inputs);
 
-	// Extract the output (assuming single output named "output")
-	if (outputs.has("output")) {
-		return outputs["output"];
+	return outputs.get(output_names[0], PackedFloat32Array());
+}
+
+Dictionary ExecuTorchInference::predict_named(const Dictionary &inputs) {
+	if (!model_.is_valid() || !model_->is_loaded()) {
+		print_error("Model not loaded");
+		return Dictionary();
 	}
+	return model_->forward(inputs);
+}
 
-	return PackedFloat32Array();
+int64_t ExecuTorchInference::submit(const PackedFloat32Array &input, ExecuTorchRequestQueue::OverflowPolicy policy) {
+	if (!model_.is_valid() || !model_->is_loaded()) {
+		print_error("Model not loaded");
+		return ExecuTorchRequestQueue::INVALID_TICKET;
+	}
+
+	if (!request_queue_) {
+		request_queue_ = ExecuTorchRequestQueue::acquire(runtime_);
+	}
+
+	// The slot holds the array by copy-on-write reference, like predict()
+	ExecuTorchTensor tensor = ExecuTorchTensor::from_float32(input);
+	int64_t ticket = request_queue_->submit(model_, &tensor, 1, policy);
+	if (ticket != ExecuTorchRequestQueue::INVALID_TICKET) {
+		pending_tickets_.push_back(ticket);
+	}
+	return ticket;
 }
 
-void ExecuTorchInference::set_runtime(ExecuTorchRuntime *external_runtime) {
-	if (auto_manage_runtime_) {
-		// Release our managed runtime
-		runtime_.reset();
-		auto_manage_runtime_ = false;
+bool ExecuTorchInference::is_request_done(int64_t ticket) const {
+	return request_queue_ && request_queue_->is_done(ticket);
+}
+
+PackedFloat32Array ExecuTorchInference::take_result(int64_t ticket) {
+	ERR_FAIL_COND_V_MSG(!_forget_ticket(ticket), PackedFloat32Array(), "Unknown request ticket: " + itos(ticket) + ".");
+
+	Error err = request_queue_->take(ticket, result_tensors_);
+	PackedFloat32Array result;
+	if (err == OK && !result_tensors_.empty()) {
+		err = result_tensors_[0].to_float32(result);
 	}
+	result_tensors_.clear();
+	ERR_FAIL_COND_V_MSG(err != OK, PackedFloat32Array(), "Queued inference failed.");
+	return result;
+}
+
+void ExecuTorchInference::cancel_request(int64_t ticket) {
+	ERR_FAIL_COND_MSG(!_forget_ticket(ticket), "Unknown request ticket: " + itos(ticket) + ".");
+	request_queue_->cancel(ticket);
+}
 
-	// Note: We're not storing the external runtime pointer here
-	// In a real implementation, you'd need to modify ExecuTorchResource
-	// to accept and use the external runtime
-	print_line("External runtime set (implementation pending)");
+void ExecuTorchInference::cancel_requests() {
+	for (int64_t ticket : pending_tickets_) {
+		request_queue_->cancel(ticket);
+	}
+	pending_tickets_.clear();
+}
+
+bool ExecuTorchInference::_forget_ticket(int64_t ticket) {
+	for (size_t i = 0; i < pending_tickets_.size(); i++) {
+		if (pending_tickets_[i] == ticket) {
+			pending_tickets_[i] = pending_tickets_.back();
+			pending_tickets_.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+void ExecuTorchInference::set_runtime(const std::shared_ptr<ExecuTorchRuntime> &external_runtime) {
+	// An explicit runtime pins this inference; the registry is no longer consulted.
+	auto_manage_runtime_ = false;
+	cancel_requests();
+	request_queue_.reset();
+	runtime_ = external_runtime;
+	if (runtime_ && !runtime_->initialize()) {
+		print_error("Failed to initialize external ExecuTorch runtime");
+	}
+}
+
+void ExecuTorchInference::set_runtime_name(const std::string &name) {
+	runtime_name_set_ = true;
+	if (name == runtime_name_) {
+		return;
+	}
+	runtime_name_ = name;
+	if (model_.is_valid()) {
+		model_->set_runtime_name(String::utf8(runtime_name_.c_str()));
+	}
+	if (auto_manage_runtime_) {
+		cancel_requests();
+		request_queue_.reset();
+		// Without a model the runtime is picked up on the next load
+		runtime_ = model_.is_valid() ? ExecuTorchRuntimeRegistry::get_singleton()->acquire(runtime_name_) : nullptr;
+	}
 }
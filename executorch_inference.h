@@ -32,25 +32,52 @@
 
 #include "core/object/ref_counted.h"
 #include "core/variant/variant.h"
+#include "executorch_request_queue.h"
 #include "executorch_resource.h"
 #include "executorch_runtime.h"
 #include <memory>
+#include <vector>
 
 class ExecuTorchInference {
 private:
-	std::unique_ptr<ExecuTorchRuntime> runtime_;
+	std::shared_ptr<ExecuTorchRuntime> runtime_;
+	std::string runtime_name_;
+	bool runtime_name_set_ = false; // Otherwise the name follows the loaded resource
 	Ref<ExecuTorchResource> model_;
 	bool auto_manage_runtime_;
 
+	// Shared with every inference on the same runtime
+	std::shared_ptr<ExecuTorchRequestQueue> request_queue_;
+	std::vector<int64_t> pending_tickets_;
+	std::vector<ExecuTorchTensor> result_tensors_;
+
+	bool _forget_ticket(int64_t ticket);
+
 public:
+	// With auto_manage the runtime comes from ExecuTorchRuntimeRegistry by name
 	ExecuTorchInference(bool auto_manage = true);
 	~ExecuTorchInference();
 
 	bool load_model(const std::string &file_path);
 	PackedFloat32Array predict(const PackedFloat32Array &input);
+	Dictionary predict_named(const Dictionary &inputs);
+
+	// Runs predict() on the runtime's request workers. Tickets are only valid
+	// on the inference that issued them; ExecuTorchRequestQueue::INVALID_TICKET
+	// when the request was dropped.
+	int64_t submit(const PackedFloat32Array &input, ExecuTorchRequestQueue::OverflowPolicy policy);
+	bool is_request_done(int64_t ticket) const;
+	// Waits for the request; empty when it failed
+	PackedFloat32Array take_result(int64_t ticket);
+	void cancel_request(int64_t ticket);
+	void cancel_requests();
+	ExecuTorchRequestQueue *get_request_queue() const { return request_queue_.get(); }
 
 	ExecuTorchRuntime *get_runtime() { return runtime_.get(); }
 	Ref<ExecuTorchResource> get_model() { return model_; }
 
-	void set_runtime(ExecuTorchRuntime *external_runtime);
+	void set_runtime(const std::shared_ptr<ExecuTorchRuntime> &external_runtime);
+	// Applied to the model resource, so it moves every user of that resource
+	void set_runtime_name(const std::string &name);
+	const std::string &get_runtime_name() const { return runtime_name_; }
 };
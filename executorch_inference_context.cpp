@@ -0,0 +1,293 @@
+/**************************************************************************/
+/*  executorch_inference_context.cpp                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "executorch_inference_context.h"
+#include "core/object/class_db.h"
+
+void ExecuTorchStateSnapshot::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_state_names"), &ExecuTorchStateSnapshot::get_state_names);
+	ClassDB::bind_method(D_METHOD("get_state", "input_name"), &ExecuTorchStateSnapshot::get_state);
+}
+
+PackedStringArray ExecuTorchStateSnapshot::get_state_names() const {
+	PackedStringArray names;
+	for (const Entry &entry : entries_) {
+		names.push_back(entry.input_name);
+	}
+	return names;
+}
+
+Variant ExecuTorchStateSnapshot::get_state(const String &input_name) const {
+	for (const Entry &entry : entries_) {
+		if (entry.input_name == input_name) {
+			return entry.value.to_variant();
+		}
+	}
+	ERR_FAIL_V_MSG(Variant(), vformat("No saved state for input '%s'.", input_name));
+}
+
+void ExecuTorchInferenceContext::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_model", "model"), &ExecuTorchInferenceContext::set_model);
+	ClassDB::bind_method(D_METHOD("get_model"), &ExecuTorchInferenceContext::get_model);
+	ClassDB::bind_method(D_METHOD("bind_state", "input_name", "output_name"), &ExecuTorchInferenceContext::bind_state, DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("unbind_state", "input_name"), &ExecuTorchInferenceContext::unbind_state);
+	ClassDB::bind_method(D_METHOD("get_state_names"), &ExecuTorchInferenceContext::get_state_names);
+	ClassDB::bind_method(D_METHOD("reset_state", "input_name"), &ExecuTorchInferenceContext::reset_state, DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("get_state", "input_name"), &ExecuTorchInferenceContext::get_state);
+	ClassDB::bind_method(D_METHOD("set_state", "input_name", "value"), &ExecuTorchInferenceContext::set_state);
+	ClassDB::bind_method(D_METHOD("snapshot_state"), &ExecuTorchInferenceContext::snapshot_state);
+	ClassDB::bind_method(D_METHOD("restore_state", "snapshot"), &ExecuTorchInferenceContext::restore_state);
+	ClassDB::bind_method(D_METHOD("step", "inputs"), &ExecuTorchInferenceContext::step);
+	ClassDB::bind_method(D_METHOD("step_array", "observation"), &ExecuTorchInferenceContext::step_array);
+	ClassDB::bind_method(D_METHOD("get_step_count"), &ExecuTorchInferenceContext::get_step_count);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "model", PROPERTY_HINT_RESOURCE_TYPE, "ExecuTorchResource"), "set_model", "get_model");
+}
+
+void ExecuTorchInferenceContext::set_model(const Ref<ExecuTorchResource> &model) {
+	model_ = model;
+	compiled_ = false;
+	step_count_ = 0;
+	reset_state();
+}
+
+Ref<ExecuTorchResource> ExecuTorchInferenceContext::get_model() const {
+	return model_;
+}
+
+Error ExecuTorchInferenceContext::bind_state(const String &input_name, const String &output_name) {
+	ERR_FAIL_COND_V_MSG(input_name.is_empty(), ERR_INVALID_PARAMETER, "State slots need an input name.");
+	String source = output_name.is_empty() ? input_name : output_name;
+
+	int index = _find_state(input_name);
+	if (index < 0) {
+		StateSlot slot;
+		slot.input_name = input_name;
+		states_.push_back(slot);
+		index = (int)states_.size() - 1;
+	}
+	states_[index].output_name = source;
+	compiled_ = false;
+	return OK;
+}
+
+void ExecuTorchInferenceContext::unbind_state(const String &input_name) {
+	int index = _find_state(input_name);
+	ERR_FAIL_COND_MSG(index < 0, vformat("No state slot for input '%s'.", input_name));
+	states_.erase(states_.begin() + index);
+	compiled_ = false;
+}
+
+PackedStringArray ExecuTorchInferenceContext::get_state_names() const {
+	PackedStringArray names;
+	for (const StateSlot &slot : states_) {
+		names.push_back(slot.input_name);
+	}
+	return names;
+}
+
+void ExecuTorchInferenceContext::reset_state(const String &input_name) {
+	for (StateSlot &slot : states_) {
+		if (input_name.is_empty() || slot.input_name == input_name) {
+			slot.value = ExecuTorchTensor();
+			slot.has_value = false;
+		}
+	}
+}
+
+Variant ExecuTorchInferenceContext::get_state(const String &input_name) const {
+	int index = _find_state(input_name);
+	ERR_FAIL_COND_V_MSG(index < 0, Variant(), vformat("No state slot for input '%s'.", input_name));
+	return states_[index].has_value ? states_[index].value.to_variant() : Variant();
+}
+
+Error ExecuTorchInferenceContext::set_state(const String &input_name, const Variant &value) {
+	int index = _find_state(input_name);
+	ERR_FAIL_COND_V_MSG(index < 0, ERR_DOES_NOT_EXIST, vformat("No state slot for input '%s'.", input_name));
+
+	ExecuTorchTensor tensor;
+	Error err = ExecuTorchTensor::from_variant(value, tensor);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Unsupported value for state '%s'.", input_name));
+	states_[index].value = tensor;
+	states_[index].has_value = true;
+	return OK;
+}
+
+Ref<ExecuTorchStateSnapshot> ExecuTorchInferenceContext::snapshot_state() const {
+	Ref<ExecuTorchStateSnapshot> snapshot;
+	snapshot.instantiate();
+	for (const StateSlot &slot : states_) {
+		if (slot.has_value) {
+			snapshot->entries_.push_back({ slot.input_name, slot.value });
+		}
+	}
+	return snapshot;
+}
+
+Error ExecuTorchInferenceContext::restore_state(const Ref<ExecuTorchStateSnapshot> &snapshot) {
+	ERR_FAIL_COND_V_MSG(snapshot.is_null(), ERR_INVALID_PARAMETER, "No snapshot to restore.");
+	for (const ExecuTorchStateSnapshot::Entry &entry : snapshot->entries_) {
+		ERR_FAIL_COND_V_MSG(_find_state(entry.input_name) < 0, ERR_DOES_NOT_EXIST, vformat("No state slot for input '%s'; state is unchanged.", entry.input_name));
+	}
+
+	// Slots the snapshot leaves out were still zero when it was taken
+	reset_state();
+	for (const ExecuTorchStateSnapshot::Entry &entry : snapshot->entries_) {
+		StateSlot &slot = states_[_find_state(entry.input_name)];
+		slot.value = entry.value;
+		slot.has_value = true;
+	}
+	return OK;
+}
+
+Dictionary ExecuTorchInferenceContext::step(const Dictionary &inputs) {
+	ERR_FAIL_COND_V_MSG(model_.is_null(), Dictionary(), "No model set on the inference context.");
+	Error err = _compile();
+	ERR_FAIL_COND_V(err != OK, Dictionary());
+
+	inputs_.resize(input_names_.size());
+	for (int64_t i = 0; i < input_names_.size(); i++) {
+		int state = input_states_[i];
+		if (state >= 0) {
+			StateSlot &slot = states_[state];
+			if (!slot.has_value) {
+				err = _zero_state(slot);
+				ERR_FAIL_COND_V(err != OK, Dictionary());
+			}
+			inputs_[i] = slot.value;
+			continue;
+		}
+
+		ERR_FAIL_COND_V_MSG(!inputs.has(input_names_[i]), Dictionary(), "Missing input " + String(input_names_[i]) + ".");
+		err = ExecuTorchTensor::from_variant(inputs[input_names_[i]], inputs_[i]);
+		ERR_FAIL_COND_V_MSG(err != OK, Dictionary(), "Failed to convert input " + String(input_names_[i]) + ".");
+	}
+
+	err = model_->forward_tensors(inputs_, outputs_);
+	inputs_.clear();
+	ERR_FAIL_COND_V_MSG(err != OK, Dictionary(), "Inference failed; state is unchanged.");
+	for (size_t s = 0; s < states_.size(); s++) {
+		ERR_FAIL_COND_V_MSG(state_outputs_[s] >= (int)outputs_.size(), Dictionary(), "Model returned fewer outputs than it declares.");
+	}
+
+	// The outputs become the next inputs by handle; nothing is copied
+	for (size_t s = 0; s < states_.size(); s++) {
+		states_[s].value = outputs_[state_outputs_[s]];
+		states_[s].has_value = true;
+	}
+	step_count_++;
+
+	Dictionary result = model_->tensors_to_dictionary(outputs_);
+	for (const StateSlot &slot : states_) {
+		result.erase(slot.output_name);
+	}
+	outputs_.clear();
+	return result;
+}
+
+PackedFloat32Array ExecuTorchInferenceContext::step_array(const PackedFloat32Array &observation) {
+	ERR_FAIL_COND_V_MSG(model_.is_null(), PackedFloat32Array(), "No model set on the inference context.");
+	Error err = _compile();
+	ERR_FAIL_COND_V(err != OK, PackedFloat32Array());
+
+	Dictionary inputs;
+	for (int64_t i = 0; i < input_names_.size(); i++) {
+		if (input_states_[i] < 0) {
+			inputs[input_names_[i]] = observation;
+			break;
+		}
+	}
+	ERR_FAIL_COND_V_MSG(inputs.is_empty(), PackedFloat32Array(), "Every model input is bound to state; use step().");
+
+	Dictionary outputs = step(inputs);
+	for (int64_t i = 0; i < output_names_.size(); i++) {
+		if (outputs.has(output_names_[i])) {
+			return outputs[output_names_[i]];
+		}
+	}
+	return PackedFloat32Array();
+}
+
+int ExecuTorchInferenceContext::_find_state(const String &input_name) const {
+	for (size_t i = 0; i < states_.size(); i++) {
+		if (states_[i].input_name == input_name) {
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+Error ExecuTorchInferenceContext::_compile() {
+	ERR_FAIL_COND_V_MSG(!model_->is_loaded(), ERR_UNCONFIGURED, "Model not loaded. Please load a model before inference.");
+	uint64_t generation = model_->get_model_generation();
+	if (compiled_ && generation == generation_) {
+		return OK;
+	}
+
+	input_names_ = model_->get_input_names();
+	output_names_ = model_->get_output_names();
+	input_states_.assign(input_names_.size(), -1);
+	state_outputs_.assign(states_.size(), -1);
+	for (size_t s = 0; s < states_.size(); s++) {
+		int input = (int)input_names_.find(states_[s].input_name);
+		int output = (int)output_names_.find(states_[s].output_name);
+		ERR_FAIL_COND_V_MSG(input < 0, ERR_DOES_NOT_EXIST, vformat("Model has no input '%s' for state.", states_[s].input_name));
+		ERR_FAIL_COND_V_MSG(output < 0, ERR_DOES_NOT_EXIST, vformat("Model has no output '%s' for state.", states_[s].output_name));
+		input_states_[input] = (int)s;
+		state_outputs_[s] = output;
+	}
+
+	generation_ = generation;
+	compiled_ = true;
+	return OK;
+}
+
+Error ExecuTorchInferenceContext::_zero_state(StateSlot &slot) const {
+	std::shared_ptr<ExecuTorchProgram> program = model_->acquire_program();
+	ERR_FAIL_COND_V_MSG(!program, ERR_UNCONFIGURED, "Model not loaded. Please load a model before inference.");
+
+	for (const ExecuTorchTensorInfo &info : program->input_info) {
+		if (info.name != slot.input_name) {
+			continue;
+		}
+
+		int64_t count = info.get_element_count();
+		ERR_FAIL_COND_V_MSG(count <= 0, ERR_UNCONFIGURED, vformat("State '%s' has no fixed size; set_state() it before the first step.", slot.input_name));
+		PackedFloat32Array zeros;
+		zeros.resize(count);
+		zeros.fill(0.0f);
+		Error err = ExecuTorchTensor::from_float32(zeros, info.shape).convert(info.dtype, slot.value);
+		ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot build a zero state for '%s'.", slot.input_name));
+		slot.has_value = true;
+		return OK;
+	}
+
+	ERR_FAIL_V_MSG(ERR_DOES_NOT_EXIST, vformat("Model has no input '%s' for state.", slot.input_name));
+}
@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  executorch_inference_context.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "executorch_resource.h"
+#include "executorch_tensor.h"
+
+#include <vector>
+
+/**
+ * ExecuTorchStateSnapshot - State slots saved by snapshot_state()
+ *
+ * Opaque to scripts: the values stay native tensors, so dtype, shape and
+ * quantization parameters survive a restore, and they share storage with
+ * the slots they were taken from.
+ */
+class ExecuTorchStateSnapshot : public RefCounted {
+	GDCLASS(ExecuTorchStateSnapshot, RefCounted);
+	friend class ExecuTorchInferenceContext;
+
+private:
+	struct Entry {
+		String input_name;
+		ExecuTorchTensor value;
+	};
+
+	std::vector<Entry> entries_;
+
+protected:
+	static void _bind_methods();
+
+public:
+	// Slots that had a value; the others restore as zeros
+	PackedStringArray get_state_names() const;
+	// The saved value as ExecuTorchInferenceContext.get_state() returns it
+	Variant get_state(const String &input_name) const;
+};
+
+/**
+ * ExecuTorchInferenceContext - Per-caller state for recurrent models
+ *
+ * A state slot ties a model input to the output that replaces it after
+ * every step(), e.g. a GRU's hidden state. Slots hold native tensors
+ * between calls, so each step only carries the new observation; the state
+ * never goes through a Dictionary unless it is snapshotted. Give every
+ * agent its own context over a shared model. A context is not meant to be
+ * stepped from two threads at once.
+ */
+class ExecuTorchInferenceContext : public RefCounted {
+	GDCLASS(ExecuTorchInferenceContext, RefCounted);
+
+private:
+	struct StateSlot {
+		String input_name;
+		String output_name;
+		ExecuTorchTensor value;
+		bool has_value = false; // False means zeros on the next step
+	};
+
+	Ref<ExecuTorchResource> model_;
+	std::vector<StateSlot> states_;
+	uint64_t step_count_ = 0;
+
+	// Resolved by _compile() for one model generation: per declared input its
+	// state slot (or -1), per slot the output that refreshes it
+	bool compiled_ = false;
+	uint64_t generation_ = 0;
+	Array input_names_;
+	Array output_names_;
+	std::vector<int> input_states_;
+	std::vector<int> state_outputs_;
+	std::vector<ExecuTorchTensor> inputs_;
+	std::vector<ExecuTorchTensor> outputs_;
+
+	int _find_state(const String &input_name) const;
+	Error _compile();
+	Error _zero_state(StateSlot &slot) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_model(const Ref<ExecuTorchResource> &model);
+	Ref<ExecuTorchResource> get_model() const;
+
+	// Feeds input_name from output_name (the same name when empty) on every step
+	Error bind_state(const String &input_name, const String &output_name = String());
+	void unbind_state(const String &input_name);
+	PackedStringArray get_state_names() const;
+
+	// Zeroes one slot, or every slot when the name is empty, in the input's declared
+	// shape and dtype; the zeros are filled in by the next step
+	void reset_state(const String &input_name = String());
+	Variant get_state(const String &input_name) const;
+	Error set_state(const String &input_name, const Variant &value);
+	// Cheap: the tensors are shared until the next step replaces them. A
+	// snapshot restores into any context with slots of the same names.
+	Ref<ExecuTorchStateSnapshot> snapshot_state() const;
+	Error restore_state(const Ref<ExecuTorchStateSnapshot> &snapshot);
+
+	// Runs the model with the state slots filled in; returns the outputs that are not state
+	Dictionary step(const Dictionary &inputs);
+	// step() for one observation input; returns the first output that is not state
+	PackedFloat32Array step_array(const PackedFloat32Array &observation);
+	int64_t get_step_count() const { return (int64_t)step_count_; }
+};
@@ -0,0 +1,1504 @@
+/**************************************************************************/
+/*  executorch_kernels.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "executorch_kernels.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EXECUTORCH_KERNELS_SSE2
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+// MSVC accepts any intrinsic in any function
+#define EXECUTORCH_KERNELS_X86_DISPATCH
+#define EXECUTORCH_TARGET_AVX2
+#define EXECUTORCH_TARGET_AVX2_FMA
+#define EXECUTORCH_TARGET_AVX512
+#include <intrin.h>
+#elif defined(__GNUC__) || defined(__clang__)
+#define EXECUTORCH_KERNELS_X86_DISPATCH
+#define EXECUTORCH_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#define EXECUTORCH_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#define EXECUTORCH_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx2,f16c")))
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define EXECUTORCH_KERNELS_NEON
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+#endif
+
+static inline uint32_t _float_bits(float value) {
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static inline float _bits_float(uint32_t bits) {
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+static inline float _quantize_clamp(float value, float lo, float hi) {
+	// Written so NaN lands on the low bound, matching _mm_max_ps / vmaxnmq_f32 lane behaviour.
+	if (!(value >= lo)) {
+		value = lo;
+	}
+	if (value > hi) {
+		value = hi;
+	}
+	return value;
+}
+
+uint16_t ExecuTorchKernels::float32_to_float16_scalar(float value) {
+	const uint32_t f16_max = (127 + 16) << 23;
+	const uint32_t denorm_magic = ((127 - 15) + (23 - 10) + 1) << 23;
+
+	uint32_t bits = _float_bits(value);
+	uint32_t sign = bits & 0x80000000u;
+	bits ^= sign;
+
+	uint16_t result;
+	if (bits >= f16_max) {
+		// Inf or NaN (all exponent bits set); NaN becomes a quiet NaN.
+		result = bits > 0x7F800000u ? 0x7E00 : 0x7C00;
+	} else if (bits < (113u << 23)) {
+		// Subnormal or zero: let the FPU round the mantissa for us.
+		float shifted = _bits_float(bits) + _bits_float(denorm_magic);
+		result = (uint16_t)(_float_bits(shifted) - denorm_magic);
+	} else {
+		uint32_t mant_odd = (bits >> 13) & 1;
+		bits += ((uint32_t)(15 - 127) << 23) + 0xFFF;
+		bits += mant_odd;
+		result = (uint16_t)(bits >> 13);
+	}
+	return result | (uint16_t)(sign >> 16);
+}
+
+float ExecuTorchKernels::float16_to_float32_scalar(uint16_t value) {
+	const uint32_t shifted_exp = 0x7C00u << 13;
+	const float magic = _bits_float(113u << 23);
+
+	uint32_t bits = ((uint32_t)value & 0x7FFF) << 13;
+	uint32_t exp = shifted_exp & bits;
+	bits += (uint32_t)(127 - 15) << 23;
+
+	if (exp == shifted_exp) {
+		bits += (uint32_t)(128 - 16) << 23; // Inf/NaN
+	} else if (exp == 0) {
+		bits += 1u << 23; // Zero/subnormal: renormalize
+		bits = _float_bits(_bits_float(bits) - magic);
+	}
+
+	bits |= ((uint32_t)value & 0x8000) << 16;
+	return _bits_float(bits);
+}
+
+uint16_t ExecuTorchKernels::float32_to_bfloat16_scalar(float value) {
+	uint32_t bits = _float_bits(value);
+	if (std::isnan(value)) {
+		return (uint16_t)((bits >> 16) | 0x40);
+	}
+	bits += 0x7FFF + ((bits >> 16) & 1);
+	return (uint16_t)(bits >> 16);
+}
+
+float ExecuTorchKernels::bfloat16_to_float32_scalar(uint16_t value) {
+	return _bits_float((uint32_t)value << 16);
+}
+
+#ifdef EXECUTORCH_KERNELS_SSE2
+static inline __m128i _float32_to_float16_sse2(__m128 value) {
+	const __m128i sign_mask = _mm_set1_epi32((int)0x80000000u);
+	const __m128i f16_max = _mm_set1_epi32((127 + 16) << 23);
+	const __m128i nan_bit = _mm_set1_epi32(0x200);
+	const __m128i infinity = _mm_set1_epi32(0x7C00);
+	const __m128i min_normal = _mm_set1_epi32((127 - 14) << 23);
+	const __m128i subnormal_magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+	const __m128i normal_bias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+	__m128 just_sign = _mm_and_ps(value, _mm_castsi128_ps(sign_mask));
+	__m128 abs_value = _mm_xor_ps(value, just_sign);
+	__m128i abs_bits = _mm_castps_si128(abs_value);
+
+	__m128 is_nan = _mm_cmpunord_ps(abs_value, abs_value);
+	__m128i is_regular = _mm_cmpgt_epi32(f16_max, abs_bits);
+	__m128i inf_or_nan = _mm_or_si128(_mm_and_si128(_mm_castps_si128(is_nan), nan_bit), infinity);
+	__m128i is_subnormal = _mm_cmpgt_epi32(min_normal, abs_bits);
+
+	__m128 subnormal_sum = _mm_add_ps(abs_value, _mm_castsi128_ps(subnormal_magic));
+	__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(subnormal_sum), subnormal_magic);
+
+	__m128i mant_odd = _mm_srai_epi32(_mm_slli_epi32(abs_bits, 31 - 13), 31);
+	__m128i rounded = _mm_sub_epi32(_mm_add_epi32(abs_bits, normal_bias), mant_odd);
+	__m128i normal = _mm_srli_epi32(rounded, 13);
+
+	__m128i finite = _mm_or_si128(_mm_and_si128(subnormal, is_subnormal), _mm_andnot_si128(is_subnormal, normal));
+	__m128i joined = _mm_or_si128(_mm_and_si128(finite, is_regular), _mm_andnot_si128(is_regular, inf_or_nan));
+
+	// Arithmetic shift keeps each lane in int16 range so _mm_packs_epi32 is lossless.
+	return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(just_sign), 16));
+}
+
+static inline __m128 _float16_to_float32_sse2(__m128i value) {
+	const __m128i no_sign_mask = _mm_set1_epi32(0x7FFF);
+	const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+	const __m128i was_inf_nan = _mm_set1_epi32(0x7BFF);
+	const __m128 inf_nan_exp = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+
+	__m128i exp_mant = _mm_and_si128(no_sign_mask, value);
+	__m128i just_sign = _mm_xor_si128(value, exp_mant);
+	__m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exp_mant, 13)), magic);
+	__m128i is_inf_nan = _mm_cmpgt_epi32(exp_mant, was_inf_nan);
+	__m128 sign_inf = _mm_or_ps(_mm_castsi128_ps(_mm_slli_epi32(just_sign, 16)), _mm_and_ps(_mm_castsi128_ps(is_inf_nan), inf_nan_exp));
+	return _mm_or_ps(scaled, sign_inf);
+}
+
+static inline __m128i _float32_to_bfloat16_sse2(__m128 value) {
+	const __m128i one = _mm_set1_epi32(1);
+	const __m128i rounding_bias = _mm_set1_epi32(0x7FFF);
+	const __m128i quiet_bit = _mm_set1_epi32(0x40);
+
+	__m128i bits = _mm_castps_si128(value);
+	__m128i lsb = _mm_and_si128(_mm_srli_epi32(bits, 16), one);
+	__m128i rounded = _mm_srai_epi32(_mm_add_epi32(bits, _mm_add_epi32(rounding_bias, lsb)), 16);
+	__m128i nan = _mm_or_si128(_mm_srai_epi32(bits, 16), quiet_bit);
+	__m128i is_nan = _mm_castps_si128(_mm_cmpunord_ps(value, value));
+	return _mm_or_si128(_mm_and_si128(is_nan, nan), _mm_andnot_si128(is_nan, rounded));
+}
+#endif
+
+// Baseline loops, built for the compile target (SSE2 on x86-64, Neon on arm64).
+// Every vector loop returns how many elements it handled; the scalar tail is shared.
+
+static size_t _float32_to_float16_baseline(const float *src, uint16_t *dst, size_t count) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2) && defined(__F16C__)
+	for (; i + 8 <= count; i += 8) {
+		__m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128((__m128i *)(dst + i), half);
+	}
+#elif defined(EXECUTORCH_KERNELS_SSE2)
+	for (; i + 8 <= count; i += 8) {
+		__m128i lo = _float32_to_float16_sse2(_mm_loadu_ps(src + i));
+		__m128i hi = _float32_to_float16_sse2(_mm_loadu_ps(src + i + 4));
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(lo, hi));
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	for (; i + 4 <= count; i += 4) {
+		float16x4_t half = vcvt_f16_f32(vld1q_f32(src + i));
+		vst1_u16(dst + i, vreinterpret_u16_f16(half));
+	}
+#endif
+	return i;
+}
+
+static size_t _float16_to_float32_baseline(const uint16_t *src, float *dst, size_t count) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2) && defined(__F16C__)
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(src + i))));
+	}
+#elif defined(EXECUTORCH_KERNELS_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 8 <= count; i += 8) {
+		__m128i half = _mm_loadu_si128((const __m128i *)(src + i));
+		_mm_storeu_ps(dst + i, _float16_to_float32_sse2(_mm_unpacklo_epi16(half, zero)));
+		_mm_storeu_ps(dst + i + 4, _float16_to_float32_sse2(_mm_unpackhi_epi16(half, zero)));
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	for (; i + 4 <= count; i += 4) {
+		vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+	}
+#endif
+	return i;
+}
+
+static size_t _float32_to_bfloat16_baseline(const float *src, uint16_t *dst, size_t count) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	for (; i + 8 <= count; i += 8) {
+		__m128i lo = _float32_to_bfloat16_sse2(_mm_loadu_ps(src + i));
+		__m128i hi = _float32_to_bfloat16_sse2(_mm_loadu_ps(src + i + 4));
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(lo, hi));
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	const uint32x4_t one = vdupq_n_u32(1);
+	const uint32x4_t rounding_bias = vdupq_n_u32(0x7FFF);
+	const uint32x4_t quiet_bit = vdupq_n_u32(0x40);
+	for (; i + 4 <= count; i += 4) {
+		float32x4_t value = vld1q_f32(src + i);
+		uint32x4_t bits = vreinterpretq_u32_f32(value);
+		uint32x4_t lsb = vandq_u32(vshrq_n_u32(bits, 16), one);
+		uint32x4_t rounded = vshrq_n_u32(vaddq_u32(bits, vaddq_u32(rounding_bias, lsb)), 16);
+		uint32x4_t nan = vorrq_u32(vshrq_n_u32(bits, 16), quiet_bit);
+		uint32x4_t is_number = vceqq_f32(value, value);
+		vst1_u16(dst + i, vmovn_u32(vbslq_u32(is_number, rounded, nan)));
+	}
+#endif
+	return i;
+}
+
+static size_t _bfloat16_to_float32_baseline(const uint16_t *src, float *dst, size_t count) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 8 <= count; i += 8) {
+		__m128i half = _mm_loadu_si128((const __m128i *)(src + i));
+		_mm_storeu_ps(dst + i, _mm_castsi128_ps(_mm_unpacklo_epi16(zero, half)));
+		_mm_storeu_ps(dst + i + 4, _mm_castsi128_ps(_mm_unpackhi_epi16(zero, half)));
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	for (; i + 4 <= count; i += 4) {
+		vst1q_f32(dst + i, vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(src + i), 16)));
+	}
+#endif
+	return i;
+}
+
+static size_t _quantize_int8_baseline(const float *src, int8_t *dst, size_t count, float inv_scale, float lo, float hi, int32_t zero_point) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	const __m128 v_inv_scale = _mm_set1_ps(inv_scale);
+	const __m128 v_lo = _mm_set1_ps(lo);
+	const __m128 v_hi = _mm_set1_ps(hi);
+	const __m128i v_zero_point = _mm_set1_epi32(zero_point);
+	for (; i + 16 <= count; i += 16) {
+		__m128i q[4];
+		for (int j = 0; j < 4; j++) {
+			__m128 v = _mm_mul_ps(_mm_loadu_ps(src + i + j * 4), v_inv_scale);
+			v = _mm_min_ps(_mm_max_ps(v, v_lo), v_hi);
+			q[j] = _mm_add_epi32(_mm_cvtps_epi32(v), v_zero_point);
+		}
+		__m128i packed = _mm_packs_epi16(_mm_packs_epi32(q[0], q[1]), _mm_packs_epi32(q[2], q[3]));
+		_mm_storeu_si128((__m128i *)(dst + i), packed);
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	const float32x4_t v_lo = vdupq_n_f32(lo);
+	const float32x4_t v_hi = vdupq_n_f32(hi);
+	const int32x4_t v_zero_point = vdupq_n_s32(zero_point);
+	for (; i + 8 <= count; i += 8) {
+		float32x4_t a = vminq_f32(vmaxnmq_f32(vmulq_n_f32(vld1q_f32(src + i), inv_scale), v_lo), v_hi);
+		float32x4_t b = vminq_f32(vmaxnmq_f32(vmulq_n_f32(vld1q_f32(src + i + 4), inv_scale), v_lo), v_hi);
+		int16x4_t qa = vqmovn_s32(vaddq_s32(vcvtnq_s32_f32(a), v_zero_point));
+		int16x4_t qb = vqmovn_s32(vaddq_s32(vcvtnq_s32_f32(b), v_zero_point));
+		vst1_s8(dst + i, vqmovn_s16(vcombine_s16(qa, qb)));
+	}
+#endif
+	return i;
+}
+
+static size_t _dequantize_int8_baseline(const int8_t *src, float *dst, size_t count, float scale, int32_t zero_point) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	const __m128 v_scale = _mm_set1_ps(scale);
+	const __m128i v_zero_point = _mm_set1_epi32(zero_point);
+	for (; i + 16 <= count; i += 16) {
+		__m128i bytes = _mm_loadu_si128((const __m128i *)(src + i));
+		// Sign-extend 8 -> 16 -> 32 bits with SSE2 only.
+		__m128i words[2] = { _mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8), _mm_srai_epi16(_mm_unpackhi_epi8(bytes, bytes), 8) };
+		for (int j = 0; j < 2; j++) {
+			__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(words[j], words[j]), 16);
+			__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(words[j], words[j]), 16);
+			_mm_storeu_ps(dst + i + j * 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(lo, v_zero_point)), v_scale));
+			_mm_storeu_ps(dst + i + j * 8 + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(hi, v_zero_point)), v_scale));
+		}
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	const int32x4_t v_zero_point = vdupq_n_s32(zero_point);
+	for (; i + 8 <= count; i += 8) {
+		int16x8_t words = vmovl_s8(vld1_s8(src + i));
+		int32x4_t lo = vsubq_s32(vmovl_s16(vget_low_s16(words)), v_zero_point);
+		int32x4_t hi = vsubq_s32(vmovl_s16(vget_high_s16(words)), v_zero_point);
+		vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(lo), scale));
+		vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(hi), scale));
+	}
+#endif
+	return i;
+}
+
+static size_t _quantize_uint8_baseline(const float *src, uint8_t *dst, size_t count, float inv_scale, float lo, float hi, int32_t zero_point) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	const __m128 v_inv_scale = _mm_set1_ps(inv_scale);
+	const __m128 v_lo = _mm_set1_ps(lo);
+	const __m128 v_hi = _mm_set1_ps(hi);
+	const __m128i v_zero_point = _mm_set1_epi32(zero_point);
+	for (; i + 16 <= count; i += 16) {
+		__m128i q[4];
+		for (int j = 0; j < 4; j++) {
+			__m128 v = _mm_mul_ps(_mm_loadu_ps(src + i + j * 4), v_inv_scale);
+			v = _mm_min_ps(_mm_max_ps(v, v_lo), v_hi);
+			q[j] = _mm_add_epi32(_mm_cvtps_epi32(v), v_zero_point);
+		}
+		__m128i packed = _mm_packus_epi16(_mm_packs_epi32(q[0], q[1]), _mm_packs_epi32(q[2], q[3]));
+		_mm_storeu_si128((__m128i *)(dst + i), packed);
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	const float32x4_t v_lo = vdupq_n_f32(lo);
+	const float32x4_t v_hi = vdupq_n_f32(hi);
+	const int32x4_t v_zero_point = vdupq_n_s32(zero_point);
+	for (; i + 8 <= count; i += 8) {
+		float32x4_t a = vminq_f32(vmaxnmq_f32(vmulq_n_f32(vld1q_f32(src + i), inv_scale), v_lo), v_hi);
+		float32x4_t b = vminq_f32(vmaxnmq_f32(vmulq_n_f32(vld1q_f32(src + i + 4), inv_scale), v_lo), v_hi);
+		int16x4_t qa = vqmovn_s32(vaddq_s32(vcvtnq_s32_f32(a), v_zero_point));
+		int16x4_t qb = vqmovn_s32(vaddq_s32(vcvtnq_s32_f32(b), v_zero_point));
+		vst1_u8(dst + i, vqmovun_s16(vcombine_s16(qa, qb)));
+	}
+#endif
+	return i;
+}
+
+static size_t _dequantize_uint8_baseline(const uint8_t *src, float *dst, size_t count, float scale, int32_t zero_point) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	const __m128 v_scale = _mm_set1_ps(scale);
+	const __m128i v_zero_point = _mm_set1_epi32(zero_point);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= count; i += 16) {
+		__m128i bytes = _mm_loadu_si128((const __m128i *)(src + i));
+		__m128i words[2] = { _mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero) };
+		for (int j = 0; j < 2; j++) {
+			__m128i lo = _mm_unpacklo_epi16(words[j], zero);
+			__m128i hi = _mm_unpackhi_epi16(words[j], zero);
+			_mm_storeu_ps(dst + i + j * 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(lo, v_zero_point)), v_scale));
+			_mm_storeu_ps(dst + i + j * 8 + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(hi, v_zero_point)), v_scale));
+		}
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	const int32x4_t v_zero_point = vdupq_n_s32(zero_point);
+	for (; i + 8 <= count; i += 8) {
+		int16x8_t words = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src + i)));
+		int32x4_t lo = vsubq_s32(vmovl_s16(vget_low_s16(words)), v_zero_point);
+		int32x4_t hi = vsubq_s32(vmovl_s16(vget_high_s16(words)), v_zero_point);
+		vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(lo), scale));
+		vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(hi), scale));
+	}
+#endif
+	return i;
+}
+
+static size_t _affine_float32_baseline(const float *src, float *dst, size_t count, float scale, float bias) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	const __m128 v_scale = _mm_set1_ps(scale);
+	const __m128 v_bias = _mm_set1_ps(bias);
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + i), v_scale), v_bias));
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	const float32x4_t v_bias = vdupq_n_f32(bias);
+	for (; i + 4 <= count; i += 4) {
+		// vmulq + vaddq, not vmlaq/vfmaq, to round like the scalar tail
+		vst1q_f32(dst + i, vaddq_f32(vmulq_n_f32(vld1q_f32(src + i), scale), v_bias));
+	}
+#endif
+	return i;
+}
+
+static size_t _add_float32_baseline(const float *a, const float *b, float *dst, size_t count) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	for (; i + 4 <= count; i += 4) {
+		vst1q_f32(dst + i, vaddq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+	}
+#endif
+	return i;
+}
+
+static size_t _mul_float32_baseline(const float *a, const float *b, float *dst, size_t count) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	for (; i + 4 <= count; i += 4) {
+		vst1q_f32(dst + i, vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+	}
+#endif
+	return i;
+}
+
+static size_t _relu_float32_baseline(const float *src, float *dst, size_t count) {
+	size_t i = 0;
+	// Clear lanes where x < 0 instead of max(x, 0), which would turn NaN into 0
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	const __m128 zero = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4) {
+		__m128 values = _mm_loadu_ps(src + i);
+		_mm_storeu_ps(dst + i, _mm_andnot_ps(_mm_cmplt_ps(values, zero), values));
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	for (; i + 4 <= count; i += 4) {
+		float32x4_t values = vld1q_f32(src + i);
+		vst1q_f32(dst + i, vbslq_f32(vcltq_f32(values, zero), zero, values));
+	}
+#endif
+	return i;
+}
+
+#if defined(EXECUTORCH_KERNELS_SSE2)
+static inline float _sum_sse2(__m128 value) {
+	float lanes[4];
+	_mm_storeu_ps(lanes, value);
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+#endif
+
+static size_t _dot_float32_baseline(const float *a, const float *b, size_t count, float *r_sum) {
+	size_t i = 0;
+	*r_sum = 0.0f;
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	__m128 sum = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4) {
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+	}
+	*r_sum = _sum_sse2(sum);
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	float32x4_t sum = vdupq_n_f32(0.0f);
+	for (; i + 4 <= count; i += 4) {
+		sum = vmlaq_f32(sum, vld1q_f32(a + i), vld1q_f32(b + i));
+	}
+	*r_sum = vaddvq_f32(sum);
+#endif
+	return i;
+}
+
+// Four dot products of x against rows w, w + stride, ... sharing each load of x
+static size_t _dot4_float32_baseline(const float *x, const float *w, size_t stride, size_t count, float *r_sums) {
+	size_t i = 0;
+	for (int k = 0; k < 4; k++) {
+		r_sums[k] = 0.0f;
+	}
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	__m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps(), sum2 = _mm_setzero_ps(), sum3 = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4) {
+		__m128 values = _mm_loadu_ps(x + i);
+		sum0 = _mm_add_ps(sum0, _mm_mul_ps(values, _mm_loadu_ps(w + i)));
+		sum1 = _mm_add_ps(sum1, _mm_mul_ps(values, _mm_loadu_ps(w + stride + i)));
+		sum2 = _mm_add_ps(sum2, _mm_mul_ps(values, _mm_loadu_ps(w + 2 * stride + i)));
+		sum3 = _mm_add_ps(sum3, _mm_mul_ps(values, _mm_loadu_ps(w + 3 * stride + i)));
+	}
+	r_sums[0] = _sum_sse2(sum0);
+	r_sums[1] = _sum_sse2(sum1);
+	r_sums[2] = _sum_sse2(sum2);
+	r_sums[3] = _sum_sse2(sum3);
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	float32x4_t sum0 = vdupq_n_f32(0.0f), sum1 = sum0, sum2 = sum0, sum3 = sum0;
+	for (; i + 4 <= count; i += 4) {
+		float32x4_t values = vld1q_f32(x + i);
+		sum0 = vmlaq_f32(sum0, values, vld1q_f32(w + i));
+		sum1 = vmlaq_f32(sum1, values, vld1q_f32(w + stride + i));
+		sum2 = vmlaq_f32(sum2, values, vld1q_f32(w + 2 * stride + i));
+		sum3 = vmlaq_f32(sum3, values, vld1q_f32(w + 3 * stride + i));
+	}
+	r_sums[0] = vaddvq_f32(sum0);
+	r_sums[1] = vaddvq_f32(sum1);
+	r_sums[2] = vaddvq_f32(sum2);
+	r_sums[3] = vaddvq_f32(sum3);
+#endif
+	return i;
+}
+
+// GEMM tile: tile[r][j] += sum_i x[r][i] * panel[i][j] for up to four rows of x,
+// accumulating in feature order. Returns the rows handled.
+static size_t _gemm_tile_float32_baseline(const float *x, size_t stride, size_t rows, const float *panel, size_t depth, float *tile) {
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	for (size_t r = 0; r < rows; r++) {
+		const float *row = x + r * stride;
+		float *acc = tile + r * ExecuTorchKernels::GEMM_PANEL;
+		__m128 acc0 = _mm_loadu_ps(acc), acc1 = _mm_loadu_ps(acc + 4), acc2 = _mm_loadu_ps(acc + 8), acc3 = _mm_loadu_ps(acc + 12);
+		for (size_t i = 0; i < depth; i++) {
+			const float *w = panel + i * ExecuTorchKernels::GEMM_PANEL;
+			__m128 value = _mm_set1_ps(row[i]);
+			acc0 = _mm_add_ps(acc0, _mm_mul_ps(value, _mm_loadu_ps(w)));
+			acc1 = _mm_add_ps(acc1, _mm_mul_ps(value, _mm_loadu_ps(w + 4)));
+			acc2 = _mm_add_ps(acc2, _mm_mul_ps(value, _mm_loadu_ps(w + 8)));
+			acc3 = _mm_add_ps(acc3, _mm_mul_ps(value, _mm_loadu_ps(w + 12)));
+		}
+		_mm_storeu_ps(acc, acc0);
+		_mm_storeu_ps(acc + 4, acc1);
+		_mm_storeu_ps(acc + 8, acc2);
+		_mm_storeu_ps(acc + 12, acc3);
+	}
+	return rows;
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	for (size_t r = 0; r < rows; r++) {
+		const float *row = x + r * stride;
+		float *acc = tile + r * ExecuTorchKernels::GEMM_PANEL;
+		float32x4_t acc0 = vld1q_f32(acc), acc1 = vld1q_f32(acc + 4), acc2 = vld1q_f32(acc + 8), acc3 = vld1q_f32(acc + 12);
+		for (size_t i = 0; i < depth; i++) {
+			const float *w = panel + i * ExecuTorchKernels::GEMM_PANEL;
+			float32x4_t value = vdupq_n_f32(row[i]);
+			acc0 = vmlaq_f32(acc0, value, vld1q_f32(w));
+			acc1 = vmlaq_f32(acc1, value, vld1q_f32(w + 4));
+			acc2 = vmlaq_f32(acc2, value, vld1q_f32(w + 8));
+			acc3 = vmlaq_f32(acc3, value, vld1q_f32(w + 12));
+		}
+		vst1q_f32(acc, acc0);
+		vst1q_f32(acc + 4, acc1);
+		vst1q_f32(acc + 8, acc2);
+		vst1q_f32(acc + 12, acc3);
+	}
+	return rows;
+#else
+	return 0;
+#endif
+}
+
+// dst[j] += a * src[j] in double
+static size_t _axpy_float32_float64_baseline(double a, const float *src, double *dst, size_t count) {
+	size_t i = 0;
+#if defined(EXECUTORCH_KERNELS_SSE2)
+	const __m128d scale = _mm_set1_pd(a);
+	for (; i + 4 <= count; i += 4) {
+		__m128 values = _mm_loadu_ps(src + i);
+		__m128d lo = _mm_cvtps_pd(values);
+		__m128d hi = _mm_cvtps_pd(_mm_movehl_ps(values, values));
+		_mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(dst + i), _mm_mul_pd(scale, lo)));
+		_mm_storeu_pd(dst + i + 2, _mm_add_pd(_mm_loadu_pd(dst + i + 2), _mm_mul_pd(scale, hi)));
+	}
+#elif defined(EXECUTORCH_KERNELS_NEON)
+	const float64x2_t scale = vdupq_n_f64(a);
+	for (; i + 4 <= count; i += 4) {
+		float32x4_t values = vld1q_f32(src + i);
+		vst1q_f64(dst + i, vaddq_f64(vld1q_f64(dst + i), vmulq_f64(scale, vcvt_f64_f32(vget_low_f32(values)))));
+		vst1q_f64(dst + i + 2, vaddq_f64(vld1q_f64(dst + i + 2), vmulq_f64(scale, vcvt_high_f64_f32(values))));
+	}
+#endif
+	return i;
+}
+
+#ifdef EXECUTORCH_KERNELS_X86_DISPATCH
+// AVX2 (with F16C) loops. No FMA in the target, so nothing gets contracted and
+// results stay bit-identical to the baseline.
+
+EXECUTORCH_TARGET_AVX2 static size_t _float32_to_float16_avx2(const float *src, uint16_t *dst, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m128i lo = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+		__m128i hi = _mm256_cvtps_ph(_mm256_loadu_ps(src + i + 8), _MM_FROUND_TO_NEAREST_INT);
+		_mm256_storeu_si256((__m256i *)(dst + i), _mm256_set_m128i(hi, lo));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2 static size_t _float16_to_float32_avx2(const uint16_t *src, float *dst, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(src + i))));
+		_mm256_storeu_ps(dst + i + 8, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(src + i + 8))));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2 static inline __m256i _float32_to_bfloat16_avx2_lanes(__m256 value) {
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i rounding_bias = _mm256_set1_epi32(0x7FFF);
+	const __m256i quiet_bit = _mm256_set1_epi32(0x40);
+
+	__m256i bits = _mm256_castps_si256(value);
+	__m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+	__m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(rounding_bias, lsb)), 16);
+	__m256i nan = _mm256_or_si256(_mm256_srli_epi32(bits, 16), quiet_bit);
+	__m256i is_nan = _mm256_castps_si256(_mm256_cmp_ps(value, value, _CMP_UNORD_Q));
+	return _mm256_blendv_epi8(rounded, nan, is_nan);
+}
+
+EXECUTORCH_TARGET_AVX2 static size_t _float32_to_bfloat16_avx2(const float *src, uint16_t *dst, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m256i lo = _float32_to_bfloat16_avx2_lanes(_mm256_loadu_ps(src + i));
+		__m256i hi = _float32_to_bfloat16_avx2_lanes(_mm256_loadu_ps(src + i + 8));
+		// Packing works per 128-bit lane; put the quadwords back in order
+		__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+		_mm256_storeu_si256((__m256i *)(dst + i), packed);
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2 static size_t _bfloat16_to_float32_avx2(const uint16_t *src, float *dst, size_t count) {
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i words = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+		_mm256_storeu_ps(dst + i, _mm256_castsi256_ps(_mm256_slli_epi32(words, 16)));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2 static inline __m256i _quantize_avx2_lanes(const float *src, __m256 inv_scale, __m256 lo, __m256 hi, __m256i zero_point) {
+	__m256 v = _mm256_mul_ps(_mm256_loadu_ps(src), inv_scale);
+	v = _mm256_min_ps(_mm256_max_ps(v, lo), hi);
+	return _mm256_add_epi32(_mm256_cvtps_epi32(v), zero_point);
+}
+
+EXECUTORCH_TARGET_AVX2 static size_t _quantize_int8_avx2(const float *src, int8_t *dst, size_t count, float inv_scale, float lo, float hi, int32_t zero_point) {
+	const __m256 v_inv_scale = _mm256_set1_ps(inv_scale);
+	const __m256 v_lo = _mm256_set1_ps(lo);
+	const __m256 v_hi = _mm256_set1_ps(hi);
+	const __m256i v_zero_point = _mm256_set1_epi32(zero_point);
+	const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+	size_t i = 0;
+	for (; i + 32 <= count; i += 32) {
+		__m256i q0 = _quantize_avx2_lanes(src + i, v_inv_scale, v_lo, v_hi, v_zero_point);
+		__m256i q1 = _quantize_avx2_lanes(src + i + 8, v_inv_scale, v_lo, v_hi, v_zero_point);
+		__m256i q2 = _quantize_avx2_lanes(src + i + 16, v_inv_scale, v_lo, v_hi, v_zero_point);
+		__m256i q3 = _quantize_avx2_lanes(src + i + 24, v_inv_scale, v_lo, v_hi, v_zero_point);
+		__m256i packed = _mm256_packs_epi16(_mm256_packs_epi32(q0, q1), _mm256_packs_epi32(q2, q3));
+		_mm256_storeu_si256((__m256i *)(dst + i), _mm256_permutevar8x32_epi32(packed, order));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2 static size_t _dequantize_int8_avx2(const int8_t *src, float *dst, size_t count, float scale, int32_t zero_point) {
+	const __m256 v_scale = _mm256_set1_ps(scale);
+	const __m256i v_zero_point = _mm256_set1_epi32(zero_point);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i values = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(src + i)));
+		_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(values, v_zero_point)), v_scale));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2 static size_t _quantize_uint8_avx2(const float *src, uint8_t *dst, size_t count, float inv_scale, float lo, float hi, int32_t zero_point) {
+	const __m256 v_inv_scale = _mm256_set1_ps(inv_scale);
+	const __m256 v_lo = _mm256_set1_ps(lo);
+	const __m256 v_hi = _mm256_set1_ps(hi);
+	const __m256i v_zero_point = _mm256_set1_epi32(zero_point);
+	const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+	size_t i = 0;
+	for (; i + 32 <= count; i += 32) {
+		__m256i q0 = _quantize_avx2_lanes(src + i, v_inv_scale, v_lo, v_hi, v_zero_point);
+		__m256i q1 = _quantize_avx2_lanes(src + i + 8, v_inv_scale, v_lo, v_hi, v_zero_point);
+		__m256i q2 = _quantize_avx2_lanes(src + i + 16, v_inv_scale, v_lo, v_hi, v_zero_point);
+		__m256i q3 = _quantize_avx2_lanes(src + i + 24, v_inv_scale, v_lo, v_hi, v_zero_point);
+		__m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(q0, q1), _mm256_packs_epi32(q2, q3));
+		_mm256_storeu_si256((__m256i *)(dst + i), _mm256_permutevar8x32_epi32(packed, order));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2 static size_t _dequantize_uint8_avx2(const uint8_t *src, float *dst, size_t count, float scale, int32_t zero_point) {
+	const __m256 v_scale = _mm256_set1_ps(scale);
+	const __m256i v_zero_point = _mm256_set1_epi32(zero_point);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i values = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + i)));
+		_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(values, v_zero_point)), v_scale));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2 static size_t _affine_float32_avx2(const float *src, float *dst, size_t count, float scale, float bias) {
+	const __m256 v_scale = _mm256_set1_ps(scale);
+	const __m256 v_bias = _mm256_set1_ps(bias);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), v_scale), v_bias));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2 static size_t _add_float32_avx2(const float *a, const float *b, float *dst, size_t count) {
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2 static size_t _mul_float32_avx2(const float *a, const float *b, float *dst, size_t count) {
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2 static size_t _relu_float32_avx2(const float *src, float *dst, size_t count) {
+	const __m256 zero = _mm256_setzero_ps();
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 values = _mm256_loadu_ps(src + i);
+		_mm256_storeu_ps(dst + i, _mm256_andnot_ps(_mm256_cmp_ps(values, zero, _CMP_LT_OQ), values));
+	}
+	return i;
+}
+
+// Dot products only promise agreement to rounding, so these may fuse
+
+EXECUTORCH_TARGET_AVX2_FMA static inline float _sum_avx2(__m256 value) {
+	__m128 sum = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+	sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+	sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+	return _mm_cvtss_f32(sum);
+}
+
+EXECUTORCH_TARGET_AVX2_FMA static size_t _dot_float32_avx2(const float *a, const float *b, size_t count, float *r_sum) {
+	__m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps();
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+		sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), sum1);
+	}
+	for (; i + 8 <= count; i += 8) {
+		sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+	}
+	*r_sum = _sum_avx2(_mm256_add_ps(sum0, sum1));
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX2_FMA static size_t _dot4_float32_avx2(const float *x, const float *w, size_t stride, size_t count, float *r_sums) {
+	__m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps(), sum2 = _mm256_setzero_ps(), sum3 = _mm256_setzero_ps();
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 values = _mm256_loadu_ps(x + i);
+		sum0 = _mm256_fmadd_ps(values, _mm256_loadu_ps(w + i), sum0);
+		sum1 = _mm256_fmadd_ps(values, _mm256_loadu_ps(w + stride + i), sum1);
+		sum2 = _mm256_fmadd_ps(values, _mm256_loadu_ps(w + 2 * stride + i), sum2);
+		sum3 = _mm256_fmadd_ps(values, _mm256_loadu_ps(w + 3 * stride + i), sum3);
+	}
+	r_sums[0] = _sum_avx2(sum0);
+	r_sums[1] = _sum_avx2(sum1);
+	r_sums[2] = _sum_avx2(sum2);
+	r_sums[3] = _sum_avx2(sum3);
+	return i;
+}
+
+// Rows past the tile read the last row again; their sums land in unused tile rows
+EXECUTORCH_TARGET_AVX2_FMA static size_t _gemm_tile_float32_avx2(const float *x, size_t stride, size_t rows, const float *panel, size_t depth, float *tile) {
+	const float *x0 = x;
+	const float *x1 = rows > 1 ? x + stride : x0;
+	const float *x2 = rows > 2 ? x + 2 * stride : x1;
+	const float *x3 = rows > 3 ? x + 3 * stride : x2;
+	__m256 acc00 = _mm256_loadu_ps(tile), acc01 = _mm256_loadu_ps(tile + 8);
+	__m256 acc10 = _mm256_loadu_ps(tile + 16), acc11 = _mm256_loadu_ps(tile + 24);
+	__m256 acc20 = _mm256_loadu_ps(tile + 32), acc21 = _mm256_loadu_ps(tile + 40);
+	__m256 acc30 = _mm256_loadu_ps(tile + 48), acc31 = _mm256_loadu_ps(tile + 56);
+	for (size_t i = 0; i < depth; i++) {
+		const float *w = panel + i * ExecuTorchKernels::GEMM_PANEL;
+		__m256 w0 = _mm256_loadu_ps(w), w1 = _mm256_loadu_ps(w + 8);
+		__m256 value = _mm256_broadcast_ss(x0 + i);
+		acc00 = _mm256_fmadd_ps(value, w0, acc00);
+		acc01 = _mm256_fmadd_ps(value, w1, acc01);
+		value = _mm256_broadcast_ss(x1 + i);
+		acc10 = _mm256_fmadd_ps(value, w0, acc10);
+		acc11 = _mm256_fmadd_ps(value, w1, acc11);
+		value = _mm256_broadcast_ss(x2 + i);
+		acc20 = _mm256_fmadd_ps(value, w0, acc20);
+		acc21 = _mm256_fmadd_ps(value, w1, acc21);
+		value = _mm256_broadcast_ss(x3 + i);
+		acc30 = _mm256_fmadd_ps(value, w0, acc30);
+		acc31 = _mm256_fmadd_ps(value, w1, acc31);
+	}
+	_mm256_storeu_ps(tile, acc00);
+	_mm256_storeu_ps(tile + 8, acc01);
+	_mm256_storeu_ps(tile + 16, acc10);
+	_mm256_storeu_ps(tile + 24, acc11);
+	_mm256_storeu_ps(tile + 32, acc20);
+	_mm256_storeu_ps(tile + 40, acc21);
+	_mm256_storeu_ps(tile + 48, acc30);
+	_mm256_storeu_ps(tile + 56, acc31);
+	return rows;
+}
+
+EXECUTORCH_TARGET_AVX2_FMA static size_t _axpy_float32_float64_avx2(double a, const float *src, double *dst, size_t count) {
+	const __m256d scale = _mm256_set1_pd(a);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256d lo = _mm256_cvtps_pd(_mm_loadu_ps(src + i));
+		__m256d hi = _mm256_cvtps_pd(_mm_loadu_ps(src + i + 4));
+		_mm256_storeu_pd(dst + i, _mm256_fmadd_pd(scale, lo, _mm256_loadu_pd(dst + i)));
+		_mm256_storeu_pd(dst + i + 4, _mm256_fmadd_pd(scale, hi, _mm256_loadu_pd(dst + i + 4)));
+	}
+	for (; i + 4 <= count; i += 4) {
+		_mm256_storeu_pd(dst + i, _mm256_fmadd_pd(scale, _mm256_cvtps_pd(_mm_loadu_ps(src + i)), _mm256_loadu_pd(dst + i)));
+	}
+	return i;
+}
+
+// AVX-512 loops. The target implies FMA, so the affine kernel stays on AVX2
+// where a multiply and an add cannot be fused behind our back.
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC 12's AVX-512 intrinsics trip these on their own _mm256_undefined_*() placeholders
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+EXECUTORCH_TARGET_AVX512 static size_t _float32_to_float16_avx512(const float *src, uint16_t *dst, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		_mm256_storeu_si256((__m256i *)(dst + i), _mm512_cvtps_ph(_mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX512 static size_t _float16_to_float32_avx512(const uint16_t *src, float *dst, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		_mm512_storeu_ps(dst + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(src + i))));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX512 static size_t _float32_to_bfloat16_avx512(const float *src, uint16_t *dst, size_t count) {
+	const __m512i one = _mm512_set1_epi32(1);
+	const __m512i rounding_bias = _mm512_set1_epi32(0x7FFF);
+	const __m512i quiet_bit = _mm512_set1_epi32(0x40);
+
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m512 value = _mm512_loadu_ps(src + i);
+		__m512i bits = _mm512_castps_si512(value);
+		__m512i lsb = _mm512_and_si512(_mm512_srli_epi32(bits, 16), one);
+		__m512i rounded = _mm512_srli_epi32(_mm512_add_epi32(bits, _mm512_add_epi32(rounding_bias, lsb)), 16);
+		__m512i nan = _mm512_or_si512(_mm512_srli_epi32(bits, 16), quiet_bit);
+		__mmask16 is_nan = _mm512_cmp_ps_mask(value, value, _CMP_UNORD_Q);
+		_mm256_storeu_si256((__m256i *)(dst + i), _mm512_cvtepi32_epi16(_mm512_mask_blend_epi32(is_nan, rounded, nan)));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX512 static size_t _bfloat16_to_float32_avx512(const uint16_t *src, float *dst, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m512i words = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(src + i)));
+		_mm512_storeu_ps(dst + i, _mm512_castsi512_ps(_mm512_slli_epi32(words, 16)));
+	}
+	return i;
+}
+
+// Clamped and zero-point shifted values already fit the target type, so plain truncation packs them
+EXECUTORCH_TARGET_AVX512 static size_t _quantize_int8_avx512(const float *src, int8_t *dst, size_t count, float inv_scale, float lo, float hi, int32_t zero_point) {
+	const __m512 v_inv_scale = _mm512_set1_ps(inv_scale);
+	const __m512 v_lo = _mm512_set1_ps(lo);
+	const __m512 v_hi = _mm512_set1_ps(hi);
+	const __m512i v_zero_point = _mm512_set1_epi32(zero_point);
+
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m512 v = _mm512_mul_ps(_mm512_loadu_ps(src + i), v_inv_scale);
+		v = _mm512_min_ps(_mm512_max_ps(v, v_lo), v_hi);
+		__m512i q = _mm512_add_epi32(_mm512_cvtps_epi32(v), v_zero_point);
+		_mm_storeu_si128((__m128i *)(dst + i), _mm512_cvtepi32_epi8(q));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX512 static size_t _dequantize_int8_avx512(const int8_t *src, float *dst, size_t count, float scale, int32_t zero_point) {
+	const __m512 v_scale = _mm512_set1_ps(scale);
+	const __m512i v_zero_point = _mm512_set1_epi32(zero_point);
+
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m512i values = _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+		_mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_sub_epi32(values, v_zero_point)), v_scale));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX512 static size_t _quantize_uint8_avx512(const float *src, uint8_t *dst, size_t count, float inv_scale, float lo, float hi, int32_t zero_point) {
+	const __m512 v_inv_scale = _mm512_set1_ps(inv_scale);
+	const __m512 v_lo = _mm512_set1_ps(lo);
+	const __m512 v_hi = _mm512_set1_ps(hi);
+	const __m512i v_zero_point = _mm512_set1_epi32(zero_point);
+
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m512 v = _mm512_mul_ps(_mm512_loadu_ps(src + i), v_inv_scale);
+		v = _mm512_min_ps(_mm512_max_ps(v, v_lo), v_hi);
+		__m512i q = _mm512_add_epi32(_mm512_cvtps_epi32(v), v_zero_point);
+		_mm_storeu_si128((__m128i *)(dst + i), _mm512_cvtepi32_epi8(q));
+	}
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX512 static size_t _dequantize_uint8_avx512(const uint8_t *src, float *dst, size_t count, float scale, int32_t zero_point) {
+	const __m512 v_scale = _mm512_set1_ps(scale);
+	const __m512i v_zero_point = _mm512_set1_epi32(zero_point);
+
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m512i values = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+		_mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_sub_epi32(values, v_zero_point)), v_scale));
+	}
+	return i;
+}
+EXECUTORCH_TARGET_AVX512 static size_t _dot_float32_avx512(const float *a, const float *b, size_t count, float *r_sum) {
+	__m512 sum0 = _mm512_setzero_ps(), sum1 = _mm512_setzero_ps();
+	size_t i = 0;
+	for (; i + 32 <= count; i += 32) {
+		sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), sum0);
+		sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), sum1);
+	}
+	for (; i + 16 <= count; i += 16) {
+		sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), sum0);
+	}
+	*r_sum = _mm512_reduce_add_ps(_mm512_add_ps(sum0, sum1));
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX512 static size_t _dot4_float32_avx512(const float *x, const float *w, size_t stride, size_t count, float *r_sums) {
+	__m512 sum0 = _mm512_setzero_ps(), sum1 = _mm512_setzero_ps(), sum2 = _mm512_setzero_ps(), sum3 = _mm512_setzero_ps();
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m512 values = _mm512_loadu_ps(x + i);
+		sum0 = _mm512_fmadd_ps(values, _mm512_loadu_ps(w + i), sum0);
+		sum1 = _mm512_fmadd_ps(values, _mm512_loadu_ps(w + stride + i), sum1);
+		sum2 = _mm512_fmadd_ps(values, _mm512_loadu_ps(w + 2 * stride + i), sum2);
+		sum3 = _mm512_fmadd_ps(values, _mm512_loadu_ps(w + 3 * stride + i), sum3);
+	}
+	r_sums[0] = _mm512_reduce_add_ps(sum0);
+	r_sums[1] = _mm512_reduce_add_ps(sum1);
+	r_sums[2] = _mm512_reduce_add_ps(sum2);
+	r_sums[3] = _mm512_reduce_add_ps(sum3);
+	return i;
+}
+
+EXECUTORCH_TARGET_AVX512 static size_t _gemm_tile_float32_avx512(const float *x, size_t stride, size_t rows, const float *panel, size_t depth, float *tile) {
+	const float *x0 = x;
+	const float *x1 = rows > 1 ? x + stride : x0;
+	const float *x2 = rows > 2 ? x + 2 * stride : x1;
+	const float *x3 = rows > 3 ? x + 3 * stride : x2;
+	__m512 acc0 = _mm512_loadu_ps(tile), acc1 = _mm512_loadu_ps(tile + 16);
+	__m512 acc2 = _mm512_loadu_ps(tile + 32), acc3 = _mm512_loadu_ps(tile + 48);
+	for (size_t i = 0; i < depth; i++) {
+		__m512 w = _mm512_loadu_ps(panel + i * ExecuTorchKernels::GEMM_PANEL);
+		acc0 = _mm512_fmadd_ps(_mm512_set1_ps(x0[i]), w, acc0);
+		acc1 = _mm512_fmadd_ps(_mm512_set1_ps(x1[i]), w, acc1);
+		acc2 = _mm512_fmadd_ps(_mm512_set1_ps(x2[i]), w, acc2);
+		acc3 = _mm512_fmadd_ps(_mm512_set1_ps(x3[i]), w, acc3);
+	}
+	_mm512_storeu_ps(tile, acc0);
+	_mm512_storeu_ps(tile + 16, acc1);
+	_mm512_storeu_ps(tile + 32, acc2);
+	_mm512_storeu_ps(tile + 48, acc3);
+	return rows;
+}
+
+EXECUTORCH_TARGET_AVX512 static size_t _axpy_float32_float64_avx512(double a, const float *src, double *dst, size_t count) {
+	const __m512d scale = _mm512_set1_pd(a);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm512_storeu_pd(dst + i, _mm512_fmadd_pd(scale, _mm512_cvtps_pd(_mm256_loadu_ps(src + i)), _mm512_loadu_pd(dst + i)));
+	}
+	return i;
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif // EXECUTORCH_KERNELS_X86_DISPATCH
+
+// Dispatch
+
+struct ExecuTorchKernelTable {
+	size_t (*float32_to_float16)(const float *, uint16_t *, size_t);
+	size_t (*float16_to_float32)(const uint16_t *, float *, size_t);
+	size_t (*float32_to_bfloat16)(const float *, uint16_t *, size_t);
+	size_t (*bfloat16_to_float32)(const uint16_t *, float *, size_t);
+	size_t (*quantize_int8)(const float *, int8_t *, size_t, float, float, float, int32_t);
+	size_t (*dequantize_int8)(const int8_t *, float *, size_t, float, int32_t);
+	size_t (*quantize_uint8)(const float *, uint8_t *, size_t, float, float, float, int32_t);
+	size_t (*dequantize_uint8)(const uint8_t *, float *, size_t, float, int32_t);
+	size_t (*affine_float32)(const float *, float *, size_t, float, float);
+	size_t (*add_float32)(const float *, const float *, float *, size_t);
+	size_t (*mul_float32)(const float *, const float *, float *, size_t);
+	size_t (*relu_float32)(const float *, float *, size_t);
+	size_t (*dot_float32)(const float *, const float *, size_t, float *);
+	size_t (*dot4_float32)(const float *, const float *, size_t, size_t, float *);
+	size_t (*gemm_tile_float32)(const float *, size_t, size_t, const float *, size_t, float *);
+	size_t (*axpy_float32_float64)(double, const float *, double *, size_t);
+};
+
+static size_t _none_f32_u16(const float *, uint16_t *, size_t) { return 0; }
+static size_t _none_u16_f32(const uint16_t *, float *, size_t) { return 0; }
+static size_t _none_quantize_int8(const float *, int8_t *, size_t, float, float, float, int32_t) { return 0; }
+static size_t _none_dequantize_int8(const int8_t *, float *, size_t, float, int32_t) { return 0; }
+static size_t _none_quantize_uint8(const float *, uint8_t *, size_t, float, float, float, int32_t) { return 0; }
+static size_t _none_dequantize_uint8(const uint8_t *, float *, size_t, float, int32_t) { return 0; }
+static size_t _none_affine_float32(const float *, float *, size_t, float, float) { return 0; }
+static size_t _none_binary_float32(const float *, const float *, float *, size_t) { return 0; }
+static size_t _none_relu_float32(const float *, float *, size_t) { return 0; }
+static size_t _none_dot_float32(const float *, const float *, size_t, float *r_sum) {
+	*r_sum = 0.0f;
+	return 0;
+}
+static size_t _none_dot4_float32(const float *, const float *, size_t, size_t, float *r_sums) {
+	for (int k = 0; k < 4; k++) {
+		r_sums[k] = 0.0f;
+	}
+	return 0;
+}
+static size_t _none_gemm_tile_float32(const float *, size_t, size_t, const float *, size_t, float *) { return 0; }
+static size_t _none_axpy_float32_float64(double, const float *, double *, size_t) { return 0; }
+
+static const ExecuTorchKernelTable _scalar_table = {
+	_none_f32_u16,
+	_none_u16_f32,
+	_none_f32_u16,
+	_none_u16_f32,
+	_none_quantize_int8,
+	_none_dequantize_int8,
+	_none_quantize_uint8,
+	_none_dequantize_uint8,
+	_none_affine_float32,
+	_none_binary_float32,
+	_none_binary_float32,
+	_none_relu_float32,
+	_none_dot_float32,
+	_none_dot4_float32,
+	_none_gemm_tile_float32,
+	_none_axpy_float32_float64,
+};
+
+static const ExecuTorchKernelTable _baseline_table = {
+	_float32_to_float16_baseline,
+	_float16_to_float32_baseline,
+	_float32_to_bfloat16_baseline,
+	_bfloat16_to_float32_baseline,
+	_quantize_int8_baseline,
+	_dequantize_int8_baseline,
+	_quantize_uint8_baseline,
+	_dequantize_uint8_baseline,
+	_affine_float32_baseline,
+	_add_float32_baseline,
+	_mul_float32_baseline,
+	_relu_float32_baseline,
+	_dot_float32_baseline,
+	_dot4_float32_baseline,
+	_gemm_tile_float32_baseline,
+	_axpy_float32_float64_baseline,
+};
+
+#ifdef EXECUTORCH_KERNELS_X86_DISPATCH
+static const ExecuTorchKernelTable _avx2_table = {
+	_float32_to_float16_avx2,
+	_float16_to_float32_avx2,
+	_float32_to_bfloat16_avx2,
+	_bfloat16_to_float32_avx2,
+	_quantize_int8_avx2,
+	_dequantize_int8_avx2,
+	_quantize_uint8_avx2,
+	_dequantize_uint8_avx2,
+	_affine_float32_avx2,
+	_add_float32_avx2,
+	_mul_float32_avx2,
+	_relu_float32_avx2,
+	_dot_float32_avx2,
+	_dot4_float32_avx2,
+	_gemm_tile_float32_avx2,
+	_axpy_float32_float64_avx2,
+};
+
+static const ExecuTorchKernelTable _avx512_table = {
+	_float32_to_float16_avx512,
+	_float16_to_float32_avx512,
+	_float32_to_bfloat16_avx512,
+	_bfloat16_to_float32_avx512,
+	_quantize_int8_avx512,
+	_dequantize_int8_avx512,
+	_quantize_uint8_avx512,
+	_dequantize_uint8_avx512,
+	_affine_float32_avx2,
+	// Elementwise ops are bound by memory bandwidth; AVX2 already keeps up
+	_add_float32_avx2,
+	_mul_float32_avx2,
+	_relu_float32_avx2,
+	_dot_float32_avx512,
+	_dot4_float32_avx512,
+	_gemm_tile_float32_avx512,
+	_axpy_float32_float64_avx512,
+};
+
+static void _read_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t r_regs[4]) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	int regs[4];
+	__cpuidex(regs, (int)leaf, (int)subleaf);
+	for (int i = 0; i < 4; i++) {
+		r_regs[i] = (uint32_t)regs[i];
+	}
+#else
+	__cpuid_count(leaf, subleaf, r_regs[0], r_regs[1], r_regs[2], r_regs[3]);
+#endif
+}
+
+static uint64_t _read_xcr0() {
+#if defined(_MSC_VER) && !defined(__clang__)
+	return _xgetbv(0);
+#else
+	uint32_t eax, edx;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return ((uint64_t)edx << 32) | eax;
+#endif
+}
+#endif // EXECUTORCH_KERNELS_X86_DISPATCH
+
+static ExecuTorchKernels::Level _detect_level() {
+#if defined(EXECUTORCH_KERNELS_X86_DISPATCH)
+	uint32_t regs[4];
+	_read_cpuid(0, 0, regs);
+	uint32_t max_leaf = regs[0];
+	_read_cpuid(1, 0, regs);
+	bool osxsave = regs[2] & (1u << 27);
+	bool fma = regs[2] & (1u << 12);
+	bool f16c = regs[2] & (1u << 29);
+	if (max_leaf < 7 || !osxsave) {
+		return ExecuTorchKernels::LEVEL_SSE2;
+	}
+
+	// The OS has to save the wider registers on context switches, not just the CPU have them
+	uint64_t xcr0 = _read_xcr0();
+	bool ymm_state = (xcr0 & 0x6) == 0x6;
+	bool zmm_state = (xcr0 & 0xE6) == 0xE6;
+	_read_cpuid(7, 0, regs);
+	bool avx2 = regs[1] & (1u << 5);
+	bool avx512f = regs[1] & (1u << 16);
+	bool avx512bw = regs[1] & (1u << 30);
+
+	if (ymm_state && zmm_state && avx2 && fma && f16c && avx512f && avx512bw) {
+		return ExecuTorchKernels::LEVEL_AVX512;
+	}
+	if (ymm_state && avx2 && fma && f16c) {
+		return ExecuTorchKernels::LEVEL_AVX2;
+	}
+	return ExecuTorchKernels::LEVEL_SSE2;
+#elif defined(EXECUTORCH_KERNELS_SSE2)
+	return ExecuTorchKernels::LEVEL_SSE2;
+#elif defined(EXECUTORCH_KERNELS_NEON)
+#if defined(__linux__) && defined(HWCAP_ASIMD)
+	if (!(getauxval(AT_HWCAP) & HWCAP_ASIMD)) {
+		return ExecuTorchKernels::LEVEL_SCALAR;
+	}
+#endif
+	return ExecuTorchKernels::LEVEL_NEON;
+#else
+	return ExecuTorchKernels::LEVEL_SCALAR;
+#endif
+}
+
+static const ExecuTorchKernelTable *_get_table(ExecuTorchKernels::Level level) {
+	switch (level) {
+		case ExecuTorchKernels::LEVEL_SCALAR:
+			return &_scalar_table;
+#ifdef EXECUTORCH_KERNELS_X86_DISPATCH
+		case ExecuTorchKernels::LEVEL_AVX2:
+			return &_avx2_table;
+		case ExecuTorchKernels::LEVEL_AVX512:
+			return &_avx512_table;
+#endif
+		default:
+			return &_baseline_table;
+	}
+}
+
+static std::atomic<int> _active_level(-1);
+static std::atomic<const ExecuTorchKernelTable *> _active_table(nullptr);
+
+static const ExecuTorchKernelTable *_table() {
+	const ExecuTorchKernelTable *table = _active_table.load(std::memory_order_acquire);
+	if (!table) {
+		// Racing first calls all detect the same level; storing it twice is harmless
+		ExecuTorchKernels::Level level = ExecuTorchKernels::get_supported_level();
+		table = _get_table(level);
+		_active_level.store(level);
+		_active_table.store(table, std::memory_order_release);
+	}
+	return table;
+}
+
+ExecuTorchKernels::Level ExecuTorchKernels::get_supported_level() {
+	static const Level supported = _detect_level();
+	return supported;
+}
+
+ExecuTorchKernels::Level ExecuTorchKernels::get_level() {
+	_table();
+	return (Level)_active_level.load();
+}
+
+bool ExecuTorchKernels::is_level_supported(Level level) {
+	Level supported = get_supported_level();
+	switch (level) {
+		case LEVEL_SCALAR:
+			return true;
+		case LEVEL_SSE2:
+		case LEVEL_AVX2:
+		case LEVEL_AVX512:
+			return supported != LEVEL_NEON && supported != LEVEL_SCALAR && level <= supported;
+		case LEVEL_NEON:
+			return supported == LEVEL_NEON;
+		default:
+			return false;
+	}
+}
+
+ExecuTorchKernels::Level ExecuTorchKernels::set_level(Level level) {
+	Level chosen = level;
+	while (chosen > LEVEL_SCALAR && !is_level_supported(chosen)) {
+		chosen = (Level)(chosen - 1);
+	}
+	_active_level.store(chosen);
+	_active_table.store(_get_table(chosen), std::memory_order_release);
+	return chosen;
+}
+
+const char *ExecuTorchKernels::get_level_name(Level level) {
+	switch (level) {
+		case LEVEL_SCALAR:
+			return "scalar";
+		case LEVEL_SSE2:
+			return "sse2";
+		case LEVEL_AVX2:
+			return "avx2";
+		case LEVEL_AVX512:
+			return "avx512";
+		case LEVEL_NEON:
+			return "neon";
+		default:
+			return "unknown";
+	}
+}
+
+void ExecuTorchKernels::float32_to_float16(const float *src, uint16_t *dst, size_t count) {
+	for (size_t i = _table()->float32_to_float16(src, dst, count); i < count; i++) {
+		dst[i] = float32_to_float16_scalar(src[i]);
+	}
+}
+
+void ExecuTorchKernels::float16_to_float32(const uint16_t *src, float *dst, size_t count) {
+	for (size_t i = _table()->float16_to_float32(src, dst, count); i < count; i++) {
+		dst[i] = float16_to_float32_scalar(src[i]);
+	}
+}
+
+void ExecuTorchKernels::float32_to_bfloat16(const float *src, uint16_t *dst, size_t count) {
+	for (size_t i = _table()->float32_to_bfloat16(src, dst, count); i < count; i++) {
+		dst[i] = float32_to_bfloat16_scalar(src[i]);
+	}
+}
+
+void ExecuTorchKernels::bfloat16_to_float32(const uint16_t *src, float *dst, size_t count) {
+	for (size_t i = _table()->bfloat16_to_float32(src, dst, count); i < count; i++) {
+		dst[i] = bfloat16_to_float32_scalar(src[i]);
+	}
+}
+
+void ExecuTorchKernels::quantize_int8(const float *src, int8_t *dst, size_t count, float scale, int32_t zero_point) {
+	const float inv_scale = 1.0f / scale;
+	const float lo = (float)(-128 - zero_point);
+	const float hi = (float)(127 - zero_point);
+
+	for (size_t i = _table()->quantize_int8(src, dst, count, inv_scale, lo, hi, zero_point); i < count; i++) {
+		float v = _quantize_clamp(src[i] * inv_scale, lo, hi);
+		dst[i] = (int8_t)((int32_t)std::nearbyint(v) + zero_point);
+	}
+}
+
+void ExecuTorchKernels::dequantize_int8(const int8_t *src, float *dst, size_t count, float scale, int32_t zero_point) {
+	for (size_t i = _table()->dequantize_int8(src, dst, count, scale, zero_point); i < count; i++) {
+		dst[i] = (float)((int32_t)src[i] - zero_point) * scale;
+	}
+}
+
+void ExecuTorchKernels::quantize_uint8(const float *src, uint8_t *dst, size_t count, float scale, int32_t zero_point) {
+	const float inv_scale = 1.0f / scale;
+	const float lo = (float)(0 - zero_point);
+	const float hi = (float)(255 - zero_point);
+
+	for (size_t i = _table()->quantize_uint8(src, dst, count, inv_scale, lo, hi, zero_point); i < count; i++) {
+		float v = _quantize_clamp(src[i] * inv_scale, lo, hi);
+		dst[i] = (uint8_t)((int32_t)std::nearbyint(v) + zero_point);
+	}
+}
+
+void ExecuTorchKernels::dequantize_uint8(const uint8_t *src, float *dst, size_t count, float scale, int32_t zero_point) {
+	for (size_t i = _table()->dequantize_uint8(src, dst, count, scale, zero_point); i < count; i++) {
+		dst[i] = (float)((int32_t)src[i] - zero_point) * scale;
+	}
+}
+
+void ExecuTorchKernels::affine_float32(const float *src, float *dst, size_t count, float scale, float bias) {
+	for (size_t i = _table()->affine_float32(src, dst, count, scale, bias); i < count; i++) {
+		dst[i] = src[i] * scale + bias;
+	}
+}
+
+void ExecuTorchKernels::add_float32(const float *a, const float *b, float *dst, size_t count) {
+	for (size_t i = _table()->add_float32(a, b, dst, count); i < count; i++) {
+		dst[i] = a[i] + b[i];
+	}
+}
+
+void ExecuTorchKernels::mul_float32(const float *a, const float *b, float *dst, size_t count) {
+	for (size_t i = _table()->mul_float32(a, b, dst, count); i < count; i++) {
+		dst[i] = a[i] * b[i];
+	}
+}
+
+void ExecuTorchKernels::relu_float32(const float *src, float *dst, size_t count) {
+	for (size_t i = _table()->relu_float32(src, dst, count); i < count; i++) {
+		dst[i] = src[i] < 0.0f ? 0.0f : src[i];
+	}
+}
+
+float ExecuTorchKernels::dot_float32(const float *a, const float *b, size_t count) {
+	float sum;
+	for (size_t i = _table()->dot_float32(a, b, count, &sum); i < count; i++) {
+		sum += a[i] * b[i];
+	}
+	return sum;
+}
+
+void ExecuTorchKernels::linear_float32(const float *input, const float *weight, const float *bias, float *output, size_t rows, size_t in_features, size_t out_features) {
+	const ExecuTorchKernelTable *table = _table();
+
+	// Panels of four weight rows, each reused for every input row while it is in cache
+	size_t o = 0;
+	for (; o + 4 <= out_features; o += 4) {
+		const float *panel = weight + o * in_features;
+		for (size_t r = 0; r < rows; r++) {
+			const float *x = input + r * in_features;
+			float sums[4];
+			for (size_t i = table->dot4_float32(x, panel, in_features, in_features, sums); i < in_features; i++) {
+				for (int k = 0; k < 4; k++) {
+					sums[k] += x[i] * panel[k * in_features + i];
+				}
+			}
+			float *y = output + r * out_features + o;
+			for (int k = 0; k < 4; k++) {
+				y[k] = bias ? sums[k] + bias[o + k] : sums[k];
+			}
+		}
+	}
+	for (; o < out_features; o++) {
+		const float *row = weight + o * in_features;
+		for (size_t r = 0; r < rows; r++) {
+			float sum = dot_float32(input + r * in_features, row, in_features);
+			output[r * out_features + o] = bias ? sum + bias[o] : sum;
+		}
+	}
+}
+
+// Rows and features per cache block: a 256-feature panel slice is 16 KiB and
+// stays in L1 while 64 input rows of the same features (64 KiB) sit in L2
+static const size_t GEMM_ROW_BLOCK = 64;
+static const size_t GEMM_DEPTH_BLOCK = 256;
+static const size_t GEMM_TILE_ROWS = 4;
+
+size_t ExecuTorchKernels::get_gemm_packed_size(size_t in_features, size_t out_features) {
+	return (out_features + GEMM_PANEL - 1) / GEMM_PANEL * GEMM_PANEL * in_features;
+}
+
+void ExecuTorchKernels::pack_gemm_weights(const float *weight, float *packed, size_t in_features, size_t out_features) {
+	for (size_t o0 = 0; o0 < out_features; o0 += GEMM_PANEL) {
+		float *panel = packed + o0 * in_features;
+		for (size_t i = 0; i < in_features; i++) {
+			for (size_t j = 0; j < GEMM_PANEL; j++) {
+				panel[i * GEMM_PANEL + j] = o0 + j < out_features ? weight[(o0 + j) * in_features + i] : 0.0f;
+			}
+		}
+	}
+}
+
+void ExecuTorchKernels::gemm_packed_float32(const float *input, const float *packed, const float *bias, float *output, size_t rows, size_t in_features, size_t out_features) {
+	const ExecuTorchKernelTable *table = _table();
+	float tile[GEMM_TILE_ROWS * GEMM_PANEL];
+
+	for (size_t r0 = 0; r0 < rows; r0 += GEMM_ROW_BLOCK) {
+		const size_t r1 = r0 + GEMM_ROW_BLOCK < rows ? r0 + GEMM_ROW_BLOCK : rows;
+		// Later depth blocks continue the sums left in output, so blocking never reorders them
+		for (size_t k0 = 0; k0 == 0 || k0 < in_features; k0 += GEMM_DEPTH_BLOCK) {
+			const size_t depth = in_features - k0 < GEMM_DEPTH_BLOCK ? in_features - k0 : GEMM_DEPTH_BLOCK;
+			for (size_t o0 = 0; o0 < out_features; o0 += GEMM_PANEL) {
+				const size_t width = out_features - o0 < GEMM_PANEL ? out_features - o0 : GEMM_PANEL;
+				const float *panel = packed + o0 * in_features + k0 * GEMM_PANEL;
+
+				for (size_t r = r0; r < r1; r += GEMM_TILE_ROWS) {
+					const size_t tile_rows = r1 - r < GEMM_TILE_ROWS ? r1 - r : GEMM_TILE_ROWS;
+					memset(tile, 0, sizeof(tile));
+					for (size_t t = 0; t < tile_rows; t++) {
+						for (size_t j = 0; j < width; j++) {
+							tile[t * GEMM_PANEL + j] = k0 > 0 ? output[(r + t) * out_features + o0 + j] : (bias ? bias[o0 + j] : 0.0f);
+						}
+					}
+
+					const float *x = input + r * in_features + k0;
+					for (size_t t = table->gemm_tile_float32(x, in_features, tile_rows, panel, depth, tile); t < tile_rows; t++) {
+						for (size_t i = 0; i < depth; i++) {
+							const float value = x[t * in_features + i];
+							for (size_t j = 0; j < GEMM_PANEL; j++) {
+								tile[t * GEMM_PANEL + j] += value * panel[i * GEMM_PANEL + j];
+							}
+						}
+					}
+
+					for (size_t t = 0; t < tile_rows; t++) {
+						memcpy(output + (r + t) * out_features + o0, tile + t * GEMM_PANEL, width * sizeof(float));
+					}
+				}
+			}
+		}
+	}
+}
+
+void ExecuTorchKernels::accumulate_gram_float32(const float *x, size_t rows, size_t features, double *gram) {
+	const ExecuTorchKernelTable *table = _table();
+	for (size_t r = 0; r < rows; r++) {
+		const float *row = x + r * features;
+		for (size_t i = 0; i < features; i++) {
+			const double value = row[i];
+			double *dst = gram + i * features + i;
+			const size_t count = features - i;
+			for (size_t j = table->axpy_float32_float64(value, row + i, dst, count); j < count; j++) {
+				dst[j] += value * (double)row[i + j];
+			}
+		}
+	}
+}
@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  executorch_kernels.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * ExecuTorchKernels - Vectorized numeric kernels used by the module
+ *
+ * Tensor dtype conversions (float32 <-> float16 / bfloat16, affine int8
+ * quantize and dequantize), elementwise ops, the dot products behind
+ * ExecuTorchNativeExecutor's linear layers, and the packed GEMM and
+ * Gram accumulation behind ExecuTorchLinearRegression. Each kernel has main loops for
+ * several instruction set levels and a scalar tail; everything but the
+ * reductions produces bit-identical results for finite inputs.
+ *
+ * The level is picked once from CPUID (x86) or HWCAP (arm64), so one binary
+ * runs AVX2 or AVX-512 loops where the CPU has them and SSE2 or Neon
+ * elsewhere. set_level() can force a lower level, e.g. to test fallbacks.
+ */
+class ExecuTorchKernels {
+public:
+	enum Level {
+		LEVEL_SCALAR,
+		LEVEL_SSE2,
+		LEVEL_AVX2, // With F16C
+		LEVEL_AVX512, // F and BW
+		LEVEL_NEON,
+	};
+
+	// Best level this CPU and build can run
+	static Level get_supported_level();
+	static bool is_level_supported(Level level);
+	static Level get_level();
+	// Unsupported levels step down to the nearest one that runs; returns the level in use
+	static Level set_level(Level level);
+	static const char *get_level_name(Level level);
+
+	// IEEE half precision, round to nearest even
+	static void float32_to_float16(const float *src, uint16_t *dst, size_t count);
+	static void float16_to_float32(const uint16_t *src, float *dst, size_t count);
+
+	// bfloat16 (upper half of a float32), round to nearest even
+	static void float32_to_bfloat16(const float *src, uint16_t *dst, size_t count);
+	static void bfloat16_to_float32(const uint16_t *src, float *dst, size_t count);
+
+	// Affine quantization: q = clamp(round(x / scale) + zero_point)
+	static void quantize_int8(const float *src, int8_t *dst, size_t count, float scale, int32_t zero_point);
+	static void dequantize_int8(const int8_t *src, float *dst, size_t count, float scale, int32_t zero_point);
+	static void quantize_uint8(const float *src, uint8_t *dst, size_t count, float scale, int32_t zero_point);
+	static void dequantize_uint8(const uint8_t *src, float *dst, size_t count, float scale, int32_t zero_point);
+
+	// dst = src * scale + bias, rounded after the multiply and the add (never fused)
+	static void affine_float32(const float *src, float *dst, size_t count, float scale, float bias);
+
+	// Elementwise; exact, so every level produces the same bits
+	static void add_float32(const float *a, const float *b, float *dst, size_t count);
+	static void mul_float32(const float *a, const float *b, float *dst, size_t count);
+	// x < 0 ? 0 : x, which keeps NaN
+	static void relu_float32(const float *src, float *dst, size_t count);
+
+	// Reductions are reassociated (and may fuse) per level, so levels agree to rounding only
+	static float dot_float32(const float *a, const float *b, size_t count);
+	// output[r][o] = dot(input[r], weight[o]) + bias[o], with the weight in torch's
+	// [out_features, in_features] layout; bias may be null
+	static void linear_float32(const float *input, const float *weight, const float *bias, float *output, size_t rows, size_t in_features, size_t out_features);
+
+	// Weights for gemm_packed_float32, repacked once from [out_features, in_features] into
+	// panels of GEMM_PANEL outputs: panel p holds weight[p * GEMM_PANEL + j][i] at
+	// [i * GEMM_PANEL + j], zero padded past out_features. Each panel row is 64 bytes,
+	// so a 64-byte aligned buffer keeps every load aligned.
+	static const size_t GEMM_PANEL = 16;
+	static size_t get_gemm_packed_size(size_t in_features, size_t out_features);
+	static void pack_gemm_weights(const float *weight, float *packed, size_t in_features, size_t out_features);
+	// Same result as linear_float32, blocked over rows and features so a panel slice stays
+	// in L1 while tiles of four input rows stream past it; bias may be null
+	static void gemm_packed_float32(const float *input, const float *packed, const float *bias, float *output, size_t rows, size_t in_features, size_t out_features);
+
+	// gram[i][j] += x[r][i] * x[r][j] over the rows of x, for j >= i only (the upper triangle of a
+	// row-major [features, features] matrix). Float products are exact in double, so every level
+	// produces the same bits however the adds are fused.
+	static void accumulate_gram_float32(const float *x, size_t rows, size_t features, double *gram);
+
+	// Scalar reference conversions, also used for loop tails
+	static uint16_t float32_to_float16_scalar(float value);
+	static float float16_to_float32_scalar(uint16_t value);
+	static uint16_t float32_to_bfloat16_scalar(float value);
+	static float bfloat16_to_float32_scalar(uint16_t value);
+};
@@ -31,12 +31,24 @@
 #include "executorch_linear_regression.h"
 #include "core/object/class_db.h"
 #include "core/os/time.h"
+#include "executorch_kernels.h"
+#include "executorch_tensor.h"
+
+#include <cmath>
 
 ExecuTorchLinearRegression::ExecuTorchLinearRegression() :
-		slope(2.0),
-		intercept(3.0),
+		input_features(1),
+		packed_weights(nullptr),
+		fit_samples(0),
+		fit_features(0),
+		fit_outputs(0),
+		ridge(0.0),
+		forgetting_factor(1.0),
 		total_inferences_count(0),
 		last_inference_time_ms(0.0) {
+	weights.push_back(2.0f);
+	bias.push_back(3.0f);
+	_pack_weights();
 	_initialize_mcp_tools();
 }
 
@@ -49,9 +61,30 @@ void ExecuTorchLinearRegression::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_slope"), &ExecuTorchLinearRegression::get_slope);
 	ClassDB::bind_method(D_METHOD("set_intercept", "intercept"), &ExecuTorchLinearRegression::set_intercept);
 	ClassDB::bind_method(D_METHOD("get_intercept"), &ExecuTorchLinearRegression::get_intercept);
+	ClassDB::bind_method(D_METHOD("set_parameters", "weights", "bias"), &ExecuTorchLinearRegression::set_parameters);
+	ClassDB::bind_method(D_METHOD("set_input_features", "input_features"), &ExecuTorchLinearRegression::set_input_features);
+	ClassDB::bind_method(D_METHOD("get_input_features"), &ExecuTorchLinearRegression::get_input_features);
+	ClassDB::bind_method(D_METHOD("get_output_features"), &ExecuTorchLinearRegression::get_output_features);
+	ClassDB::bind_method(D_METHOD("set_weights", "weights"), &ExecuTorchLinearRegression::set_weights);
+	ClassDB::bind_method(D_METHOD("get_weights"), &ExecuTorchLinearRegression::get_weights);
+	ClassDB::bind_method(D_METHOD("set_bias", "bias"), &ExecuTorchLinearRegression::set_bias);
+	ClassDB::bind_method(D_METHOD("get_bias"), &ExecuTorchLinearRegression::get_bias);
+	ClassDB::bind_method(D_METHOD("is_valid"), &ExecuTorchLinearRegression::is_valid);
+
+	// Fitting
+	ClassDB::bind_method(D_METHOD("fit_stream", "xs", "ys"), &ExecuTorchLinearRegression::fit_stream);
+	ClassDB::bind_method(D_METHOD("solve_fit"), &ExecuTorchLinearRegression::solve_fit);
+	ClassDB::bind_method(D_METHOD("fit_recursive", "xs", "ys"), &ExecuTorchLinearRegression::fit_recursive);
+	ClassDB::bind_method(D_METHOD("reset_fit"), &ExecuTorchLinearRegression::reset_fit);
+	ClassDB::bind_method(D_METHOD("get_fit_sample_count"), &ExecuTorchLinearRegression::get_fit_sample_count);
+	ClassDB::bind_method(D_METHOD("set_ridge", "ridge"), &ExecuTorchLinearRegression::set_ridge);
+	ClassDB::bind_method(D_METHOD("get_ridge"), &ExecuTorchLinearRegression::get_ridge);
+	ClassDB::bind_method(D_METHOD("set_forgetting_factor", "forgetting_factor"), &ExecuTorchLinearRegression::set_forgetting_factor);
+	ClassDB::bind_method(D_METHOD("get_forgetting_factor"), &ExecuTorchLinearRegression::get_forgetting_factor);
 
 	// Inference methods
 	ClassDB::bind_method(D_METHOD("run_inference", "inputs"), &ExecuTorchLinearRegression::run_inference);
+	ClassDB::bind_method(D_METHOD("predict_batch", "inputs"), &ExecuTorchLinearRegression::predict_batch);
 
 	// MCP tools
 	ClassDB::bind_method(D_METHOD("list_mcp_tools"), &ExecuTorchLinearRegression::list_mcp_tools);
@@ -64,28 +97,332 @@ void ExecuTorchLinearRegression::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_total_inferences"), &ExecuTorchLinearRegression::get_total_inferences);
 	ClassDB::bind_method(D_METHOD("get_last_inference_time"), &ExecuTorchLinearRegression::get_last_inference_time);
 
-	// Properties
-	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "slope"), "set_slope", "get_slope");
-	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "intercept"), "set_intercept", "get_intercept");
+	// Properties; slope and intercept are views of weights and bias, so only those are stored
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "input_features", PROPERTY_HINT_RANGE, "1,4096,1,or_greater"), "set_input_features", "get_input_features");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "weights"), "set_weights", "get_weights");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "bias"), "set_bias", "get_bias");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "slope", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_EDITOR), "set_slope", "get_slope");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "intercept", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_EDITOR), "set_intercept", "get_intercept");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "ridge", PROPERTY_HINT_RANGE, "0,1,0.0001,or_greater"), "set_ridge", "get_ridge");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "forgetting_factor", PROPERTY_HINT_RANGE, "0.9,1,0.0001"), "set_forgetting_factor", "get_forgetting_factor");
 
 	// Signals
 	ADD_SIGNAL(MethodInfo("inference_completed", PropertyInfo(Variant::DICTIONARY, "result")));
 }
 
 void ExecuTorchLinearRegression::set_slope(double p_slope) {
-	slope = p_slope;
+	if (weights.is_empty()) {
+		weights.push_back(p_slope);
+	} else {
+		weights.set(0, p_slope);
+	}
+	_parameters_changed();
 }
 
 double ExecuTorchLinearRegression::get_slope() const {
-	return slope;
+	return weights.is_empty() ? 0.0 : weights[0];
 }
 
 void ExecuTorchLinearRegression::set_intercept(double p_intercept) {
-	intercept = p_intercept;
+	if (bias.is_empty()) {
+		bias.push_back(p_intercept);
+	} else {
+		bias.set(0, p_intercept);
+	}
+	_parameters_changed();
 }
 
 double ExecuTorchLinearRegression::get_intercept() const {
-	return intercept;
+	return bias.is_empty() ? 0.0 : bias[0];
+}
+
+Error ExecuTorchLinearRegression::set_parameters(const PackedFloat32Array &p_weights, const PackedFloat32Array &p_bias) {
+	ERR_FAIL_COND_V_MSG(p_bias.is_empty() || p_weights.is_empty() || p_weights.size() % p_bias.size() != 0, ERR_INVALID_PARAMETER,
+			vformat("%d weights do not split into rows for %d outputs.", p_weights.size(), p_bias.size()));
+	weights = p_weights;
+	bias = p_bias;
+	input_features = p_weights.size() / p_bias.size();
+	_parameters_changed();
+	return OK;
+}
+
+void ExecuTorchLinearRegression::set_input_features(int p_input_features) {
+	ERR_FAIL_COND_MSG(p_input_features < 1, "A linear regression needs at least one input feature.");
+	input_features = p_input_features;
+	_parameters_changed();
+}
+
+int ExecuTorchLinearRegression::get_input_features() const {
+	return input_features;
+}
+
+int ExecuTorchLinearRegression::get_output_features() const {
+	return bias.size();
+}
+
+void ExecuTorchLinearRegression::set_weights(const PackedFloat32Array &p_weights) {
+	weights = p_weights;
+	_parameters_changed();
+}
+
+PackedFloat32Array ExecuTorchLinearRegression::get_weights() const {
+	return weights;
+}
+
+void ExecuTorchLinearRegression::set_bias(const PackedFloat32Array &p_bias) {
+	bias = p_bias;
+	_parameters_changed();
+}
+
+PackedFloat32Array ExecuTorchLinearRegression::get_bias() const {
+	return bias;
+}
+
+// Properties are set one at a time, so the shapes may disagree until the last one lands
+bool ExecuTorchLinearRegression::is_valid() const {
+	return input_features > 0 && !bias.is_empty() && weights.size() == (int64_t)input_features * bias.size();
+}
+
+void ExecuTorchLinearRegression::_pack_weights() {
+	if (!is_valid()) {
+		packed_weights_storage.clear();
+		packed_weights = nullptr;
+		return;
+	}
+
+	const size_t alignment = 64 / sizeof(float);
+	packed_weights_storage.resize(ExecuTorchKernels::get_gemm_packed_size(input_features, bias.size()) + alignment);
+	uintptr_t misalignment = (uintptr_t)packed_weights_storage.data() % 64;
+	packed_weights = packed_weights_storage.data() + (misalignment ? (64 - misalignment) / sizeof(float) : 0);
+	ExecuTorchKernels::pack_gemm_weights(weights.ptr(), packed_weights, input_features, bias.size());
+}
+
+// Hand-set parameters replace whatever recursive least squares had converged to
+void ExecuTorchLinearRegression::_parameters_changed() {
+	_pack_weights();
+	rls_covariance.clear();
+	rls_coefficients.clear();
+}
+
+Error ExecuTorchLinearRegression::_check_samples(const PackedFloat32Array &xs, const PackedFloat32Array &ys, int64_t &r_rows) const {
+	ERR_FAIL_COND_V_MSG(!is_valid(), ERR_UNCONFIGURED, "Linear regression weights do not match input_features and bias.");
+	ERR_FAIL_COND_V_MSG(xs.size() % input_features != 0, ERR_INVALID_PARAMETER, vformat("%d sample values do not split into rows of %d features.", xs.size(), input_features));
+	r_rows = xs.size() / input_features;
+	ERR_FAIL_COND_V_MSG(ys.size() != r_rows * bias.size(), ERR_INVALID_PARAMETER, vformat("%d samples need %d targets, got %d.", r_rows, r_rows * bias.size(), ys.size()));
+	return OK;
+}
+
+// coefficients is [input_features + 1, outputs] with the bias in the last row
+void ExecuTorchLinearRegression::_apply_coefficients(const std::vector<double> &coefficients) {
+	const int outputs = bias.size();
+	float *w = weights.ptrw();
+	float *b = bias.ptrw();
+	for (int o = 0; o < outputs; o++) {
+		for (int i = 0; i < input_features; i++) {
+			w[o * input_features + i] = coefficients[i * outputs + o];
+		}
+		b[o] = coefficients[input_features * outputs + o];
+	}
+	_pack_weights();
+}
+
+Error ExecuTorchLinearRegression::fit_stream(const PackedFloat32Array &xs, const PackedFloat32Array &ys) {
+	int64_t rows = 0;
+	Error err = _check_samples(xs, ys, rows);
+	if (err != OK) {
+		return err;
+	}
+
+	const int outputs = bias.size();
+	const size_t width = input_features + 1 + outputs;
+	if (fit_features != input_features || fit_outputs != outputs) {
+		// The model changed shape since the last batch
+		fit_gram.assign(width * width, 0.0);
+		fit_samples = 0;
+		fit_features = input_features;
+		fit_outputs = outputs;
+	}
+
+	// Rows of z = [x, 1, y] in blocks that stay in cache next to the Gram matrix
+	const int64_t block = 256;
+	fit_rows.resize(block * width);
+	const float *x = xs.ptr();
+	const float *y = ys.ptr();
+	for (int64_t r0 = 0; r0 < rows; r0 += block) {
+		const int64_t count = MIN(block, rows - r0);
+		for (int64_t r = 0; r < count; r++) {
+			float *z = fit_rows.data() + r * width;
+			memcpy(z, x + (r0 + r) * input_features, input_features * sizeof(float));
+			z[input_features] = 1.0f;
+			memcpy(z + input_features + 1, y + (r0 + r) * outputs, outputs * sizeof(float));
+		}
+		ExecuTorchKernels::accumulate_gram_float32(fit_rows.data(), count, width, fit_gram.data());
+	}
+	fit_samples += rows;
+	return OK;
+}
+
+Error ExecuTorchLinearRegression::solve_fit() {
+	ERR_FAIL_COND_V_MSG(!is_valid(), ERR_UNCONFIGURED, "Linear regression weights do not match input_features and bias.");
+	const int outputs = bias.size();
+	const size_t size = input_features + 1;
+	const size_t width = size + outputs;
+	ERR_FAIL_COND_V_MSG(fit_samples == 0 || fit_features != input_features || fit_outputs != outputs, ERR_UNCONFIGURED, "No samples have been fitted for the current shape.");
+
+	// Normal equations (X^T X + ridge) beta = X^T Y, solved by Cholesky: X^T X = L L^T
+	std::vector<double> lower(size * size, 0.0);
+	for (size_t i = 0; i < size; i++) {
+		for (size_t j = 0; j <= i; j++) {
+			double sum = fit_gram[j * width + i];
+			if (i == j && i < (size_t)input_features) {
+				sum += ridge;
+			}
+			for (size_t k = 0; k < j; k++) {
+				sum -= lower[i * size + k] * lower[j * size + k];
+			}
+			if (i == j) {
+				ERR_FAIL_COND_V_MSG(!(sum > 1e-12 * MAX(1.0, fit_gram[i * width + i])), ERR_CANT_RESOLVE,
+						vformat("The %d fitted samples do not determine every weight; add varied samples or set ridge.", fit_samples));
+				lower[i * size + i] = std::sqrt(sum);
+			} else {
+				lower[i * size + j] = sum / lower[j * size + j];
+			}
+		}
+	}
+
+	std::vector<double> coefficients(size * outputs);
+	std::vector<double> column(size);
+	for (int o = 0; o < outputs; o++) {
+		// L u = X^T y, then L^T beta = u
+		for (size_t i = 0; i < size; i++) {
+			double sum = fit_gram[i * width + size + o];
+			for (size_t k = 0; k < i; k++) {
+				sum -= lower[i * size + k] * column[k];
+			}
+			column[i] = sum / lower[i * size + i];
+		}
+		for (size_t i = size; i-- > 0;) {
+			double sum = column[i];
+			for (size_t k = i + 1; k < size; k++) {
+				sum -= lower[k * size + i] * column[k];
+			}
+			column[i] = sum / lower[i * size + i];
+		}
+		for (size_t i = 0; i < size; i++) {
+			coefficients[i * outputs + o] = column[i];
+		}
+	}
+
+	_apply_coefficients(coefficients);
+	// The solved weights are the new starting point for recursive updates
+	rls_covariance.clear();
+	rls_coefficients.clear();
+	return OK;
+}
+
+Error ExecuTorchLinearRegression::fit_recursive(const PackedFloat32Array &xs, const PackedFloat32Array &ys) {
+	int64_t rows = 0;
+	Error err = _check_samples(xs, ys, rows);
+	if (err != OK) {
+		return err;
+	}
+
+	const int outputs = bias.size();
+	const size_t size = input_features + 1;
+	if (rls_covariance.size() != size * size || rls_coefficients.size() != size * outputs) {
+		// Start from the current parameters with a wide prior around them
+		const double initial_covariance = 1e6;
+		rls_covariance.assign(size * size, 0.0);
+		for (size_t i = 0; i < size; i++) {
+			rls_covariance[i * size + i] = initial_covariance;
+		}
+		rls_coefficients.assign(size * outputs, 0.0);
+		for (int o = 0; o < outputs; o++) {
+			for (int i = 0; i < input_features; i++) {
+				rls_coefficients[i * outputs + o] = weights[o * input_features + i];
+			}
+			rls_coefficients[input_features * outputs + o] = bias[o];
+		}
+	}
+
+	std::vector<double> z(size);
+	std::vector<double> pz(size);
+	double *p = rls_covariance.data();
+	double *theta = rls_coefficients.data();
+	const float *x = xs.ptr();
+	const float *y = ys.ptr();
+	for (int64_t r = 0; r < rows; r++) {
+		for (int i = 0; i < input_features; i++) {
+			z[i] = x[r * input_features + i];
+		}
+		z[input_features] = 1.0;
+
+		double denominator = forgetting_factor;
+		for (size_t i = 0; i < size; i++) {
+			double sum = 0.0;
+			for (size_t j = 0; j < size; j++) {
+				sum += p[i * size + j] * z[j];
+			}
+			pz[i] = sum;
+			denominator += z[i] * sum;
+		}
+
+		// theta += P z / d * (y - theta^T z)^T
+		for (int o = 0; o < outputs; o++) {
+			double error = y[r * outputs + o];
+			for (size_t i = 0; i < size; i++) {
+				error -= theta[i * outputs + o] * z[i];
+			}
+			const double step = error / denominator;
+			for (size_t i = 0; i < size; i++) {
+				theta[i * outputs + o] += pz[i] * step;
+			}
+		}
+
+		// P = (P - P z z^T P / d) / lambda, written from one triangle so it stays symmetric
+		for (size_t i = 0; i < size; i++) {
+			for (size_t j = i; j < size; j++) {
+				double value = (p[i * size + j] - pz[i] * pz[j] / denominator) / forgetting_factor;
+				p[i * size + j] = value;
+				p[j * size + i] = value;
+			}
+		}
+	}
+
+	_apply_coefficients(rls_coefficients);
+	return OK;
+}
+
+void ExecuTorchLinearRegression::reset_fit() {
+	fit_gram.clear();
+	fit_rows.clear();
+	fit_samples = 0;
+	fit_features = 0;
+	fit_outputs = 0;
+	rls_covariance.clear();
+	rls_coefficients.clear();
+}
+
+int64_t ExecuTorchLinearRegression::get_fit_sample_count() const {
+	return fit_samples;
+}
+
+void ExecuTorchLinearRegression::set_ridge(double p_ridge) {
+	ERR_FAIL_COND_MSG(p_ridge < 0.0, "Ridge must not be negative.");
+	ridge = p_ridge;
+}
+
+double ExecuTorchLinearRegression::get_ridge() const {
+	return ridge;
+}
+
+void ExecuTorchLinearRegression::set_forgetting_factor(double p_forgetting_factor) {
+	ERR_FAIL_COND_MSG(!(p_forgetting_factor > 0.0 && p_forgetting_factor <= 1.0), "Forgetting factor must be in (0, 1].");
+	forgetting_factor = p_forgetting_factor;
+}
+
+double ExecuTorchLinearRegression::get_forgetting_factor() const {
+	return forgetting_factor;
 }
 
 Dictionary ExecuTorchLinearRegression::run_inference(const Dictionary &inputs) {
@@ -99,30 +436,19 @@ Dictionary ExecuTorchLinearRegression::run_inference(const Dictionary &inputs) {
 		return result;
 	}
 
-	Variant input_var = inputs["input_0"];
-
-	// Handle different input formats
-	double input_value = 0.0;
-	if (input_var.get_type() == Variant::PACKED_FLOAT32_ARRAY) {
-		PackedFloat32Array input_array = input_var;
-		if (input_array.size() > 0) {
-			input_value = input_array[0];
-		}
-	} else if (input_var.get_type() == Variant::ARRAY) {
-		Array input_array = input_var;
-		if (input_array.size() > 0) {
-			input_value = input_array[0];
-		}
-	} else if (input_var.get_type() == Variant::FLOAT) {
-		input_value = input_var;
+	// Handle different input formats (packed arrays of any tensor dtype, Array, scalar)
+	ExecuTorchTensor input_tensor;
+	PackedFloat32Array input_array;
+	if (ExecuTorchTensor::from_variant(inputs["input_0"], input_tensor) != OK || input_tensor.to_float32(input_array) != OK) {
+		print_error("Unsupported input_0 format");
+		return result;
 	}
 
-	// Run linear regression: y = slope * x + intercept
-	double output_value = slope * input_value + intercept;
-
-	// Create output array
-	PackedFloat32Array output_array;
-	output_array.push_back(output_value);
+	// Run linear regression: y = weights * x + bias, one row per input_features values
+	PackedFloat32Array output_array = predict_batch(input_array);
+	if (output_array.is_empty() && !input_array.is_empty()) {
+		return result;
+	}
 	result["output_0"] = output_array;
 
 	uint64_t end_time = Time::get_singleton()->get_ticks_usec();
@@ -130,7 +456,9 @@ Dictionary ExecuTorchLinearRegression::run_inference(const Dictionary &inputs) {
 
 	_update_performance_stats(inference_time);
 
-	print_line("Linear regression: f(" + rtos(input_value) + ") = " + rtos(slope) + " * " + rtos(input_value) + " + " + rtos(intercept) + " = " + rtos(output_value));
+	if (input_array.size() == 1 && output_array.size() == 1) {
+		print_line("Linear regression: f(" + rtos(input_array[0]) + ") = " + rtos(get_slope()) + " * " + rtos(input_array[0]) + " + " + rtos(get_intercept()) + " = " + rtos(output_array[0]));
+	}
 
 	emit_signal("inference_completed", result);
 	return result;
@@ -153,6 +481,17 @@ PackedFloat32Array ExecuTorchLinearRegression::predict(const PackedFloat32Array
 	return PackedFloat32Array();
 }
 
+PackedFloat32Array ExecuTorchLinearRegression::predict_batch(const PackedFloat32Array &inputs) const {
+	ERR_FAIL_COND_V_MSG(!is_valid(), PackedFloat32Array(), vformat("Linear regression has %d weights, which is not %d input features times %d outputs.", weights.size(), input_features, bias.size()));
+	ERR_FAIL_COND_V_MSG(inputs.size() % input_features != 0, PackedFloat32Array(), vformat("%d input values do not split into rows of %d features.", inputs.size(), input_features));
+
+	const int64_t rows = inputs.size() / input_features;
+	PackedFloat32Array outputs;
+	outputs.resize(rows * bias.size());
+	ExecuTorchKernels::gemm_packed_float32(inputs.ptr(), packed_weights, bias.ptr(), outputs.ptrw(), rows, input_features, bias.size());
+	return outputs;
+}
+
 Array ExecuTorchLinearRegression::list_mcp_tools() const {
 	Array tools;
 	Array keys = mcp_tools.keys();
@@ -165,11 +504,19 @@ Array ExecuTorchLinearRegression::list_mcp_tools() const {
 Dictionary ExecuTorchLinearRegression::get_model_info() const {
 	Dictionary info;
 	info["model_type"] = "linear_regression";
-	info["slope"] = slope;
-	info["intercept"] = intercept;
-	info["equation"] = "y = " + rtos(slope) + " * x + " + rtos(intercept);
-	info["input_shape"] = Array();
-	info["output_shape"] = Array();
+	info["slope"] = get_slope();
+	info["intercept"] = get_intercept();
+	if (input_features == 1 && bias.size() == 1) {
+		info["equation"] = "y = " + rtos(get_slope()) + " * x + " + rtos(get_intercept());
+	} else {
+		info["equation"] = vformat("y = W x + b, W is %d x %d", bias.size(), input_features);
+	}
+	Array input_shape;
+	input_shape.push_back(input_features);
+	info["input_shape"] = input_shape;
+	Array output_shape;
+	output_shape.push_back(bias.size());
+	info["output_shape"] = output_shape;
 	info["total_inferences"] = total_inferences_count;
 	info["last_inference_time_ms"] = last_inference_time_ms;
 	return info;
@@ -177,11 +524,12 @@ Dictionary ExecuTorchLinearRegression::get_model_info() const {
 
 Dictionary ExecuTorchLinearRegression::health_check() const {
 	Dictionary health;
-	health["status"] = "healthy";
+	health["status"] = is_valid() ? "healthy" : "invalid_parameters";
 	health["model_loaded"] = true;
-	health["can_run_inference"] = true;
+	health["can_run_inference"] = is_valid();
 	health["total_inferences"] = total_inferences_count;
 	health["memory_usage"] = "N/A (analytical model)";
+	health["kernel_isa"] = ExecuTorchKernels::get_level_name(ExecuTorchKernels::get_level());
 	return health;
 }
 
@@ -247,11 +595,9 @@ void ExecuTorchLinearRegression::_initialize_mcp_tools() {
 
 Dictionary ExecuTorchLinearRegression::_run_linear_regression(double input_value) const {
 	Dictionary result;
-	double output_value = slope * input_value + intercept;
-
-	PackedFloat32Array output_array;
-	output_array.push_back(output_value);
-	result["output_0"] = output_array;
+	PackedFloat32Array input_array;
+	input_array.push_back(input_value);
+	result["output_0"] = predict_batch(input_array);
 
 	return result;
 }
@@ -32,13 +32,47 @@
 
 #include "executorch_node.h"
 
+#include <vector>
+
+/**
+ * ExecuTorchLinearRegression - Analytical y = W x + b model
+ *
+ * weights is row-major [output_features, input_features] and bias has one
+ * entry per output. slope and intercept address the first weight and bias,
+ * so the default 1x1 model keeps the scalar y = slope * x + intercept API.
+ * Inputs are batches of input_features values per row; the weights are
+ * repacked into ExecuTorchKernels' panel layout whenever they change.
+ *
+ * The parameters can also be fitted in the engine. fit_stream() folds
+ * sample batches into running sums for ordinary least squares, and
+ * solve_fit() turns them into weights on demand. fit_recursive() runs
+ * recursive least squares and updates the weights as samples arrive.
+ */
 class ExecuTorchLinearRegression : public ExecuTorchNode {
 	GDCLASS(ExecuTorchLinearRegression, ExecuTorchNode);
 
 private:
-	// Linear regression parameters: y = slope * x + intercept
-	double slope;
-	double intercept;
+	// Linear regression parameters: y = weights * x + bias
+	int input_features;
+	PackedFloat32Array weights;
+	PackedFloat32Array bias;
+
+	// weights in gemm_packed_float32's layout, starting at a 64-byte boundary
+	std::vector<float> packed_weights_storage;
+	float *packed_weights;
+
+	// Least squares: upper triangle of sum(z z^T) for z = [x, 1, y], in double
+	std::vector<double> fit_gram;
+	std::vector<float> fit_rows;
+	int64_t fit_samples;
+	int fit_features; // Shape the sums were taken for; any change restarts them
+	int fit_outputs;
+	double ridge;
+
+	// Recursive least squares over z = [x, 1]: inverse covariance and [features + 1, outputs] coefficients
+	std::vector<double> rls_covariance;
+	std::vector<double> rls_coefficients;
+	double forgetting_factor;
 
 	// Performance tracking
 	mutable int64_t total_inferences_count;
@@ -61,9 +95,35 @@ public:
 	void set_intercept(double p_intercept);
 	double get_intercept() const;
 
+	// Multivariate parameters; the input feature count is weights.size() / bias.size()
+	Error set_parameters(const PackedFloat32Array &p_weights, const PackedFloat32Array &p_bias);
+	void set_input_features(int p_input_features);
+	int get_input_features() const;
+	int get_output_features() const;
+	void set_weights(const PackedFloat32Array &p_weights);
+	PackedFloat32Array get_weights() const;
+	void set_bias(const PackedFloat32Array &p_bias);
+	PackedFloat32Array get_bias() const;
+	bool is_valid() const;
+
+	// In-engine fitting; xs holds rows of input_features values and ys rows of output_features values
+	Error fit_stream(const PackedFloat32Array &xs, const PackedFloat32Array &ys);
+	Error solve_fit();
+	Error fit_recursive(const PackedFloat32Array &xs, const PackedFloat32Array &ys);
+	void reset_fit();
+	int64_t get_fit_sample_count() const;
+	// Added to the diagonal of the weights (not the bias) when solving
+	void set_ridge(double p_ridge);
+	double get_ridge() const;
+	// Recursive least squares weight on past samples; 1 never forgets
+	void set_forgetting_factor(double p_forgetting_factor);
+	double get_forgetting_factor() const;
+
 	// Override inference methods
 	Dictionary run_inference(const Dictionary &inputs);
 	PackedFloat32Array predict(const PackedFloat32Array &input) override;
+	// Rows of input_features values in, rows of output_features values out
+	PackedFloat32Array predict_batch(const PackedFloat32Array &inputs) const;
 
 	// MCP tools interface
 	Array list_mcp_tools() const;
@@ -78,6 +138,10 @@ public:
 
 private:
 	void _initialize_mcp_tools();
+	void _pack_weights();
+	void _parameters_changed();
+	Error _check_samples(const PackedFloat32Array &xs, const PackedFloat32Array &ys, int64_t &r_rows) const;
+	void _apply_coefficients(const std::vector<double> &coefficients);
 	Dictionary _run_linear_regression(double input_value) const;
 	void _update_performance_stats(double inference_time) const;
 };
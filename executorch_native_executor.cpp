@@ -0,0 +1,582 @@
+/**************************************************************************/
+/*  executorch_native_executor.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "executorch_native_executor.h"
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "executorch_kernels.h"
+#include "executorch_runtime.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Ops that only rewrite shape metadata, so a contiguous copy does them
+const char *const COPY_OPERATORS[] = {
+	"aten::alias_copy.out",
+	"aten::clone.out",
+	"aten::squeeze_copy.dim_out",
+	"aten::squeeze_copy.dims_out",
+	"aten::unsqueeze_copy.out",
+	"aten::view_copy.out",
+	"dim_order_ops::_clone_dim_order.out",
+};
+
+bool _is_copy_operator(const String &name) {
+	for (const char *op : COPY_OPERATORS) {
+		if (name == op) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool _is_float_tensor(const ExecuTorchValueInfo &value) {
+	return value.type == ExecuTorchValueInfo::TYPE_TENSOR && value.tensor.dtype == ExecuTorchScalarType::FLOAT32 && !value.tensor.is_dynamic();
+}
+
+bool _is_one(const ExecuTorchValueInfo &value) {
+	switch (value.type) {
+		case ExecuTorchValueInfo::TYPE_INT:
+		case ExecuTorchValueInfo::TYPE_BOOL:
+			return value.int_value == 1;
+		case ExecuTorchValueInfo::TYPE_DOUBLE:
+			return value.double_value == 1.0;
+		default:
+			return false;
+	}
+}
+
+// True when small, less its leading 1s, matches the trailing dims of big
+bool _is_trailing_shape(const Vector<int64_t> &small, const Vector<int64_t> &big) {
+	int first = 0;
+	while (first < small.size() && small[first] == 1) {
+		first++;
+	}
+	int count = small.size() - first;
+	if (count > big.size()) {
+		return false;
+	}
+	for (int i = 0; i < count; i++) {
+		if (small[first + i] != big[big.size() - count + i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Element count, or -1 when a dim is negative or the tensor exceeds limit bytes of floats
+int64_t _bounded_element_count(const Vector<int64_t> &shape, int64_t limit) {
+	int64_t count = 1;
+	for (int64_t dim : shape) {
+		if (dim < 0 || (dim > 0 && count > limit / (int64_t)sizeof(float) / dim)) {
+			return -1;
+		}
+		count *= dim;
+	}
+	return count;
+}
+
+} // namespace
+
+void ExecuTorchNativeExecutor::_run_step(const Step &step, float *base) {
+	const float *a = base + step.a;
+	float *out = base + step.out;
+	switch (step.kind) {
+		case STEP_LINEAR:
+			ExecuTorchKernels::linear_float32(a, base + step.b, step.c >= 0 ? base + step.c : nullptr, out, step.m, step.k, step.n);
+			break;
+		case STEP_ADD:
+			for (int64_t i = 0; i < step.m; i++) {
+				ExecuTorchKernels::add_float32(a + i * step.n, base + step.b, out + i * step.n, step.n);
+			}
+			break;
+		case STEP_MUL:
+			for (int64_t i = 0; i < step.m; i++) {
+				ExecuTorchKernels::mul_float32(a + i * step.n, base + step.b, out + i * step.n, step.n);
+			}
+			break;
+		case STEP_ADD_SCALAR:
+			// x * 1 + s and x * s + -0 round exactly like x + s and x * s
+			ExecuTorchKernels::affine_float32(a, out, step.m, 1.0f, base[step.b]);
+			break;
+		case STEP_MUL_SCALAR:
+			ExecuTorchKernels::affine_float32(a, out, step.m, base[step.b], -0.0f);
+			break;
+		case STEP_RELU:
+			ExecuTorchKernels::relu_float32(a, out, step.m);
+			break;
+		case STEP_SIGMOID:
+			for (int64_t i = 0; i < step.m; i++) {
+				out[i] = 1.0f / (1.0f + std::exp(-a[i]));
+			}
+			break;
+		case STEP_TANH:
+			for (int64_t i = 0; i < step.m; i++) {
+				out[i] = std::tanh(a[i]);
+			}
+			break;
+		case STEP_SOFTMAX:
+			for (int64_t o = 0; o < step.m; o++) {
+				for (int64_t i = 0; i < step.k; i++) {
+					const float *x = a + o * step.n * step.k + i;
+					float *y = out + o * step.n * step.k + i;
+					float max_value = -INFINITY;
+					for (int64_t j = 0; j < step.n; j++) {
+						max_value = std::max(max_value, x[j * step.k]);
+					}
+					float sum = 0.0f;
+					for (int64_t j = 0; j < step.n; j++) {
+						y[j * step.k] = std::exp(x[j * step.k] - max_value);
+						sum += y[j * step.k];
+					}
+					const float inv_sum = 1.0f / sum;
+					for (int64_t j = 0; j < step.n; j++) {
+						y[j * step.k] *= inv_sum;
+					}
+				}
+			}
+			break;
+		case STEP_COPY:
+			memcpy(out, a, step.m * sizeof(float));
+			break;
+		case STEP_TRANSPOSE:
+			for (int64_t r = 0; r < step.m; r++) {
+				for (int64_t c = 0; c < step.n; c++) {
+					out[c * step.m + r] = a[r * step.n + c];
+				}
+			}
+			break;
+	}
+}
+
+Error ExecuTorchNativeExecutor::_compile(const uint8_t *data, const ExecuTorchMethodGraph &graph) {
+	auto unsupported = [this](const String &reason) {
+		unsupported_ = reason;
+		return ERR_UNAVAILABLE;
+	};
+	if (graph.delegate_count > 0) {
+		return unsupported("the program has delegated subgraphs");
+	}
+	if (graph.chain_count != 1) {
+		return unsupported(vformat("the method has %d chains", graph.chain_count));
+	}
+
+	// Every region starts on a 64-byte boundary
+	int64_t size = 0;
+	auto reserve = [&size](int64_t count) {
+		int64_t offset = size;
+		size += (count + 15) / 16 * 16;
+		return offset;
+	};
+
+	const int value_count = graph.values.size();
+	std::vector<int64_t> offsets(value_count, -1);
+	std::vector<bool> defined(value_count, false);
+	std::vector<bool> constant(value_count, false);
+
+	// Constants first, then one region per planned arena, then unplanned tensors
+	std::vector<int64_t> arena_bytes;
+	for (int i = 0; i < value_count; i++) {
+		const ExecuTorchValueInfo &value = graph.values[i];
+		if (value.type != ExecuTorchValueInfo::TYPE_TENSOR) {
+			continue;
+		}
+		if (_bounded_element_count(value.tensor.shape, MAX_MEMORY_BYTES) < 0 || value.tensor.memory_offset > (uint64_t)MAX_MEMORY_BYTES) {
+			return unsupported(vformat("value %d is larger than the native executor's limit", i));
+		}
+		if (value.data_offset >= 0) {
+			offsets[i] = reserve(value.tensor.get_element_count());
+			defined[i] = constant[i] = true;
+		} else if (value.tensor.memory_id >= 0) {
+			if (value.tensor.memory_offset % sizeof(float) != 0) {
+				return unsupported(vformat("value %d is planned at an unaligned offset", i));
+			}
+			if (value.tensor.memory_id >= graph.values.size()) {
+				return unsupported(vformat("value %d is planned in arena %d", i, value.tensor.memory_id));
+			}
+			if ((size_t)value.tensor.memory_id >= arena_bytes.size()) {
+				arena_bytes.resize(value.tensor.memory_id + 1, 0);
+			}
+			int64_t &bytes = arena_bytes[value.tensor.memory_id];
+			bytes = std::max(bytes, (int64_t)value.tensor.memory_offset + value.tensor.get_byte_size());
+		}
+	}
+	std::vector<int64_t> arena_offsets(arena_bytes.size());
+	for (size_t id = 0; id < arena_bytes.size(); id++) {
+		arena_offsets[id] = reserve((arena_bytes[id] + sizeof(float) - 1) / sizeof(float));
+	}
+	for (int i = 0; i < value_count; i++) {
+		const ExecuTorchValueInfo &value = graph.values[i];
+		if (value.type != ExecuTorchValueInfo::TYPE_TENSOR || offsets[i] >= 0) {
+			continue;
+		}
+		offsets[i] = value.tensor.memory_id >= 0 ? arena_offsets[value.tensor.memory_id] + (int64_t)(value.tensor.memory_offset / sizeof(float)) : reserve(value.tensor.get_element_count());
+	}
+
+	for (int32_t index : graph.inputs) {
+		const ExecuTorchValueInfo &value = graph.values[index];
+		if (value.type != ExecuTorchValueInfo::TYPE_TENSOR) {
+			// Non-tensor inputs are fixed at export, as in ExecuTorchMethodInfo
+			continue;
+		}
+		if (!_is_float_tensor(value)) {
+			return unsupported(vformat("input %d is not a static float32 tensor", inputs_.size()));
+		}
+		defined[index] = true;
+		input_offsets_.push_back(offsets[index]);
+		inputs_.push_back(value.tensor);
+	}
+
+	auto read_arg = [&](int32_t index) -> const ExecuTorchTensorInfo * {
+		return defined[index] && _is_float_tensor(graph.values[index]) ? &graph.values[index].tensor : nullptr;
+	};
+
+	// Steps that only read constants run once at load, into regions nothing else writes
+	std::vector<Step> load_steps;
+	auto emit = [&](Step step, std::initializer_list<int32_t> reads, int32_t out) {
+		bool fold = true;
+		for (int32_t index : reads) {
+			fold = fold && constant[index];
+		}
+		if (fold) {
+			offsets[out] = reserve(graph.values[out].tensor.get_element_count());
+			constant[out] = true;
+		}
+		defined[out] = true;
+		step.out = offsets[out];
+		(fold ? load_steps : steps_).push_back(step);
+	};
+
+	for (const ExecuTorchInstructionInfo &instruction : graph.instructions) {
+		if (instruction.type == ExecuTorchInstructionInfo::TYPE_FREE) {
+			continue;
+		}
+		if (instruction.type != ExecuTorchInstructionInfo::TYPE_KERNEL) {
+			return unsupported("the method has control flow or delegate calls");
+		}
+		const String &op = graph.operators[instruction.op_index];
+		const Vector<int32_t> &args = instruction.args;
+		if (args.size() < 2) {
+			return unsupported(vformat("%s has no output", op));
+		}
+
+		// Out variants list the out tensor last, as their return value
+		int32_t out = args[args.size() - 1];
+		if (!_is_float_tensor(graph.values[out])) {
+			return unsupported(vformat("%s writes a tensor that is not static float32", op));
+		}
+		const int64_t out_count = graph.values[out].tensor.get_element_count();
+		const ExecuTorchTensorInfo *x = read_arg(args[0]);
+
+		Step step;
+		if (op == "aten::linear.out" && args.size() == 5) {
+			const ExecuTorchTensorInfo *weight = read_arg(args[1]);
+			bool has_bias = graph.values[args[2]].type != ExecuTorchValueInfo::TYPE_NULL;
+			const ExecuTorchTensorInfo *bias = has_bias ? read_arg(args[2]) : nullptr;
+			if (!x || !weight || weight->shape.size() != 2 || x->shape.is_empty() || x->shape[x->shape.size() - 1] != weight->shape[1] ||
+					(has_bias && (!bias || bias->get_element_count() != weight->shape[0]))) {
+				return unsupported(vformat("%s has operands of unexpected shapes", op));
+			}
+			step.kind = STEP_LINEAR;
+			step.a = offsets[args[0]];
+			step.b = offsets[args[1]];
+			step.c = has_bias ? offsets[args[2]] : -1;
+			step.k = weight->shape[1];
+			step.n = weight->shape[0];
+			step.m = step.k > 0 ? x->get_element_count() / step.k : 0;
+			if (step.m * step.k != x->get_element_count() || step.m * step.n != out_count) {
+				return unsupported(vformat("%s has operands of unexpected shapes", op));
+			}
+			emit(step, { args[0], args[1], has_bias ? args[2] : args[1] }, out);
+		} else if ((op == "aten::addmm.out" && args.size() == 7) || (op == "aten::mm.out" && args.size() == 4)) {
+			bool addmm = args.size() == 7;
+			int32_t mat1_index = args[addmm ? 1 : 0];
+			int32_t mat2_index = args[addmm ? 2 : 1];
+			const ExecuTorchTensorInfo *mat1 = read_arg(mat1_index);
+			const ExecuTorchTensorInfo *mat2 = read_arg(mat2_index);
+			if (!mat1 || !mat2 || mat1->shape.size() != 2 || mat2->shape.size() != 2 || mat1->shape[1] != mat2->shape[0] ||
+					mat1->shape[0] * mat2->shape[1] != out_count) {
+				return unsupported(vformat("%s has operands of unexpected shapes", op));
+			}
+			if (addmm) {
+				const ExecuTorchTensorInfo *bias = read_arg(args[0]);
+				if (!bias || bias->get_element_count() != mat2->shape[1] || !_is_one(graph.values[args[3]]) || !_is_one(graph.values[args[4]])) {
+					return unsupported(vformat("%s needs a row bias and beta = alpha = 1", op));
+				}
+			}
+
+			// The kernel reads weight rows, so mat2 is transposed first; once, when it is constant
+			Step transpose;
+			transpose.kind = STEP_TRANSPOSE;
+			transpose.a = offsets[mat2_index];
+			transpose.m = mat2->shape[0];
+			transpose.n = mat2->shape[1];
+			transpose.out = reserve(transpose.m * transpose.n);
+			(constant[mat2_index] ? load_steps : steps_).push_back(transpose);
+
+			step.kind = STEP_LINEAR;
+			step.a = offsets[mat1_index];
+			step.b = transpose.out;
+			step.c = addmm ? offsets[args[0]] : -1;
+			step.m = mat1->shape[0];
+			step.k = mat1->shape[1];
+			step.n = mat2->shape[1];
+			emit(step, { mat1_index, mat2_index, addmm ? args[0] : mat2_index }, out);
+		} else if ((op == "aten::add.out" && args.size() == 5) || (op == "aten::mul.out" && args.size() == 4)) {
+			bool add = args.size() == 5;
+			if (add && !_is_one(graph.values[args[2]])) {
+				return unsupported(vformat("%s needs alpha = 1", op));
+			}
+			const ExecuTorchTensorInfo *y = read_arg(args[1]);
+			if (!x || !y) {
+				return unsupported(vformat("%s reads a tensor that is not static float32", op));
+			}
+			// Both ops commute, so the smaller operand is always the broadcast one
+			int32_t big = args[0], small = args[1];
+			if (y->get_element_count() > x->get_element_count()) {
+				std::swap(big, small);
+				std::swap(x, y);
+			}
+			int64_t small_count = y->get_element_count();
+			if (x->get_element_count() != out_count || small_count == 0) {
+				return unsupported(vformat("%s broadcasts both operands", op));
+			}
+			step.a = offsets[big];
+			step.b = offsets[small];
+			if (small_count == 1) {
+				step.kind = add ? STEP_ADD_SCALAR : STEP_MUL_SCALAR;
+				step.m = out_count;
+			} else if (small_count == out_count || _is_trailing_shape(y->shape, x->shape)) {
+				step.kind = add ? STEP_ADD : STEP_MUL;
+				step.n = small_count;
+				step.m = out_count / small_count;
+			} else {
+				return unsupported(vformat("%s broadcasts along a leading dimension", op));
+			}
+			emit(step, { args[0], args[1] }, out);
+		} else if ((op == "aten::relu.out" || op == "aten::sigmoid.out" || op == "aten::tanh.out") && args.size() == 3) {
+			if (!x || x->get_element_count() != out_count) {
+				return unsupported(vformat("%s has operands of unexpected shapes", op));
+			}
+			step.kind = op == "aten::relu.out" ? STEP_RELU : (op == "aten::sigmoid.out" ? STEP_SIGMOID : STEP_TANH);
+			step.a = offsets[args[0]];
+			step.m = out_count;
+			emit(step, { args[0] }, out);
+		} else if ((op == "aten::_softmax.out" || op == "aten::softmax.int_out") && args.size() == 5) {
+			const ExecuTorchValueInfo &dim_value = graph.values[args[1]];
+			// _softmax's half_to_float or softmax's dtype; both leave float32 alone when unset
+			const ExecuTorchValueInfo &option = graph.values[args[2]];
+			bool plain = option.type == ExecuTorchValueInfo::TYPE_NULL || (option.type == ExecuTorchValueInfo::TYPE_BOOL && option.int_value == 0);
+			if (!x || x->get_element_count() != out_count || dim_value.type != ExecuTorchValueInfo::TYPE_INT || !plain) {
+				return unsupported(vformat("%s has arguments this executor does not cover", op));
+			}
+			int64_t rank = x->shape.size();
+			int64_t dim = dim_value.int_value < 0 ? dim_value.int_value + rank : dim_value.int_value;
+			if (dim < 0 || dim >= rank) {
+				return unsupported(vformat("%s has dim %d out of range", op, dim_value.int_value));
+			}
+			step.kind = STEP_SOFTMAX;
+			step.a = offsets[args[0]];
+			step.m = 1;
+			step.n = x->shape[dim];
+			step.k = 1;
+			for (int64_t d = 0; d < rank; d++) {
+				if (d < dim) {
+					step.m *= x->shape[d];
+				} else if (d > dim) {
+					step.k *= x->shape[d];
+				}
+			}
+			emit(step, { args[0] }, out);
+		} else if ((op == "aten::t_copy.out" && args.size() == 3) || (op == "aten::permute_copy.out" && args.size() == 4)) {
+			if (!x || x->get_element_count() != out_count) {
+				return unsupported(vformat("%s has operands of unexpected shapes", op));
+			}
+			bool swap = x->shape.size() == 2;
+			if (args.size() == 4) {
+				const ExecuTorchValueInfo &dims = graph.values[args[1]];
+				bool identity = dims.type == ExecuTorchValueInfo::TYPE_INT_LIST && dims.int_list.size() == x->shape.size();
+				for (int d = 0; identity && d < dims.int_list.size(); d++) {
+					identity = dims.int_list[d] == d;
+				}
+				swap = swap && dims.type == ExecuTorchValueInfo::TYPE_INT_LIST && dims.int_list.size() == 2 && dims.int_list[0] == 1 && dims.int_list[1] == 0;
+				if (!identity && !swap) {
+					return unsupported(vformat("%s permutes more than two dimensions", op));
+				}
+			}
+			step.a = offsets[args[0]];
+			if (swap) {
+				step.kind = STEP_TRANSPOSE;
+				step.m = x->shape[0];
+				step.n = x->shape[1];
+			} else {
+				step.kind = STEP_COPY;
+				step.m = out_count;
+			}
+			emit(step, { args[0] }, out);
+		} else if (_is_copy_operator(op)) {
+			if (!x || x->get_element_count() != out_count) {
+				return unsupported(vformat("%s has operands of unexpected shapes", op));
+			}
+			step.kind = STEP_COPY;
+			step.a = offsets[args[0]];
+			step.m = out_count;
+			emit(step, { args[0] }, out);
+		} else {
+			return unsupported(vformat("operator %s is not covered", op));
+		}
+	}
+
+	for (int32_t index : graph.outputs) {
+		const ExecuTorchValueInfo &value = graph.values[index];
+		if (value.type != ExecuTorchValueInfo::TYPE_TENSOR) {
+			continue;
+		}
+		if (!defined[index] || !_is_float_tensor(value)) {
+			return unsupported(vformat("output %d is not a computed float32 tensor", outputs_.size()));
+		}
+		output_offsets_.push_back(offsets[index]);
+		outputs_.push_back(value.tensor);
+	}
+
+	if (size * (int64_t)sizeof(float) > MAX_MEMORY_BYTES) {
+		return unsupported(vformat("the program needs %d bytes, over the native executor's limit", size * (int64_t)sizeof(float)));
+	}
+	if (!_allocate_memory(size)) {
+		return unsupported(vformat("%d bytes for its arenas are over the memory budget", size * (int64_t)sizeof(float)));
+	}
+	for (int i = 0; i < value_count; i++) {
+		const ExecuTorchValueInfo &value = graph.values[i];
+		if (value.type == ExecuTorchValueInfo::TYPE_TENSOR && value.data_offset >= 0 && value.tensor.dtype == ExecuTorchScalarType::FLOAT32) {
+			memcpy(memory_ + offsets[i], data + value.data_offset, value.tensor.get_byte_size());
+		}
+	}
+	for (const Step &step : load_steps) {
+		_run_step(step, memory_);
+	}
+	return OK;
+}
+
+void ExecuTorchNativeExecutor::set_memory_source(ExecuTorchRuntime *runtime, ExecuTorchMemoryAccount *account) {
+	ERR_FAIL_COND_MSG(loaded_, "Set the memory source before loading.");
+	runtime_ = runtime;
+	account_ = account;
+}
+
+bool ExecuTorchNativeExecutor::_allocate_memory(int64_t elements) {
+	// Pool memory is reused, and planned values start zeroed as the exporter expects
+	size_t bytes = MAX(elements, (int64_t)1) * sizeof(float);
+	memory_ = (float *)(runtime_ ? runtime_->allocate_memory(bytes, ExecuTorchMemoryTag::ACTIVATIONS, account_) : memalloc(bytes));
+	if (!memory_) {
+		return false;
+	}
+	memset(memory_, 0, bytes);
+	memory_elements_ = elements;
+	return true;
+}
+
+void ExecuTorchNativeExecutor::_free_memory() {
+	if (memory_) {
+		if (runtime_) {
+			runtime_->deallocate_memory(memory_);
+		} else {
+			memfree(memory_);
+		}
+	}
+	memory_ = nullptr;
+	memory_elements_ = 0;
+}
+
+Error ExecuTorchNativeExecutor::load(const uint8_t *data, size_t size, const String &method_name) {
+	unload();
+
+	ExecuTorchMethodGraph graph;
+	Error err = ExecuTorchPTEParser::parse_graph(data, size, method_name, graph);
+	if (err != OK) {
+		return err;
+	}
+	err = _compile(data, graph);
+	if (err != OK) {
+		String reason = unsupported_;
+		unload();
+		unsupported_ = reason;
+		return err;
+	}
+	loaded_ = true;
+	return OK;
+}
+
+void ExecuTorchNativeExecutor::unload() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	steps_.clear();
+	_free_memory();
+	input_offsets_.clear();
+	output_offsets_.clear();
+	inputs_.clear();
+	outputs_.clear();
+	unsupported_ = String();
+	loaded_ = false;
+}
+
+Error ExecuTorchNativeExecutor::execute(const std::vector<ExecuTorchTensor> &inputs, std::vector<ExecuTorchTensor> &outputs) {
+	ERR_FAIL_COND_V_MSG(!loaded_, ERR_UNCONFIGURED, "Native executor has no program loaded.");
+	ERR_FAIL_COND_V_MSG(inputs.size() != input_offsets_.size(), ERR_INVALID_PARAMETER, vformat("Expected %d inputs, got %d.", (int64_t)input_offsets_.size(), (int64_t)inputs.size()));
+
+	std::vector<PackedFloat32Array> values(inputs.size());
+	for (size_t i = 0; i < inputs.size(); i++) {
+		Error err = inputs[i].to_float32(values[i]);
+		if (err != OK) {
+			return err;
+		}
+		ERR_FAIL_COND_V_MSG(values[i].size() != inputs_[i].get_element_count(), ERR_INVALID_PARAMETER,
+				vformat("Input %d has %d elements, expected %d.", (int64_t)i, values[i].size(), inputs_[i].get_element_count()));
+	}
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	float *base = memory_;
+	for (size_t i = 0; i < values.size(); i++) {
+		memcpy(base + input_offsets_[i], values[i].ptr(), values[i].size() * sizeof(float));
+	}
+	for (const Step &step : steps_) {
+		_run_step(step, base);
+	}
+
+	outputs.clear();
+	for (size_t i = 0; i < output_offsets_.size(); i++) {
+		PackedFloat32Array result;
+		result.resize(outputs_[i].get_element_count());
+		memcpy(result.ptrw(), base + output_offsets_[i], result.size() * sizeof(float));
+		outputs.push_back(ExecuTorchTensor::from_float32(result, outputs_[i].shape));
+	}
+	return OK;
+}
@@ -0,0 +1,134 @@
+/**************************************************************************/
+/*  executorch_native_executor.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/error/error_list.h"
+#include "core/string/ustring.h"
+#include "executorch_pte_parser.h"
+#include "executorch_tensor.h"
+#include <mutex>
+#include <vector>
+
+class ExecuTorchMemoryAccount;
+class ExecuTorchRuntime;
+
+/**
+ * ExecuTorchNativeExecutor - Runs small float32 programs without the runtime
+ *
+ * Compiles one method's kernel calls into steps over a single float buffer:
+ * constants are copied out of the program once, planned tensors keep the
+ * arena offsets the exporter laid out, and each step is a dispatched
+ * ExecuTorchKernels call. Steps whose inputs are all constants (the weight
+ * transposes in front of addmm, say) run once at load.
+ *
+ * Covers what small MLPs export to: linear/addmm/mm, add, mul, relu,
+ * sigmoid, tanh, softmax and the copy and transpose ops between them, on
+ * static float32 shapes. load() returns ERR_UNAVAILABLE for anything else
+ * so the caller can hand the program to the full runtime instead.
+ */
+class ExecuTorchNativeExecutor {
+public:
+	enum StepKind {
+		STEP_LINEAR, // m rows, k in features, n out features; c is the bias or -1
+		STEP_ADD, // b is broadcast over a in blocks of n, m times
+		STEP_MUL,
+		STEP_ADD_SCALAR, // b holds a single element
+		STEP_MUL_SCALAR,
+		STEP_RELU, // m elements
+		STEP_SIGMOID,
+		STEP_TANH,
+		STEP_SOFTMAX, // m outer, n along dim, k inner
+		STEP_COPY, // m elements
+		STEP_TRANSPOSE, // m x n to n x m
+	};
+
+	// Constants, arenas and scratch together; bigger programs belong on the full runtime
+	static constexpr int64_t MAX_MEMORY_BYTES = 64 * 1024 * 1024;
+
+private:
+	struct Step {
+		StepKind kind = STEP_COPY;
+		// Element offsets into memory_, -1 when unused
+		int64_t a = -1;
+		int64_t b = -1;
+		int64_t c = -1;
+		int64_t out = -1;
+		int64_t m = 0;
+		int64_t n = 0;
+		int64_t k = 0;
+	};
+
+	std::vector<Step> steps_;
+	// Constants, arenas and scratch in one block, from the runtime's pool when
+	// there is a runtime and from the heap otherwise
+	float *memory_ = nullptr;
+	int64_t memory_elements_ = 0;
+	ExecuTorchRuntime *runtime_ = nullptr;
+	ExecuTorchMemoryAccount *account_ = nullptr;
+	std::vector<int64_t> input_offsets_;
+	std::vector<int64_t> output_offsets_;
+	Vector<ExecuTorchTensorInfo> inputs_;
+	Vector<ExecuTorchTensorInfo> outputs_;
+	String unsupported_;
+	bool loaded_ = false;
+	// Steps share memory_, so calls take turns
+	std::mutex mutex_;
+
+	static void _run_step(const Step &step, float *base);
+	bool _allocate_memory(int64_t elements);
+	void _free_memory();
+	Error _compile(const uint8_t *data, const ExecuTorchMethodGraph &graph);
+
+public:
+	ExecuTorchNativeExecutor() {}
+	ExecuTorchNativeExecutor(const ExecuTorchNativeExecutor &) = delete;
+	ExecuTorchNativeExecutor &operator=(const ExecuTorchNativeExecutor &) = delete;
+	~ExecuTorchNativeExecutor() { unload(); }
+
+	// Where the next load() takes its memory from, charged to account when
+	// given; both must outlive the loaded program
+	void set_memory_source(ExecuTorchRuntime *runtime, ExecuTorchMemoryAccount *account);
+
+	// Compiles the method; ERR_UNAVAILABLE (see get_unsupported_reason()) when
+	// it uses ops, dtypes or dynamic shapes this executor does not cover
+	Error load(const uint8_t *data, size_t size, const String &method_name = "forward");
+	void unload();
+	bool is_loaded() const { return loaded_; }
+	String get_unsupported_reason() const { return unsupported_; }
+
+	Error execute(const std::vector<ExecuTorchTensor> &inputs, std::vector<ExecuTorchTensor> &outputs);
+
+	const Vector<ExecuTorchTensorInfo> &get_inputs() const { return inputs_; }
+	const Vector<ExecuTorchTensorInfo> &get_outputs() const { return outputs_; }
+	int get_step_count() const { return (int)steps_.size(); }
+	int64_t get_memory_bytes() const { return memory_elements_ * (int64_t)sizeof(float); }
+	bool is_runtime_memory() const { return memory_ && runtime_; }
+};
@@ -34,6 +34,13 @@
 ExecuTorchNode::ExecuTorchNode() {
 	inference_ = std::make_unique<ExecuTorchInference>();
 	auto_load = false;
+	warmup_iterations = 0;
+	overflow_policy = OVERFLOW_GROW;
+	pipeline_mode = PIPELINE_OFF;
+	pipeline_frames = 0;
+	pipeline_stalls = 0;
+	pipeline_repeats = 0;
+	pipeline_drops = 0;
 }
 
 ExecuTorchNode::~ExecuTorchNode() {
@@ -64,22 +71,54 @@ void ExecuTorchNode::_bind_methods() {
 	// Inference
 	ClassDB::bind_method(D_METHOD("predict", "input"), &ExecuTorchNode::predict);
 	ClassDB::bind_method(D_METHOD("predict_named", "inputs"), &ExecuTorchNode::predict_named);
+	ClassDB::bind_method(D_METHOD("warmup", "iterations"), &ExecuTorchNode::warmup, DEFVAL(3));
+	ClassDB::bind_method(D_METHOD("create_context"), &ExecuTorchNode::create_context);
+	ClassDB::bind_method(D_METHOD("submit", "input"), &ExecuTorchNode::submit);
+	ClassDB::bind_method(D_METHOD("is_request_done", "ticket"), &ExecuTorchNode::is_request_done);
+	ClassDB::bind_method(D_METHOD("take_result", "ticket"), &ExecuTorchNode::take_result);
+	ClassDB::bind_method(D_METHOD("cancel_request", "ticket"), &ExecuTorchNode::cancel_request);
+	ClassDB::bind_method(D_METHOD("get_queue_stats"), &ExecuTorchNode::get_queue_stats);
+	ClassDB::bind_method(D_METHOD("predict_pipelined", "input"), &ExecuTorchNode::predict_pipelined);
+	ClassDB::bind_method(D_METHOD("flush_pipeline"), &ExecuTorchNode::flush_pipeline);
+	ClassDB::bind_method(D_METHOD("get_pipeline_stats"), &ExecuTorchNode::get_pipeline_stats);
 
 	// Properties
 	ClassDB::bind_method(D_METHOD("set_model_path", "path"), &ExecuTorchNode::set_model_path);
 	ClassDB::bind_method(D_METHOD("get_model_path"), &ExecuTorchNode::get_model_path);
 	ClassDB::bind_method(D_METHOD("set_auto_load", "enable"), &ExecuTorchNode::set_auto_load);
 	ClassDB::bind_method(D_METHOD("get_auto_load"), &ExecuTorchNode::get_auto_load);
+	ClassDB::bind_method(D_METHOD("set_warmup_iterations", "iterations"), &ExecuTorchNode::set_warmup_iterations);
+	ClassDB::bind_method(D_METHOD("get_warmup_iterations"), &ExecuTorchNode::get_warmup_iterations);
+	ClassDB::bind_method(D_METHOD("set_runtime_name", "name"), &ExecuTorchNode::set_runtime_name);
+	ClassDB::bind_method(D_METHOD("get_runtime_name"), &ExecuTorchNode::get_runtime_name);
+	ClassDB::bind_method(D_METHOD("set_overflow_policy", "policy"), &ExecuTorchNode::set_overflow_policy);
+	ClassDB::bind_method(D_METHOD("get_overflow_policy"), &ExecuTorchNode::get_overflow_policy);
+	ClassDB::bind_method(D_METHOD("set_pipeline_mode", "mode"), &ExecuTorchNode::set_pipeline_mode);
+	ClassDB::bind_method(D_METHOD("get_pipeline_mode"), &ExecuTorchNode::get_pipeline_mode);
 
 	// Model info
 	ClassDB::bind_method(D_METHOD("get_input_names"), &ExecuTorchNode::get_input_names);
 	ClassDB::bind_method(D_METHOD("get_output_names"), &ExecuTorchNode::get_output_names);
 	ClassDB::bind_method(D_METHOD("get_input_shape", "name"), &ExecuTorchNode::get_input_shape);
 	ClassDB::bind_method(D_METHOD("get_output_shape", "name"), &ExecuTorchNode::get_output_shape);
+	ClassDB::bind_method(D_METHOD("get_input_dtype", "name"), &ExecuTorchNode::get_input_dtype);
+	ClassDB::bind_method(D_METHOD("get_output_dtype", "name"), &ExecuTorchNode::get_output_dtype);
+	ClassDB::bind_method(D_METHOD("is_input_dynamic", "name"), &ExecuTorchNode::is_input_dynamic);
 
 	// Properties
-	ADD_PROPERTY(PropertyInfo(Variant::STRING, "model_path", PROPERTY_HINT_FILE, "*.pte,*.et"), "set_model_path", "get_model_path");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "model_path", PROPERTY_HINT_FILE, "*.pte,*.ptez,*.et"), "set_model_path", "get_model_path");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_load"), "set_auto_load", "get_auto_load");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "warmup_iterations", PROPERTY_HINT_RANGE, "0,100,1"), "set_warmup_iterations", "get_warmup_iterations");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "runtime_name"), "set_runtime_name", "get_runtime_name");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "overflow_policy", PROPERTY_HINT_ENUM, "Drop,Block,Grow"), "set_overflow_policy", "get_overflow_policy");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "pipeline_mode", PROPERTY_HINT_ENUM, "Off,Double,Triple"), "set_pipeline_mode", "get_pipeline_mode");
+
+	BIND_ENUM_CONSTANT(OVERFLOW_DROP);
+	BIND_ENUM_CONSTANT(OVERFLOW_BLOCK);
+	BIND_ENUM_CONSTANT(OVERFLOW_GROW);
+	BIND_ENUM_CONSTANT(PIPELINE_OFF);
+	BIND_ENUM_CONSTANT(PIPELINE_DOUBLE);
+	BIND_ENUM_CONSTANT(PIPELINE_TRIPLE);
 
 	// Signals
 	ADD_SIGNAL(MethodInfo("model_loaded"));
@@ -93,11 +132,16 @@ bool ExecuTorchNode::load_model(const String &path) {
 		return false;
 	}
 
+	// Frames in flight belong to the model being replaced
+	flush_pipeline();
 	std::string std_path = path.utf8().get_data();
 	bool success = inference_->load_model(std_path);
 
 	if (success) {
 		model_path = path;
+		if (warmup_iterations > 0) {
+			warmup(warmup_iterations);
+		}
 		emit_signal("model_loaded");
 		print_line("ExecuTorch model loaded: " + path);
 	} else {
@@ -110,6 +154,10 @@ bool ExecuTorchNode::load_model(const String &path) {
 void ExecuTorchNode::unload_model() {
 	// Currently no unload method in ExecuTorchInference
 	// In a real implementation, you'd add this
+	flush_pipeline();
+	if (inference_) {
+		inference_->cancel_requests();
+	}
 	model_path = "";
 	emit_signal("model_unloaded");
 	print_line("ExecuTorch model unloaded");
@@ -125,36 +173,157 @@ PackedFloat32Array ExecuTorchNode::predict(const PackedFloat32Array &input) {
 		return PackedFloat32Array();
 	}
 
-	// Convert PackedFloat32Array to std::vector<float>
-	Vector<float> input_vec;
-	input_vec.resize(input.size());
-	for (int64_t i = 0; i < input.size(); i++) {
-		input_vec.push_back(input[i]);
+	PackedFloat32Array output = inference_->predict(input);
+
+	emit_signal("inference_completed", output);
+	return output;
+}
+
+Dictionary ExecuTorchNode::predict_named(const Dictionary &inputs) {
+	if (!is_model_loaded()) {
+		print_error("No model loaded");
+		return Dictionary();
+	}
+
+	return inference_->predict_named(inputs);
+}
+
+Dictionary ExecuTorchNode::warmup(int iterations) {
+	if (!is_model_loaded()) {
+		print_error("No model loaded");
+		return Dictionary();
+	}
+
+	return inference_->get_model()->warmup(iterations);
+}
+
+Ref<ExecuTorchInferenceContext> ExecuTorchNode::create_context() const {
+	if (!is_model_loaded()) {
+		print_error("No model loaded");
+		return Ref<ExecuTorchInferenceContext>();
 	}
 
-	// Run inference
-	Vector<float> result = inference_->predict(input_vec);
+	Ref<ExecuTorchInferenceContext> context;
+	context.instantiate();
+	context->set_model(inference_->get_model());
+	return context;
+}
 
-	// Convert back to PackedFloat32Array
-	PackedFloat32Array output;
-	output.resize(result.size());
-	for (int64_t i = 0; i < result.size(); i++) {
-		output.write[i] = result[i];
+int64_t ExecuTorchNode::submit(const PackedFloat32Array &input) {
+	if (!is_model_loaded()) {
+		print_error("No model loaded");
+		return ExecuTorchRequestQueue::INVALID_TICKET;
 	}
 
+	return inference_->submit(input, (ExecuTorchRequestQueue::OverflowPolicy)overflow_policy);
+}
+
+bool ExecuTorchNode::is_request_done(int64_t ticket) const {
+	return inference_ && inference_->is_request_done(ticket);
+}
+
+PackedFloat32Array ExecuTorchNode::take_result(int64_t ticket) {
+	ERR_FAIL_COND_V(!inference_, PackedFloat32Array());
+
+	PackedFloat32Array output = inference_->take_result(ticket);
+
 	emit_signal("inference_completed", output);
 	return output;
 }
 
-Dictionary ExecuTorchNode::predict_named(const Dictionary &inputs) {
+void ExecuTorchNode::cancel_request(int64_t ticket) {
+	ERR_FAIL_COND(!inference_);
+	inference_->cancel_request(ticket);
+}
+
+Dictionary ExecuTorchNode::get_queue_stats() const {
+	Dictionary stats;
+	ExecuTorchRequestQueue *queue = inference_ ? inference_->get_request_queue() : nullptr;
+	if (!queue) {
+		return stats;
+	}
+
+	ExecuTorchRequestQueue::Stats queue_stats = queue->get_stats();
+	stats["capacity"] = (int64_t)queue_stats.capacity;
+	stats["depth"] = (int64_t)queue_stats.depth;
+	stats["in_flight"] = (int64_t)queue_stats.in_flight;
+	stats["high_water"] = (int64_t)queue_stats.high_water;
+	stats["submitted"] = (int64_t)queue_stats.submitted;
+	stats["completed"] = (int64_t)queue_stats.completed;
+	stats["failed"] = (int64_t)queue_stats.failed;
+	stats["cancelled"] = (int64_t)queue_stats.cancelled;
+	stats["dropped"] = (int64_t)queue_stats.dropped;
+	stats["blocked"] = (int64_t)queue_stats.blocked;
+	stats["grown"] = (int64_t)queue_stats.grown;
+	stats["workers"] = queue_stats.workers;
+	return stats;
+}
+
+PackedFloat32Array ExecuTorchNode::predict_pipelined(const PackedFloat32Array &input) {
+	if (pipeline_mode == PIPELINE_OFF) {
+		return predict(input);
+	}
 	if (!is_model_loaded()) {
 		print_error("No model loaded");
-		return Dictionary();
+		return PackedFloat32Array();
 	}
 
-	// TODO: Implement named input/output prediction
-	print_line("Named prediction not yet implemented");
-	return Dictionary();
+	pipeline_frames++;
+	size_t older = pipeline_tickets.size();
+	int64_t ticket = inference_->submit(input, (ExecuTorchRequestQueue::OverflowPolicy)overflow_policy);
+	if (ticket == ExecuTorchRequestQueue::INVALID_TICKET) {
+		pipeline_drops++;
+	} else {
+		pipeline_tickets.push_back(ticket);
+	}
+
+	// Only frames before this one are collected, so a fast worker never cuts latency below a frame.
+	// Double buffering waits for the previous frame; triple takes the newest finished one
+	// and waits only when two frames are already in flight behind this one.
+	size_t max_behind = pipeline_mode == PIPELINE_DOUBLE ? 0 : 1;
+	bool fresh = false;
+	while (older > 0) {
+		bool done = inference_->is_request_done(pipeline_tickets[0]);
+		if (!done && older <= max_behind) {
+			break;
+		}
+		if (!done) {
+			pipeline_stalls++;
+		}
+		pipeline_result = inference_->take_result(pipeline_tickets[0]);
+		pipeline_tickets.erase(pipeline_tickets.begin());
+		older--;
+		fresh = true;
+	}
+
+	if (fresh) {
+		emit_signal("inference_completed", pipeline_result);
+	} else if (!pipeline_result.is_empty()) {
+		pipeline_repeats++;
+	}
+	return pipeline_result;
+}
+
+void ExecuTorchNode::flush_pipeline() {
+	if (inference_) {
+		for (int64_t ticket : pipeline_tickets) {
+			inference_->cancel_request(ticket);
+		}
+	}
+	pipeline_tickets.clear();
+	pipeline_result = PackedFloat32Array();
+}
+
+Dictionary ExecuTorchNode::get_pipeline_stats() const {
+	Dictionary stats;
+	stats["mode"] = pipeline_mode;
+	stats["latency_frames"] = pipeline_mode == PIPELINE_OFF ? 0 : 1;
+	stats["in_flight"] = (int64_t)pipeline_tickets.size();
+	stats["frames"] = (int64_t)pipeline_frames;
+	stats["stalls"] = (int64_t)pipeline_stalls;
+	stats["repeats"] = (int64_t)pipeline_repeats;
+	stats["drops"] = (int64_t)pipeline_drops;
+	return stats;
 }
 
 void ExecuTorchNode::set_model_path(const String &path) {
@@ -173,42 +342,94 @@ bool ExecuTorchNode::get_auto_load() const {
 	return auto_load;
 }
 
+void ExecuTorchNode::set_warmup_iterations(int iterations) {
+	ERR_FAIL_COND_MSG(iterations < 0, "Warmup iterations must not be negative.");
+	warmup_iterations = iterations;
+}
+
+int ExecuTorchNode::get_warmup_iterations() const {
+	return warmup_iterations;
+}
+
+void ExecuTorchNode::set_runtime_name(const String &name) {
+	// Frames in flight hold tickets on the old runtime's queue
+	flush_pipeline();
+	if (inference_) {
+		inference_->set_runtime_name(name.utf8().get_data());
+	}
+}
+
+String ExecuTorchNode::get_runtime_name() const {
+	return inference_ ? String::utf8(inference_->get_runtime_name().c_str()) : String();
+}
+
+void ExecuTorchNode::set_overflow_policy(OverflowPolicy policy) {
+	ERR_FAIL_INDEX((int)policy, OVERFLOW_GROW + 1);
+	overflow_policy = policy;
+}
+
+ExecuTorchNode::OverflowPolicy ExecuTorchNode::get_overflow_policy() const {
+	return overflow_policy;
+}
+
+void ExecuTorchNode::set_pipeline_mode(PipelineMode mode) {
+	ERR_FAIL_INDEX((int)mode, PIPELINE_TRIPLE + 1);
+	if (mode != pipeline_mode) {
+		flush_pipeline();
+	}
+	pipeline_mode = mode;
+}
+
+ExecuTorchNode::PipelineMode ExecuTorchNode::get_pipeline_mode() const {
+	return pipeline_mode;
+}
+
 PackedStringArray ExecuTorchNode::get_input_names() const {
 	if (!is_model_loaded()) {
 		return PackedStringArray();
 	}
-
-	// TODO: Convert std::vector<std::string> to PackedStringArray
-	print_line("get_input_names not yet implemented");
-	return PackedStringArray();
+	return Variant(inference_->get_model()->get_input_names());
 }
 
 PackedStringArray ExecuTorchNode::get_output_names() const {
 	if (!is_model_loaded()) {
 		return PackedStringArray();
 	}
-
-	// TODO: Convert std::vector<std::string> to PackedStringArray
-	print_line("get_output_names not yet implemented");
-	return PackedStringArray();
+	return Variant(inference_->get_model()->get_output_names());
 }
 
 PackedInt64Array ExecuTorchNode::get_input_shape(const String &name) const {
-	if (!is_model_loaded()) {
-		return PackedInt64Array();
-	}
-
-	// TODO: Convert std::vector<int64_t> to PackedInt64Array
-	print_line("get_input_shape not yet implemented");
-	return PackedInt64Array();
+	return _find_tensor_info(true, name).get("shape", PackedInt64Array());
 }
 
 PackedInt64Array ExecuTorchNode::get_output_shape(const String &name) const {
+	return _find_tensor_info(false, name).get("shape", PackedInt64Array());
+}
+
+int ExecuTorchNode::get_input_dtype(const String &name) const {
+	return _find_tensor_info(true, name).get("dtype", -1);
+}
+
+int ExecuTorchNode::get_output_dtype(const String &name) const {
+	return _find_tensor_info(false, name).get("dtype", -1);
+}
+
+bool ExecuTorchNode::is_input_dynamic(const String &name) const {
+	return int(_find_tensor_info(true, name).get("dynamism", 0)) != 0;
+}
+
+Dictionary ExecuTorchNode::_find_tensor_info(bool input, const String &name) const {
 	if (!is_model_loaded()) {
-		return PackedInt64Array();
+		return Dictionary();
 	}
 
-	// TODO: Convert std::vector<int64_t> to PackedInt64Array
-	print_line("get_output_shape not yet implemented");
-	return PackedInt64Array();
+	Ref<ExecuTorchResource> model = inference_->get_model();
+	Array infos = input ? model->get_input_info() : model->get_output_info();
+	for (int64_t i = 0; i < infos.size(); i++) {
+		Dictionary info = infos[i];
+		if (String(info["name"]) == name) {
+			return info;
+		}
+	}
+	return Dictionary();
 }
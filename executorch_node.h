@@ -32,16 +32,46 @@
 
 #include "core/string/ustring.h"
 #include "executorch_inference.h"
+#include "executorch_inference_context.h"
 #include "scene/main/node.h"
 #include <memory>
+#include <vector>
 
 class ExecuTorchNode : public Node {
 	GDCLASS(ExecuTorchNode, Node);
 
+public:
+	// Mirrors ExecuTorchRequestQueue::OverflowPolicy
+	enum OverflowPolicy {
+		OVERFLOW_DROP,
+		OVERFLOW_BLOCK,
+		OVERFLOW_GROW
+	};
+
+	// Frames of I/O in circulation for predict_pipelined()
+	enum PipelineMode {
+		PIPELINE_OFF, // Synchronous, like predict()
+		PIPELINE_DOUBLE, // One frame in flight, one consumed; waits if a frame is late
+		PIPELINE_TRIPLE // Up to two in flight; repeats the last result rather than wait
+	};
+
 private:
 	std::unique_ptr<ExecuTorchInference> inference_;
 	String model_path;
 	bool auto_load;
+	int warmup_iterations;
+	OverflowPolicy overflow_policy;
+
+	// Oldest first; never more than two
+	PipelineMode pipeline_mode;
+	std::vector<int64_t> pipeline_tickets;
+	PackedFloat32Array pipeline_result;
+	uint64_t pipeline_frames;
+	uint64_t pipeline_stalls;
+	uint64_t pipeline_repeats;
+	uint64_t pipeline_drops;
+
+	Dictionary _find_tensor_info(bool input, const String &name) const;
 
 protected:
 	static void _bind_methods();
@@ -59,16 +89,54 @@ public:
 	// Inference
 	virtual PackedFloat32Array predict(const PackedFloat32Array &input);
 	Dictionary predict_named(const Dictionary &inputs);
+	Dictionary warmup(int iterations = 3);
+	// A fresh context over this node's model, e.g. one per agent of a recurrent policy
+	Ref<ExecuTorchInferenceContext> create_context() const;
+
+	// Queued inference on the runtime's request workers; -1 when dropped
+	int64_t submit(const PackedFloat32Array &input);
+	bool is_request_done(int64_t ticket) const;
+	// Waits for the request to finish
+	PackedFloat32Array take_result(int64_t ticket);
+	void cancel_request(int64_t ticket);
+	Dictionary get_queue_stats() const;
+
+	// Submits this frame's input and returns the output for the previous
+	// frame's (empty on the first frame), so inference overlaps the rest of
+	// the frame. Latency is one frame; in triple mode a frame the workers
+	// have not finished yet repeats the result before it instead.
+	PackedFloat32Array predict_pipelined(const PackedFloat32Array &input);
+	// Drops frames in flight and the held result; loading a model or changing
+	// the runtime does this too
+	void flush_pipeline();
+	Dictionary get_pipeline_stats() const;
 
 	// Properties
 	void set_model_path(const String &path);
 	String get_model_path() const;
 	void set_auto_load(bool enable);
 	bool get_auto_load() const;
+	// Warmup calls made right after each successful load_model(); 0 disables
+	void set_warmup_iterations(int iterations);
+	int get_warmup_iterations() const;
+	// Moves the model resource onto the named runtime; every node sharing the
+	// resource (the cached load of the same path) moves with it
+	void set_runtime_name(const String &name);
+	String get_runtime_name() const;
+	void set_overflow_policy(OverflowPolicy policy);
+	OverflowPolicy get_overflow_policy() const;
+	void set_pipeline_mode(PipelineMode mode);
+	PipelineMode get_pipeline_mode() const;
 
 	// Model info
 	PackedStringArray get_input_names() const;
 	PackedStringArray get_output_names() const;
 	PackedInt64Array get_input_shape(const String &name) const;
 	PackedInt64Array get_output_shape(const String &name) const;
+	int get_input_dtype(const String &name) const;
+	int get_output_dtype(const String &name) const;
+	bool is_input_dynamic(const String &name) const;
 };
+
+VARIANT_ENUM_CAST(ExecuTorchNode::OverflowPolicy);
+VARIANT_ENUM_CAST(ExecuTorchNode::PipelineMode);
@@ -0,0 +1,246 @@
+/**************************************************************************/
+/*  executorch_pipeline.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "executorch_pipeline.h"
+#include "core/object/class_db.h"
+
+void ExecuTorchPipeline::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add_stage", "model", "name"), &ExecuTorchPipeline::add_stage, DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("connect_stages", "from_stage", "output_name", "to_stage", "input_name"), &ExecuTorchPipeline::connect_stages);
+	ClassDB::bind_method(D_METHOD("clear"), &ExecuTorchPipeline::clear);
+	ClassDB::bind_method(D_METHOD("get_stage_count"), &ExecuTorchPipeline::get_stage_count);
+	ClassDB::bind_method(D_METHOD("get_stage_names"), &ExecuTorchPipeline::get_stage_names);
+	ClassDB::bind_method(D_METHOD("get_input_names"), &ExecuTorchPipeline::get_input_names);
+	ClassDB::bind_method(D_METHOD("get_output_names"), &ExecuTorchPipeline::get_output_names);
+	ClassDB::bind_method(D_METHOD("run", "inputs"), &ExecuTorchPipeline::run);
+}
+
+int ExecuTorchPipeline::add_stage(const Ref<ExecuTorchResource> &model, const String &name) {
+	ERR_FAIL_COND_V_MSG(model.is_null(), -1, "Pipeline stages need a model.");
+	MutexLock lock(mutex_);
+	String stage_name = name.is_empty() ? "stage_" + itos(stages_.size()) : name;
+	ERR_FAIL_COND_V_MSG(_find_stage(stage_name) >= 0, -1, vformat("Pipeline already has a stage named '%s'.", stage_name));
+
+	Stage stage;
+	stage.name = stage_name;
+	stage.model = model;
+	stages_.push_back(stage);
+	compiled_ = false;
+	return (int)stages_.size() - 1;
+}
+
+Error ExecuTorchPipeline::connect_stages(const String &from_stage, const String &output_name, const String &to_stage, const String &input_name) {
+	MutexLock lock(mutex_);
+	int from = _find_stage(from_stage);
+	int to = _find_stage(to_stage);
+	ERR_FAIL_COND_V_MSG(from < 0, ERR_DOES_NOT_EXIST, vformat("No pipeline stage named '%s'.", from_stage));
+	ERR_FAIL_COND_V_MSG(to < 0, ERR_DOES_NOT_EXIST, vformat("No pipeline stage named '%s'.", to_stage));
+	ERR_FAIL_COND_V_MSG(from >= to, ERR_INVALID_PARAMETER, vformat("Stage '%s' runs after '%s'; stages can only feed later ones.", from_stage, to_stage));
+
+	std::vector<Link> &links = stages_[to].links;
+	for (Link &link : links) {
+		if (link.input_name == input_name) {
+			link.from_stage = from;
+			link.output_name = output_name;
+			compiled_ = false;
+			return OK;
+		}
+	}
+	links.push_back({ input_name, from, output_name });
+	compiled_ = false;
+	return OK;
+}
+
+void ExecuTorchPipeline::clear() {
+	MutexLock lock(mutex_);
+	stages_.clear();
+	input_names_.clear();
+	input_tensors_.clear();
+	compiled_ = false;
+}
+
+int ExecuTorchPipeline::get_stage_count() const {
+	MutexLock lock(mutex_);
+	return (int)stages_.size();
+}
+
+PackedStringArray ExecuTorchPipeline::get_stage_names() const {
+	MutexLock lock(mutex_);
+	PackedStringArray names;
+	for (const Stage &stage : stages_) {
+		names.push_back(stage.name);
+	}
+	return names;
+}
+
+PackedStringArray ExecuTorchPipeline::get_input_names() {
+	MutexLock lock(mutex_);
+	if (_compile() != OK) {
+		return PackedStringArray();
+	}
+	return Variant(input_names_);
+}
+
+PackedStringArray ExecuTorchPipeline::get_output_names() const {
+	MutexLock lock(mutex_);
+	if (stages_.empty()) {
+		return PackedStringArray();
+	}
+	return Variant(stages_.back().model->get_output_names());
+}
+
+Dictionary ExecuTorchPipeline::run(const Dictionary &inputs) {
+	MutexLock lock(mutex_);
+	ERR_FAIL_COND_V_MSG(stages_.empty(), Dictionary(), "Pipeline has no stages.");
+	Error err = _compile();
+	ERR_FAIL_COND_V_MSG(err != OK, Dictionary(), "Pipeline stages could not be wired.");
+
+	// Same matching as ExecuTorchResource::forward(): by name when every input is present, otherwise in order.
+	bool by_name = true;
+	for (int64_t i = 0; i < input_names_.size() && by_name; i++) {
+		by_name = inputs.has(input_names_[i]);
+	}
+	ERR_FAIL_COND_V_MSG(!by_name && inputs.size() != input_names_.size(), Dictionary(), "Expected " + itos(input_names_.size()) + " pipeline inputs, got " + itos(inputs.size()) + ".");
+	Array values = by_name ? Array() : inputs.values();
+
+	input_tensors_.resize(input_names_.size());
+	for (int64_t i = 0; i < input_names_.size(); i++) {
+		err = ExecuTorchTensor::from_variant(by_name ? inputs[input_names_[i]] : values[i], input_tensors_[i]);
+		ERR_FAIL_COND_V_MSG(err != OK, Dictionary(), "Failed to convert pipeline input " + String(input_names_[i]) + ".");
+	}
+
+	Dictionary result;
+	for (Stage &stage : stages_) {
+		stage.inputs.resize(stage.sources.size());
+		for (size_t i = 0; i < stage.sources.size(); i++) {
+			const Source &source = stage.sources[i];
+			if (source.stage < 0) {
+				stage.inputs[i] = input_tensors_[source.index];
+				continue;
+			}
+			const std::vector<ExecuTorchTensor> &produced = stages_[source.stage].outputs;
+			if ((size_t)source.index >= produced.size()) {
+				err = ERR_INVALID_DATA;
+				break;
+			}
+			stage.inputs[i] = produced[source.index];
+		}
+		if (err == OK) {
+			err = stage.model->forward_tensors(stage.inputs, stage.outputs);
+		}
+		if (err != OK) {
+			ERR_PRINT(vformat("Pipeline stage '%s' failed.", stage.name));
+			break;
+		}
+	}
+	if (err == OK) {
+		result = stages_.back().model->tensors_to_dictionary(stages_.back().outputs);
+	}
+
+	// Keep the vectors' capacity for the next run, but not the tensors themselves
+	input_tensors_.clear();
+	for (Stage &stage : stages_) {
+		stage.inputs.clear();
+		stage.outputs.clear();
+	}
+	return result;
+}
+
+int ExecuTorchPipeline::_find_stage(const String &name) const {
+	for (size_t i = 0; i < stages_.size(); i++) {
+		if (stages_[i].name == name) {
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+bool ExecuTorchPipeline::_is_compiled() const {
+	if (!compiled_) {
+		return false;
+	}
+	// A swapped model may declare different inputs and outputs
+	for (const Stage &stage : stages_) {
+		if (stage.model->get_model_generation() != stage.generation) {
+			return false;
+		}
+	}
+	return true;
+}
+
+Error ExecuTorchPipeline::_compile() {
+	if (_is_compiled()) {
+		return OK;
+	}
+
+	input_names_.clear();
+	for (size_t s = 0; s < stages_.size(); s++) {
+		Stage &stage = stages_[s];
+		ERR_FAIL_COND_V_MSG(!stage.model->is_loaded(), ERR_UNCONFIGURED, vformat("Pipeline stage '%s' has no model loaded.", stage.name));
+		stage.generation = stage.model->get_model_generation();
+		stage.output_names = stage.model->get_output_names();
+
+		Array names = stage.model->get_input_names();
+		stage.sources.resize(names.size());
+		for (int64_t i = 0; i < names.size(); i++) {
+			String input_name = names[i];
+			Source &source = stage.sources[i];
+			source.stage = -1;
+
+			for (const Link &link : stage.links) {
+				if (link.input_name == input_name) {
+					source.stage = link.from_stage;
+					source.index = (int)stages_[link.from_stage].output_names.find(link.output_name);
+					ERR_FAIL_COND_V_MSG(source.index < 0, ERR_DOES_NOT_EXIST, vformat("Stage '%s' has no output '%s'.", stages_[link.from_stage].name, link.output_name));
+					break;
+				}
+			}
+
+			for (int from = (int)s - 1; from >= 0 && source.stage < 0; from--) {
+				int index = (int)stages_[from].output_names.find(input_name);
+				if (index >= 0) {
+					source.stage = from;
+					source.index = index;
+				}
+			}
+
+			if (source.stage < 0) {
+				source.index = (int)input_names_.find(input_name);
+				if (source.index < 0) {
+					source.index = (int)input_names_.size();
+					input_names_.push_back(input_name);
+				}
+			}
+		}
+	}
+
+	compiled_ = true;
+	return OK;
+}
@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  executorch_pipeline.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
+#include "executorch_resource.h"
+#include "executorch_tensor.h"
+
+#include <vector>
+
+/**
+ * ExecuTorchPipeline - Models chained into one call
+ *
+ * Stages run in the order they were added. Each input a stage's model
+ * declares is fed by an explicit connect_stages() link, else by the latest
+ * earlier stage with an output of the same name, else by a pipeline input
+ * of that name. Tensors pass between stages as native handles through
+ * ExecuTorchResource::forward_tensors(); only the pipeline inputs and the
+ * last stage's outputs cross the Variant layer.
+ */
+class ExecuTorchPipeline : public RefCounted {
+	GDCLASS(ExecuTorchPipeline, RefCounted);
+
+private:
+	// Where a stage input comes from: a pipeline input (stage -1) or an earlier stage's output
+	struct Source {
+		int stage = -1;
+		int index = 0;
+	};
+
+	struct Link {
+		String input_name;
+		int from_stage = 0;
+		String output_name;
+	};
+
+	struct Stage {
+		String name;
+		Ref<ExecuTorchResource> model;
+		std::vector<Link> links;
+
+		// Resolved by _compile(), for the model generation they were built from
+		uint64_t generation = 0;
+		Array output_names;
+		std::vector<Source> sources;
+		std::vector<ExecuTorchTensor> inputs;
+		std::vector<ExecuTorchTensor> outputs;
+	};
+
+	std::vector<Stage> stages_;
+	Array input_names_;
+	std::vector<ExecuTorchTensor> input_tensors_;
+	bool compiled_ = false;
+	mutable Mutex mutex_;
+
+	int _find_stage(const String &name) const;
+	bool _is_compiled() const;
+	Error _compile();
+
+protected:
+	static void _bind_methods();
+
+public:
+	// Returns the stage index; an empty name becomes "stage_<index>"
+	int add_stage(const Ref<ExecuTorchResource> &model, const String &name = String());
+	// Feeds to_stage's input from from_stage's output; from_stage must run first
+	Error connect_stages(const String &from_stage, const String &output_name, const String &to_stage, const String &input_name);
+	void clear();
+
+	int get_stage_count() const;
+	PackedStringArray get_stage_names() const;
+	// Inputs no stage provides, in first-use order
+	PackedStringArray get_input_names();
+	PackedStringArray get_output_names() const;
+
+	// Runs every stage once; returns the last stage's outputs
+	Dictionary run(const Dictionary &inputs);
+};
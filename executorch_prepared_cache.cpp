@@ -0,0 +1,430 @@
+/**************************************************************************/
+/*  executorch_prepared_cache.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "executorch_prepared_cache.h"
+#include "core/config/engine.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/templates/hashfuncs.h"
+#include "executorch_runtime.h"
+#include "executorch_tensor.h"
+#include <atomic>
+#include <cstring>
+
+String ExecuTorchPreparedCache::directory;
+
+namespace {
+
+const char PREPARED_MAGIC[4] = { 'E', 'T', 'P', 'C' };
+const char *PREPARED_EXTENSION = "etpc";
+
+// Sanity limits, so a damaged entry cannot make us allocate wildly
+const uint32_t MAX_ENTRIES = 1 << 16;
+const uint32_t MAX_RANK = 64;
+
+// Two 32-bit murmur3 passes with different seeds, chunked so huge buffers fit the int length
+uint64_t hash_bytes(const uint8_t *data, int64_t size) {
+	const int64_t chunk_size = 1 << 30;
+	uint32_t low = HASH_MURMUR3_SEED;
+	uint32_t high = 0x9747b28c;
+	for (int64_t offset = 0; offset < size; offset += chunk_size) {
+		int length = (int)MIN(chunk_size, size - offset);
+		low = hash_murmur3_buffer(data + offset, length, low);
+		high = hash_murmur3_buffer(data + offset, length, high);
+	}
+	return ((uint64_t)high << 32) | low;
+}
+
+class PreparedWriter {
+	Ref<FileAccess> file;
+
+public:
+	explicit PreparedWriter(const Ref<FileAccess> &p_file) :
+			file(p_file) {}
+
+	void u8(uint8_t value) { file->store_8(value); }
+	void u32(uint32_t value) { file->store_32(value); }
+	void u64(uint64_t value) { file->store_64(value); }
+	void string(const String &value) {
+		CharString utf8 = value.utf8();
+		file->store_32(utf8.length());
+		file->store_buffer((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+	void int_vector(const Vector<int64_t> &values) {
+		u32(values.size());
+		for (int64_t value : values) {
+			u64((uint64_t)value);
+		}
+	}
+};
+
+class PreparedReader {
+	Ref<FileAccess> file;
+	uint64_t length = 0;
+	bool failed = false;
+
+	bool available(uint64_t bytes) {
+		if (failed || file->get_position() + bytes > length) {
+			failed = true;
+		}
+		return !failed;
+	}
+
+public:
+	explicit PreparedReader(const Ref<FileAccess> &p_file) :
+			file(p_file), length(p_file->get_length()) {}
+
+	bool has_failed() const { return failed || file->get_error() != OK; }
+	void fail() { failed = true; }
+
+	uint8_t u8() { return available(1) ? file->get_8() : 0; }
+	uint32_t u32() { return available(4) ? file->get_32() : 0; }
+	uint64_t u64() { return available(8) ? file->get_64() : 0; }
+
+	// Element count of a following array, checked against the bytes left in the file
+	uint32_t count(uint64_t element_size, uint32_t limit = MAX_ENTRIES) {
+		uint32_t value = u32();
+		if (value > limit || !available(value * element_size)) {
+			failed = true;
+			return 0;
+		}
+		return value;
+	}
+
+	String string() {
+		uint32_t size = count(1, UINT32_MAX);
+		if (size == 0) {
+			return String();
+		}
+		Vector<uint8_t> bytes;
+		bytes.resize(size);
+		file->get_buffer(bytes.ptrw(), size);
+		return String::utf8((const char *)bytes.ptr(), size);
+	}
+
+	Vector<int64_t> int_vector(uint32_t limit = MAX_ENTRIES) {
+		Vector<int64_t> values;
+		values.resize(count(8, limit));
+		for (int64_t &value : values) {
+			value = (int64_t)u64();
+		}
+		return values;
+	}
+};
+
+void write_tensor_info(PreparedWriter &w, const ExecuTorchTensorInfo &info) {
+	w.string(info.name);
+	w.u8((uint8_t)info.dtype);
+	w.int_vector(info.shape);
+	w.u32(info.dim_order.size());
+	for (uint8_t dim : info.dim_order) {
+		w.u8(dim);
+	}
+	w.u8((uint8_t)info.dynamism);
+	w.u32((uint32_t)info.memory_id);
+	w.u64(info.memory_offset);
+}
+
+// Enums are range checked, so a damaged entry cannot smuggle in an unknown dtype
+ExecuTorchScalarType read_dtype(PreparedReader &r) {
+	uint8_t dtype = r.u8();
+	if (!ExecuTorchTensor::is_valid_type(dtype)) {
+		r.fail();
+		return ExecuTorchScalarType::FLOAT32;
+	}
+	return (ExecuTorchScalarType)dtype;
+}
+
+ExecuTorchTensorInfo read_tensor_info(PreparedReader &r) {
+	ExecuTorchTensorInfo info;
+	info.name = r.string();
+	info.dtype = read_dtype(r);
+	info.shape = r.int_vector(MAX_RANK);
+	info.dim_order.resize(r.count(1, MAX_RANK));
+	for (uint8_t &dim : info.dim_order) {
+		dim = r.u8();
+	}
+	uint8_t dynamism = r.u8();
+	if (dynamism > (uint8_t)ExecuTorchShapeDynamism::DYNAMIC_UNBOUND) {
+		r.fail();
+	}
+	info.dynamism = (ExecuTorchShapeDynamism)dynamism;
+	info.memory_id = (int32_t)r.u32();
+	info.memory_offset = r.u64();
+	return info;
+}
+
+void write_tensor_list(PreparedWriter &w, const Vector<ExecuTorchTensorInfo> &tensors) {
+	w.u32(tensors.size());
+	for (const ExecuTorchTensorInfo &info : tensors) {
+		write_tensor_info(w, info);
+	}
+}
+
+Vector<ExecuTorchTensorInfo> read_tensor_list(PreparedReader &r) {
+	Vector<ExecuTorchTensorInfo> tensors;
+	uint32_t count = r.count(1);
+	for (uint32_t i = 0; i < count && !r.has_failed(); i++) {
+		tensors.push_back(read_tensor_info(r));
+	}
+	return tensors;
+}
+
+void write_string_list(PreparedWriter &w, const Vector<String> &strings) {
+	w.u32(strings.size());
+	for (const String &string : strings) {
+		w.string(string);
+	}
+}
+
+Vector<String> read_string_list(PreparedReader &r) {
+	Vector<String> strings;
+	uint32_t count = r.count(4);
+	for (uint32_t i = 0; i < count && !r.has_failed(); i++) {
+		strings.push_back(r.string());
+	}
+	return strings;
+}
+
+void write_shapes(PreparedWriter &w, const std::vector<Vector<int64_t>> &shapes, const std::vector<ExecuTorchScalarType> &dtypes) {
+	w.u32(shapes.size());
+	for (size_t i = 0; i < shapes.size(); i++) {
+		w.int_vector(shapes[i]);
+		w.u8((uint8_t)dtypes[i]);
+	}
+}
+
+void read_shapes(PreparedReader &r, std::vector<Vector<int64_t>> &r_shapes, std::vector<ExecuTorchScalarType> &r_dtypes) {
+	uint32_t count = r.count(5);
+	for (uint32_t i = 0; i < count && !r.has_failed(); i++) {
+		r_shapes.push_back(r.int_vector(MAX_RANK));
+		r_dtypes.push_back(read_dtype(r));
+	}
+}
+
+} // namespace
+
+bool ExecuTorchPreparedKey::operator==(const ExecuTorchPreparedKey &other) const {
+	return model_hash == other.model_hash && model_size == other.model_size && runtime_version == other.runtime_version && cpu_signature == other.cpu_signature;
+}
+
+ExecuTorchPreparedKey ExecuTorchPreparedCache::make_key(const PackedByteArray &model_data) {
+	ExecuTorchPreparedKey key;
+	key.model_hash = hash_bytes(model_data.ptr(), model_data.size());
+	key.model_size = model_data.size();
+	key.runtime_version = ExecuTorchRuntime::VERSION;
+	key.cpu_signature = get_cpu_signature();
+	return key;
+}
+
+String ExecuTorchPreparedCache::get_cpu_signature() {
+	return Engine::get_singleton()->get_architecture_name() + "/" + OS::get_singleton()->get_processor_name();
+}
+
+String ExecuTorchPreparedCache::get_entry_path(const ExecuTorchPreparedKey &key) {
+	return directory.path_join(String::num_uint64(key.model_hash, 16).lpad(16, "0") + "." + PREPARED_EXTENSION);
+}
+
+Error ExecuTorchPreparedCache::load(const ExecuTorchPreparedKey &key, ExecuTorchPreparedState &r_state) {
+	ERR_FAIL_COND_V(!is_enabled(), ERR_UNCONFIGURED);
+
+	Error err = OK;
+	Ref<FileAccess> file = FileAccess::open(get_entry_path(key), FileAccess::READ, &err);
+	if (file.is_null()) {
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	// Cheap validation first: magic, format and the full key
+	PreparedReader r(file);
+	char magic[4] = {};
+	if (file->get_buffer((uint8_t *)magic, 4) != 4 || memcmp(magic, PREPARED_MAGIC, 4) != 0 || r.u32() != FORMAT_VERSION) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	ExecuTorchPreparedKey stored;
+	stored.model_hash = r.u64();
+	stored.model_size = r.u64();
+	stored.runtime_version = r.string();
+	stored.cpu_signature = r.string();
+	if (r.has_failed() || stored != key) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	// The rest must be exactly the payload that was checksummed on save
+	uint64_t payload_size = r.u64();
+	uint64_t checksum = r.u64();
+	uint64_t payload_start = file->get_position();
+	if (r.has_failed() || payload_size != file->get_length() - payload_start) {
+		return ERR_FILE_CORRUPT;
+	}
+	Vector<uint8_t> payload;
+	payload.resize(payload_size);
+	if (file->get_buffer(payload.ptrw(), payload_size) != payload_size || hash_bytes(payload.ptr(), payload_size) != checksum) {
+		return ERR_FILE_CORRUPT;
+	}
+	file->seek(payload_start);
+
+	ExecuTorchPreparedState state;
+	state.program_info.version = r.u32();
+	state.program_info.program_size = r.u64();
+	state.program_info.segment_base_offset = r.u64();
+	uint32_t method_count = r.count(4);
+	for (uint32_t i = 0; i < method_count && !r.has_failed(); i++) {
+		ExecuTorchMethodInfo method;
+		method.name = r.string();
+		method.inputs = read_tensor_list(r);
+		method.outputs = read_tensor_list(r);
+		method.operators = read_string_list(r);
+		method.delegates = read_string_list(r);
+		method.non_const_buffer_sizes = r.int_vector();
+		state.program_info.methods.push_back(method);
+	}
+
+	uint32_t plan_count = r.count(4);
+	for (uint32_t i = 0; i < plan_count && !r.has_failed(); i++) {
+		std::pair<Vector<int64_t>, ExecuTorchExecutionPlan> entry;
+		entry.first = r.int_vector();
+		ExecuTorchExecutionPlan &plan = entry.second;
+		read_shapes(r, plan.input_shapes, plan.input_dtypes);
+		read_shapes(r, plan.output_shapes, plan.output_dtypes);
+		uint32_t offset_count = r.count(8);
+		for (uint32_t j = 0; j < offset_count; j++) {
+			plan.tensor_offsets.push_back(r.u64());
+		}
+		plan.arena_bytes = r.u64();
+		state.plans.push_back(entry);
+	}
+
+	if (r.has_failed()) {
+		return ERR_FILE_CORRUPT;
+	}
+	r_state = state;
+	return OK;
+}
+
+Error ExecuTorchPreparedCache::save(const ExecuTorchPreparedKey &key, const ExecuTorchPreparedState &state) {
+	ERR_FAIL_COND_V(!is_enabled(), ERR_UNCONFIGURED);
+
+	Error err = DirAccess::make_dir_recursive_absolute(directory);
+	ERR_FAIL_COND_V_MSG(err != OK && err != ERR_ALREADY_EXISTS, err, "Cannot create prepared cache directory: " + directory);
+
+	// Written beside the entry and renamed over it, so readers never see half an
+	// entry. The temp name is unique per process and call, so two editors or
+	// threads saving the same model never write into one file.
+	static std::atomic<uint32_t> save_counter(0);
+	String path = get_entry_path(key);
+	String temp_path = vformat("%s.%d-%d.tmp", path, OS::get_singleton()->get_process_id(), save_counter.fetch_add(1));
+	{
+		Ref<FileAccess> file = FileAccess::open(temp_path, FileAccess::WRITE_READ, &err);
+		ERR_FAIL_COND_V_MSG(file.is_null(), err, "Cannot write prepared cache entry: " + temp_path);
+
+		PreparedWriter w(file);
+		file->store_buffer((const uint8_t *)PREPARED_MAGIC, 4);
+		w.u32(FORMAT_VERSION);
+		w.u64(key.model_hash);
+		w.u64(key.model_size);
+		w.string(key.runtime_version);
+		w.string(key.cpu_signature);
+
+		// Payload size and checksum, filled in once the payload is written
+		uint64_t checksum_position = file->get_position();
+		w.u64(0);
+		w.u64(0);
+		uint64_t payload_start = file->get_position();
+
+		const ExecuTorchProgramInfo &info = state.program_info;
+		w.u32(info.version);
+		w.u64(info.program_size);
+		w.u64(info.segment_base_offset);
+		w.u32(info.methods.size());
+		for (const ExecuTorchMethodInfo &method : info.methods) {
+			w.string(method.name);
+			write_tensor_list(w, method.inputs);
+			write_tensor_list(w, method.outputs);
+			write_string_list(w, method.operators);
+			write_string_list(w, method.delegates);
+			w.int_vector(method.non_const_buffer_sizes);
+		}
+
+		w.u32(state.plans.size());
+		for (const std::pair<Vector<int64_t>, ExecuTorchExecutionPlan> &entry : state.plans) {
+			const ExecuTorchExecutionPlan &plan = entry.second;
+			w.int_vector(entry.first);
+			write_shapes(w, plan.input_shapes, plan.input_dtypes);
+			write_shapes(w, plan.output_shapes, plan.output_dtypes);
+			w.u32(plan.tensor_offsets.size());
+			for (uint64_t offset : plan.tensor_offsets) {
+				w.u64(offset);
+			}
+			w.u64(plan.arena_bytes);
+		}
+
+		uint64_t payload_size = file->get_position() - payload_start;
+		Vector<uint8_t> payload;
+		payload.resize(payload_size);
+		file->seek(payload_start);
+		file->get_buffer(payload.ptrw(), payload_size);
+		file->seek(checksum_position);
+		w.u64(payload_size);
+		w.u64(hash_bytes(payload.ptr(), payload_size));
+
+		err = file->get_error();
+		ERR_FAIL_COND_V_MSG(err != OK, err, "Failed writing prepared cache entry: " + temp_path);
+	}
+
+	Ref<DirAccess> dir = DirAccess::create_for_path(directory);
+	ERR_FAIL_COND_V(dir.is_null(), ERR_CANT_CREATE);
+	if (dir->file_exists(path)) {
+		dir->remove(path);
+	}
+	err = dir->rename(temp_path, path);
+	if (err != OK) {
+		dir->remove(temp_path); // Another save got there first
+	}
+	return err;
+}
+
+Error ExecuTorchPreparedCache::clear() {
+	ERR_FAIL_COND_V(!is_enabled(), ERR_UNCONFIGURED);
+
+	Ref<DirAccess> dir = DirAccess::open(directory);
+	if (dir.is_null()) {
+		return OK; // Nothing cached yet
+	}
+
+	dir->list_dir_begin();
+	for (String file = dir->get_next(); !file.is_empty(); file = dir->get_next()) {
+		if (!dir->current_is_dir() && (file.get_extension() == PREPARED_EXTENSION || (file.ends_with(".tmp") && file.contains(String(".") + PREPARED_EXTENSION + ".")))) {
+			dir->remove(file);
+		}
+	}
+	dir->list_dir_end();
+	return OK;
+}
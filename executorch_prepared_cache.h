@@ -0,0 +1,88 @@
+/**************************************************************************/
+/*  executorch_prepared_cache.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+#include "core/templates/vector.h"
+#include "executorch_pte_parser.h"
+#include "executorch_resource.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Identifies what a prepared entry was built from and for
+struct ExecuTorchPreparedKey {
+	uint64_t model_hash = 0;
+	uint64_t model_size = 0;
+	String runtime_version;
+	String cpu_signature;
+
+	bool operator==(const ExecuTorchPreparedKey &other) const;
+	bool operator!=(const ExecuTorchPreparedKey &other) const { return !(*this == other); }
+};
+
+struct ExecuTorchPreparedState {
+	ExecuTorchProgramInfo program_info;
+	// Plan cache entries, keyed as in ExecuTorchResource::_prepare_inputs()
+	std::vector<std::pair<Vector<int64_t>, ExecuTorchExecutionPlan>> plans;
+};
+
+/**
+ * ExecuTorchPreparedCache - Prepared program state kept between launches
+ *
+ * One file per model in the cache directory, named after the model hash.
+ * It holds the parsed program metadata and the execution plans the model
+ * has needed, so a later launch skips parsing and planning. Each entry
+ * repeats its full key in the header, so an entry written for another
+ * model, runtime version or CPU is rejected after a few dozen bytes; the
+ * rest is checksummed, so a torn or damaged payload is never parsed.
+ */
+class ExecuTorchPreparedCache {
+private:
+	static String directory;
+
+public:
+	static const uint32_t FORMAT_VERSION = 2;
+
+	// Empty disables the cache
+	static void set_directory(const String &path) { directory = path; }
+	static String get_directory() { return directory; }
+	static bool is_enabled() { return !directory.is_empty(); }
+
+	static ExecuTorchPreparedKey make_key(const PackedByteArray &model_data);
+	static String get_cpu_signature();
+	static String get_entry_path(const ExecuTorchPreparedKey &key);
+
+	static Error load(const ExecuTorchPreparedKey &key, ExecuTorchPreparedState &r_state);
+	static Error save(const ExecuTorchPreparedKey &key, const ExecuTorchPreparedState &state);
+	// Removes every entry in the directory
+	static Error clear();
+};
@@ -0,0 +1,603 @@
+/**************************************************************************/
+/*  executorch_pte_parser.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "executorch_pte_parser.h"
+
+#include "core/io/json.h"
+#include <cstring>
+
+namespace {
+
+// Program.fbs field indices
+enum ProgramField { PROGRAM_VERSION = 0,
+	PROGRAM_EXECUTION_PLAN = 1,
+	PROGRAM_CONSTANT_BUFFER = 2,
+	PROGRAM_SEGMENTS = 4,
+	PROGRAM_CONSTANT_SEGMENT = 5 };
+enum PlanField { PLAN_NAME = 0,
+	PLAN_CONTAINER_META = 1,
+	PLAN_VALUES = 2,
+	PLAN_INPUTS = 3,
+	PLAN_OUTPUTS = 4,
+	PLAN_CHAINS = 5,
+	PLAN_OPERATORS = 6,
+	PLAN_DELEGATES = 7,
+	PLAN_NON_CONST_BUFFER_SIZES = 8 };
+enum ContainerMetaField { META_ENCODED_INPUTS = 0,
+	META_ENCODED_OUTPUTS = 1 };
+enum EValueField { EVALUE_TYPE = 0,
+	EVALUE_VAL = 1 };
+enum TensorField { TENSOR_SCALAR_TYPE = 0,
+	TENSOR_SIZES = 2,
+	TENSOR_DIM_ORDER = 3,
+	TENSOR_DATA_BUFFER_IDX = 5,
+	TENSOR_ALLOCATION_INFO = 6,
+	TENSOR_SHAPE_DYNAMISM = 8 };
+enum AllocationField { ALLOCATION_MEMORY_ID = 0,
+	ALLOCATION_OFFSET_LOW = 1,
+	ALLOCATION_OFFSET_HIGH = 2 };
+enum OperatorField { OPERATOR_NAME = 0,
+	OPERATOR_OVERLOAD = 1 };
+enum DelegateField { DELEGATE_ID = 0 };
+enum ChainField { CHAIN_INSTRUCTIONS = 2 };
+enum InstructionField { INSTRUCTION_ARGS_TYPE = 0,
+	INSTRUCTION_ARGS = 1 };
+enum KernelCallField { KERNEL_CALL_OP_INDEX = 0,
+	KERNEL_CALL_ARGS = 1 };
+enum FreeCallField { FREE_CALL_VALUE_INDEX = 0 };
+// Int, Bool, Double and IntList all keep their payload in field 0
+enum ScalarField { SCALAR_VALUE = 0 };
+enum BufferField { BUFFER_STORAGE = 0 };
+enum DataSegmentField { SEGMENT_OFFSET = 0 };
+enum SubsegmentField { SUBSEGMENT_SEGMENT_INDEX = 0,
+	SUBSEGMENT_OFFSETS = 1 };
+
+const uint8_t KERNEL_TYPE_NULL = 1;
+const uint8_t KERNEL_TYPE_INT = 2;
+const uint8_t KERNEL_TYPE_BOOL = 3;
+const uint8_t KERNEL_TYPE_DOUBLE = 4;
+const uint8_t KERNEL_TYPE_TENSOR = 5;
+const uint8_t KERNEL_TYPE_INT_LIST = 7;
+const size_t EXTENDED_HEADER_OFFSET = 8;
+const uint32_t EXTENDED_HEADER_MIN_LENGTH = 24;
+
+// Bounds-checked flatbuffer walker; any out-of-range access clears ok.
+struct FlatBufferReader {
+	const uint8_t *data = nullptr;
+	size_t size = 0;
+	bool ok = true;
+
+	template <typename T>
+	T read(size_t offset) {
+		T value = T();
+		if (offset > size || size - offset < sizeof(T)) {
+			ok = false;
+			return value;
+		}
+		memcpy(&value, data + offset, sizeof(T));
+		return value;
+	}
+
+	// Follows a uoffset_t stored at offset
+	size_t deref(size_t offset) {
+		uint32_t rel = read<uint32_t>(offset);
+		if (!ok || rel == 0 || rel > size - offset) {
+			ok = false;
+			return 0;
+		}
+		return offset + rel;
+	}
+
+	// Absolute position of a table field, or 0 when absent
+	size_t field(size_t table, int index) {
+		if (table == 0) {
+			return 0;
+		}
+		int64_t vtable = (int64_t)table - read<int32_t>(table);
+		if (!ok || vtable < 0 || (uint64_t)vtable >= size) {
+			ok = false;
+			return 0;
+		}
+		uint16_t vtable_size = read<uint16_t>(vtable);
+		size_t entry = 4 + 2 * (size_t)index;
+		if (!ok || entry + 2 > vtable_size) {
+			return 0;
+		}
+		uint16_t field_offset = read<uint16_t>(vtable + entry);
+		return field_offset ? table + field_offset : 0;
+	}
+
+	template <typename T>
+	T scalar(size_t table, int index, T default_value) {
+		size_t pos = field(table, index);
+		return pos ? read<T>(pos) : default_value;
+	}
+
+	size_t table(size_t table, int index) {
+		size_t pos = field(table, index);
+		return pos ? deref(pos) : 0;
+	}
+
+	// Returns the element count and sets r_start to the first element
+	uint32_t vector(size_t table, int index, size_t &r_start, size_t element_size = 4) {
+		r_start = 0;
+		size_t pos = field(table, index);
+		if (!pos) {
+			return 0;
+		}
+		size_t vec = deref(pos);
+		uint32_t count = read<uint32_t>(vec);
+		if (!ok || (uint64_t)count * element_size > size - vec - 4) {
+			ok = false;
+			return 0;
+		}
+		r_start = vec + 4;
+		return count;
+	}
+
+	String string(size_t table, int index) {
+		size_t start;
+		uint32_t length = vector(table, index, start, 1);
+		if (!start) {
+			return String();
+		}
+		return String::utf8((const char *)data + start, length);
+	}
+
+	size_t table_at(size_t vector_start, uint32_t i) {
+		return deref(vector_start + 4 * (size_t)i);
+	}
+};
+
+Error _parse_tensor(FlatBufferReader &reader, size_t tensor, ExecuTorchTensorInfo &r_info) {
+	int8_t scalar_type = reader.scalar<int8_t>(tensor, TENSOR_SCALAR_TYPE, 0);
+	if (!ExecuTorchTensor::is_valid_type(scalar_type)) {
+		return ERR_UNAVAILABLE;
+	}
+	r_info.dtype = (ExecuTorchScalarType)scalar_type;
+
+	size_t start;
+	uint32_t count = reader.vector(tensor, TENSOR_SIZES, start);
+	r_info.shape.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		r_info.shape.write[i] = reader.read<int32_t>(start + 4 * (size_t)i);
+	}
+	count = reader.vector(tensor, TENSOR_DIM_ORDER, start, 1);
+	r_info.dim_order.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		r_info.dim_order.write[i] = reader.read<uint8_t>(start + i);
+	}
+
+	int8_t dynamism = reader.scalar<int8_t>(tensor, TENSOR_SHAPE_DYNAMISM, 0);
+	r_info.dynamism = dynamism >= 0 && dynamism <= 2 ? (ExecuTorchShapeDynamism)dynamism : ExecuTorchShapeDynamism::DYNAMIC_UNBOUND;
+
+	size_t allocation = reader.table(tensor, TENSOR_ALLOCATION_INFO);
+	if (allocation) {
+		r_info.memory_id = (int32_t)reader.scalar<uint32_t>(allocation, ALLOCATION_MEMORY_ID, 0);
+		uint64_t low = reader.scalar<uint32_t>(allocation, ALLOCATION_OFFSET_LOW, 0);
+		uint64_t high = reader.scalar<uint32_t>(allocation, ALLOCATION_OFFSET_HIGH, 0);
+		r_info.memory_offset = (high << 32) | low;
+	}
+	return reader.ok ? OK : ERR_FILE_CORRUPT;
+}
+
+Error _parse_io(FlatBufferReader &reader, size_t plan, int field, size_t values, uint32_t value_count, Vector<ExecuTorchTensorInfo> &r_tensors) {
+	size_t start;
+	uint32_t count = reader.vector(plan, field, start);
+	for (uint32_t i = 0; i < count && reader.ok; i++) {
+		int32_t value_index = reader.read<int32_t>(start + 4 * (size_t)i);
+		if (value_index < 0 || (uint32_t)value_index >= value_count) {
+			return ERR_FILE_CORRUPT;
+		}
+		size_t evalue = reader.table_at(values, value_index);
+		if (reader.scalar<uint8_t>(evalue, EVALUE_TYPE, 0) != KERNEL_TYPE_TENSOR) {
+			// Non-tensor inputs (ints, bools, lists) are baked into the call
+			continue;
+		}
+		ExecuTorchTensorInfo info;
+		Error err = _parse_tensor(reader, reader.table(evalue, EVALUE_VAL), info);
+		if (err != OK) {
+			return err;
+		}
+		r_tensors.push_back(info);
+	}
+	return reader.ok ? OK : ERR_FILE_CORRUPT;
+}
+
+// Collects leaf names from a torch pytree spec node; dict keys name their
+// subtrees, unnamed leaves stay empty.
+void _collect_leaf_names(const Dictionary &node, const String &prefix, Vector<String> &r_names) {
+	Array children = node.get("children_spec", Array());
+	if (children.is_empty() && node.get("type", Variant()).get_type() == Variant::NIL) {
+		r_names.push_back(prefix);
+		return;
+	}
+
+	Array keys;
+	if (String(node.get("type", "")) == "builtins.dict") {
+		Variant context = JSON::parse_string(node.get("context", "null"));
+		if (context.get_type() == Variant::ARRAY) {
+			keys = context;
+		}
+	}
+	for (int i = 0; i < children.size(); i++) {
+		String name = prefix;
+		if (i < keys.size()) {
+			name = prefix.is_empty() ? String(keys[i]) : prefix + "." + String(keys[i]);
+		}
+		_collect_leaf_names(children[i], name, r_names);
+	}
+}
+
+void _apply_names(const String &encoded_spec, const String &fallback_prefix, Vector<ExecuTorchTensorInfo> &r_tensors) {
+	Vector<String> names;
+	Variant spec = JSON::parse_string(encoded_spec);
+	if (spec.get_type() == Variant::ARRAY && Array(spec).size() == 2 && Array(spec)[1].get_type() == Variant::DICTIONARY) {
+		_collect_leaf_names(Array(spec)[1], String(), names);
+	}
+	// Leaves include non-tensor values, so names only line up when counts match
+	bool use_names = names.size() == r_tensors.size();
+	for (int i = 0; i < r_tensors.size(); i++) {
+		String name = use_names ? names[i] : String();
+		r_tensors.write[i].name = name.is_empty() ? fallback_prefix + itos(i) : name;
+	}
+}
+
+Error _parse_plan(FlatBufferReader &reader, size_t plan, ExecuTorchMethodInfo &r_method) {
+	r_method.name = reader.string(plan, PLAN_NAME);
+
+	size_t values;
+	uint32_t value_count = reader.vector(plan, PLAN_VALUES, values);
+	Error err = _parse_io(reader, plan, PLAN_INPUTS, values, value_count, r_method.inputs);
+	if (err == OK) {
+		err = _parse_io(reader, plan, PLAN_OUTPUTS, values, value_count, r_method.outputs);
+	}
+	if (err != OK) {
+		return err;
+	}
+
+	String encoded_inputs, encoded_outputs;
+	size_t meta = reader.table(plan, PLAN_CONTAINER_META);
+	if (meta) {
+		encoded_inputs = reader.string(meta, META_ENCODED_INPUTS);
+		encoded_outputs = reader.string(meta, META_ENCODED_OUTPUTS);
+	}
+	_apply_names(encoded_inputs, "input_", r_method.inputs);
+	_apply_names(encoded_outputs, "output_", r_method.outputs);
+
+	size_t start;
+	uint32_t count = reader.vector(plan, PLAN_OPERATORS, start);
+	for (uint32_t i = 0; i < count && reader.ok; i++) {
+		size_t op = reader.table_at(start, i);
+		String name = reader.string(op, OPERATOR_NAME);
+		String overload = reader.string(op, OPERATOR_OVERLOAD);
+		r_method.operators.push_back(overload.is_empty() ? name : name + "." + overload);
+	}
+	count = reader.vector(plan, PLAN_DELEGATES, start);
+	for (uint32_t i = 0; i < count && reader.ok; i++) {
+		r_method.delegates.push_back(reader.string(reader.table_at(start, i), DELEGATE_ID));
+	}
+	count = reader.vector(plan, PLAN_NON_CONST_BUFFER_SIZES, start, 8);
+	for (uint32_t i = 0; i < count && reader.ok; i++) {
+		r_method.non_const_buffer_sizes.push_back(reader.read<int64_t>(start + 8 * (size_t)i));
+	}
+	return reader.ok ? OK : ERR_FILE_CORRUPT;
+}
+
+// Validates the header, reads the extended header and returns the program table
+size_t _open_program(FlatBufferReader &reader, ExecuTorchProgramInfo &r_info) {
+	const uint8_t *data = reader.data;
+	size_t size = reader.size;
+	if (size >= EXTENDED_HEADER_OFFSET + EXTENDED_HEADER_MIN_LENGTH && memcmp(data + EXTENDED_HEADER_OFFSET, "eh00", 4) == 0 &&
+			reader.read<uint32_t>(EXTENDED_HEADER_OFFSET + 4) >= EXTENDED_HEADER_MIN_LENGTH) {
+		r_info.program_size = reader.read<uint64_t>(EXTENDED_HEADER_OFFSET + 8);
+		r_info.segment_base_offset = reader.read<uint64_t>(EXTENDED_HEADER_OFFSET + 16);
+		// Segment data trails the flatbuffer and is not part of the schema
+		if (r_info.program_size > 0 && r_info.program_size < size) {
+			reader.size = r_info.program_size;
+		}
+	}
+	return reader.deref(0);
+}
+
+Error _parse_value(FlatBufferReader &reader, size_t evalue, ExecuTorchValueInfo &r_value, uint32_t &r_data_buffer) {
+	r_data_buffer = 0;
+	size_t val = reader.table(evalue, EVALUE_VAL);
+	switch (reader.scalar<uint8_t>(evalue, EVALUE_TYPE, 0)) {
+		case 0:
+		case KERNEL_TYPE_NULL:
+			r_value.type = ExecuTorchValueInfo::TYPE_NULL;
+			break;
+		case KERNEL_TYPE_INT:
+			r_value.type = ExecuTorchValueInfo::TYPE_INT;
+			r_value.int_value = reader.scalar<int64_t>(val, SCALAR_VALUE, 0);
+			break;
+		case KERNEL_TYPE_BOOL:
+			r_value.type = ExecuTorchValueInfo::TYPE_BOOL;
+			r_value.int_value = reader.scalar<uint8_t>(val, SCALAR_VALUE, 0) != 0;
+			break;
+		case KERNEL_TYPE_DOUBLE:
+			r_value.type = ExecuTorchValueInfo::TYPE_DOUBLE;
+			r_value.double_value = reader.scalar<double>(val, SCALAR_VALUE, 0.0);
+			break;
+		case KERNEL_TYPE_TENSOR:
+			if (_parse_tensor(reader, val, r_value.tensor) != OK) {
+				// Dtypes this module has no tensor type for
+				r_value.type = ExecuTorchValueInfo::TYPE_OTHER;
+				break;
+			}
+			r_value.type = ExecuTorchValueInfo::TYPE_TENSOR;
+			r_data_buffer = reader.scalar<uint32_t>(val, TENSOR_DATA_BUFFER_IDX, 0);
+			break;
+		case KERNEL_TYPE_INT_LIST: {
+			// Items are indices of Int values, resolved once every value is read
+			r_value.type = ExecuTorchValueInfo::TYPE_INT_LIST;
+			size_t start;
+			uint32_t count = reader.vector(val, SCALAR_VALUE, start, 8);
+			for (uint32_t i = 0; i < count && reader.ok; i++) {
+				r_value.int_list.push_back(reader.read<int64_t>(start + 8 * (size_t)i));
+			}
+		} break;
+		default:
+			r_value.type = ExecuTorchValueInfo::TYPE_OTHER;
+			break;
+	}
+	return reader.ok ? OK : ERR_FILE_CORRUPT;
+}
+
+// Byte size of a tensor from an untrusted shape; -1 for negative dims or overflow
+int64_t _checked_byte_size(const ExecuTorchTensorInfo &info) {
+	int64_t bytes = ExecuTorchTensor::get_element_size(info.dtype);
+	for (int64_t dim : info.shape) {
+		if (dim < 0 || (dim > 0 && bytes > INT64_MAX / dim)) {
+			return -1;
+		}
+		bytes *= dim;
+	}
+	return bytes;
+}
+
+// Absolute offset of constant buffer index in the whole file, or -1 when it is out of range
+int64_t _locate_constant(FlatBufferReader &reader, size_t program, uint64_t segment_base_offset, size_t file_size, uint32_t index, int64_t byte_size) {
+	uint64_t offset = 0;
+	size_t start;
+	size_t constant_segment = reader.table(program, PROGRAM_CONSTANT_SEGMENT);
+	uint32_t count = reader.vector(constant_segment, SUBSEGMENT_OFFSETS, start, 8);
+	if (count > 0) {
+		// Current exports keep constants in a segment after the flatbuffer
+		if (index >= count) {
+			return -1;
+		}
+		uint32_t segment_index = reader.scalar<uint32_t>(constant_segment, SUBSEGMENT_SEGMENT_INDEX, 0);
+		size_t segments;
+		uint32_t segment_count = reader.vector(program, PROGRAM_SEGMENTS, segments);
+		if (segment_index >= segment_count) {
+			return -1;
+		}
+		uint64_t segment_offset = reader.scalar<uint64_t>(reader.table_at(segments, segment_index), SEGMENT_OFFSET, 0);
+		offset = segment_base_offset + segment_offset + reader.read<uint64_t>(start + 8 * (size_t)index);
+	} else {
+		// Older exports inline them in the flatbuffer
+		size_t buffers;
+		count = reader.vector(program, PROGRAM_CONSTANT_BUFFER, buffers);
+		if (index >= count) {
+			return -1;
+		}
+		uint32_t length = reader.vector(reader.table_at(buffers, index), BUFFER_STORAGE, start, 1);
+		if (length < byte_size) {
+			return -1;
+		}
+		offset = start;
+	}
+	if (!reader.ok || offset > file_size || file_size - offset < (uint64_t)byte_size) {
+		return -1;
+	}
+	return (int64_t)offset;
+}
+
+} // namespace
+
+int64_t ExecuTorchTensorInfo::get_element_count() const {
+	int64_t count = 1;
+	for (int i = 0; i < shape.size(); i++) {
+		count *= shape[i];
+	}
+	return count;
+}
+
+Dictionary ExecuTorchTensorInfo::to_dictionary() const {
+	PackedInt64Array dims;
+	for (int i = 0; i < shape.size(); i++) {
+		dims.push_back(shape[i]);
+	}
+
+	Dictionary info;
+	info["name"] = name;
+	info["dtype"] = (int)dtype;
+	info["dtype_name"] = ExecuTorchTensor::get_type_name(dtype);
+	info["shape"] = dims;
+	info["dynamism"] = (int)dynamism;
+	info["element_count"] = get_element_count();
+	info["byte_size"] = get_byte_size();
+	return info;
+}
+
+const ExecuTorchMethodInfo *ExecuTorchProgramInfo::find_method(const String &name) const {
+	for (int i = 0; i < methods.size(); i++) {
+		if (methods[i].name == name) {
+			return &methods[i];
+		}
+	}
+	return nullptr;
+}
+
+bool ExecuTorchPTEParser::has_program_identifier(const uint8_t *data, size_t size) {
+	// "ET" followed by a two digit schema version, e.g. "ET12"
+	return data && size >= 8 && data[4] == 'E' && data[5] == 'T' &&
+			data[6] >= '0' && data[6] <= '9' && data[7] >= '0' && data[7] <= '9';
+}
+
+Error ExecuTorchPTEParser::parse(const uint8_t *data, size_t size, ExecuTorchProgramInfo &r_info) {
+	ERR_FAIL_COND_V_MSG(!has_program_identifier(data, size), ERR_FILE_UNRECOGNIZED, "Buffer is not an ExecuTorch program.");
+
+	FlatBufferReader reader;
+	reader.data = data;
+	reader.size = size;
+	r_info = ExecuTorchProgramInfo();
+
+	size_t program = _open_program(reader, r_info);
+	r_info.version = reader.scalar<uint32_t>(program, PROGRAM_VERSION, 0);
+
+	size_t plans;
+	uint32_t plan_count = reader.vector(program, PROGRAM_EXECUTION_PLAN, plans);
+	for (uint32_t i = 0; i < plan_count && reader.ok; i++) {
+		ExecuTorchMethodInfo method;
+		Error err = _parse_plan(reader, reader.table_at(plans, i), method);
+		ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Failed to parse execution plan %d of ExecuTorch program.", i));
+		r_info.methods.push_back(method);
+	}
+	ERR_FAIL_COND_V_MSG(!reader.ok, ERR_FILE_CORRUPT, "ExecuTorch program is truncated or malformed.");
+	return OK;
+}
+
+Error ExecuTorchPTEParser::parse_graph(const uint8_t *data, size_t size, const String &method_name, ExecuTorchMethodGraph &r_graph) {
+	ERR_FAIL_COND_V_MSG(!has_program_identifier(data, size), ERR_FILE_UNRECOGNIZED, "Buffer is not an ExecuTorch program.");
+
+	FlatBufferReader reader;
+	reader.data = data;
+	reader.size = size;
+	r_graph = ExecuTorchMethodGraph();
+
+	ExecuTorchProgramInfo header;
+	size_t program = _open_program(reader, header);
+	size_t plans;
+	uint32_t plan_count = reader.vector(program, PROGRAM_EXECUTION_PLAN, plans);
+	size_t plan = 0;
+	for (uint32_t i = 0; i < plan_count && reader.ok && !plan; i++) {
+		size_t candidate = reader.table_at(plans, i);
+		if (reader.string(candidate, PLAN_NAME) == method_name) {
+			plan = candidate;
+		}
+	}
+	ERR_FAIL_COND_V_MSG(!reader.ok, ERR_FILE_CORRUPT, "ExecuTorch program is truncated or malformed.");
+	if (!plan) {
+		return ERR_DOES_NOT_EXIST;
+	}
+
+	size_t start;
+	uint32_t count = reader.vector(plan, PLAN_OPERATORS, start);
+	for (uint32_t i = 0; i < count && reader.ok; i++) {
+		size_t op = reader.table_at(start, i);
+		String name = reader.string(op, OPERATOR_NAME);
+		String overload = reader.string(op, OPERATOR_OVERLOAD);
+		r_graph.operators.push_back(overload.is_empty() ? name : name + "." + overload);
+	}
+	r_graph.delegate_count = (int)reader.vector(plan, PLAN_DELEGATES, start);
+
+	size_t values;
+	uint32_t value_count = reader.vector(plan, PLAN_VALUES, values);
+	r_graph.values.resize(value_count);
+	for (uint32_t i = 0; i < value_count && reader.ok; i++) {
+		ExecuTorchValueInfo &value = r_graph.values.write[i];
+		uint32_t data_buffer;
+		if (_parse_value(reader, reader.table_at(values, i), value, data_buffer) != OK) {
+			break;
+		}
+		// Buffer 0 is reserved for tensors without constant data
+		if (data_buffer > 0) {
+			int64_t byte_size = _checked_byte_size(value.tensor);
+			value.data_offset = byte_size < 0 ? -1 : _locate_constant(reader, program, header.segment_base_offset, size, data_buffer, byte_size);
+			ERR_FAIL_COND_V_MSG(value.data_offset < 0, ERR_FILE_CORRUPT, vformat("Constant data of value %d is out of range.", i));
+		}
+	}
+	ERR_FAIL_COND_V_MSG(!reader.ok, ERR_FILE_CORRUPT, "ExecuTorch program is truncated or malformed.");
+
+	for (int i = 0; i < r_graph.values.size(); i++) {
+		ExecuTorchValueInfo &value = r_graph.values.write[i];
+		for (int j = 0; j < value.int_list.size(); j++) {
+			int64_t index = value.int_list[j];
+			ERR_FAIL_COND_V_MSG(index < 0 || index >= r_graph.values.size() || r_graph.values[index].type != ExecuTorchValueInfo::TYPE_INT, ERR_FILE_CORRUPT,
+					vformat("Int list %d refers to a value that is not an Int.", i));
+			value.int_list.write[j] = r_graph.values[index].int_value;
+		}
+	}
+
+	Vector<int32_t> *io[2] = { &r_graph.inputs, &r_graph.outputs };
+	for (int k = 0; k < 2; k++) {
+		count = reader.vector(plan, k == 0 ? PLAN_INPUTS : PLAN_OUTPUTS, start);
+		for (uint32_t i = 0; i < count && reader.ok; i++) {
+			io[k]->push_back(reader.read<int32_t>(start + 4 * (size_t)i));
+		}
+	}
+
+	size_t chains;
+	r_graph.chain_count = (int)reader.vector(plan, PLAN_CHAINS, chains);
+	if (r_graph.chain_count > 0) {
+		size_t instructions;
+		count = reader.vector(reader.table_at(chains, 0), CHAIN_INSTRUCTIONS, instructions);
+		for (uint32_t i = 0; i < count && reader.ok; i++) {
+			size_t instruction = reader.table_at(instructions, i);
+			ExecuTorchInstructionInfo info;
+			uint8_t type = reader.scalar<uint8_t>(instruction, INSTRUCTION_ARGS_TYPE, 0);
+			ERR_FAIL_COND_V_MSG(type < ExecuTorchInstructionInfo::TYPE_KERNEL || type > ExecuTorchInstructionInfo::TYPE_FREE, ERR_FILE_CORRUPT,
+					vformat("Instruction %d has unknown type %d.", i, type));
+			info.type = (ExecuTorchInstructionInfo::Type)type;
+
+			size_t call = reader.table(instruction, INSTRUCTION_ARGS);
+			if (info.type == ExecuTorchInstructionInfo::TYPE_KERNEL) {
+				info.op_index = reader.scalar<int32_t>(call, KERNEL_CALL_OP_INDEX, 0);
+				size_t args;
+				uint32_t arg_count = reader.vector(call, KERNEL_CALL_ARGS, args);
+				for (uint32_t j = 0; j < arg_count && reader.ok; j++) {
+					info.args.push_back(reader.read<int32_t>(args + 4 * (size_t)j));
+				}
+			} else if (info.type == ExecuTorchInstructionInfo::TYPE_FREE) {
+				info.args.push_back((int32_t)reader.scalar<uint32_t>(call, FREE_CALL_VALUE_INDEX, 0));
+			}
+			r_graph.instructions.push_back(info);
+		}
+	}
+	ERR_FAIL_COND_V_MSG(!reader.ok, ERR_FILE_CORRUPT, "ExecuTorch program is truncated or malformed.");
+
+	// Every index the executor will follow must land in the value and operator tables
+	for (const ExecuTorchInstructionInfo &instruction : r_graph.instructions) {
+		ERR_FAIL_COND_V_MSG(instruction.type == ExecuTorchInstructionInfo::TYPE_KERNEL && (instruction.op_index < 0 || instruction.op_index >= r_graph.operators.size()),
+				ERR_FILE_CORRUPT, "Kernel call refers to an unknown operator.");
+		for (int32_t arg : instruction.args) {
+			ERR_FAIL_COND_V_MSG(arg < 0 || arg >= r_graph.values.size(), ERR_FILE_CORRUPT, "Instruction refers to an unknown value.");
+		}
+	}
+	for (int k = 0; k < 2; k++) {
+		for (int32_t index : *io[k]) {
+			ERR_FAIL_COND_V_MSG(index < 0 || index >= r_graph.values.size(), ERR_FILE_CORRUPT, "Method input or output refers to an unknown value.");
+		}
+	}
+	return OK;
+}
@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  executorch_pte_parser.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+#include "core/templates/vector.h"
+#include "core/variant/dictionary.h"
+#include "executorch_tensor.h"
+#include <cstdint>
+
+enum class ExecuTorchShapeDynamism : int8_t {
+	STATIC = 0,
+	DYNAMIC_BOUND = 1, // Sizes are upper bounds
+	DYNAMIC_UNBOUND = 2 // Sizes come from the export example input
+};
+
+struct ExecuTorchTensorInfo {
+	String name;
+	ExecuTorchScalarType dtype = ExecuTorchScalarType::FLOAT32;
+	Vector<int64_t> shape;
+	Vector<uint8_t> dim_order;
+	ExecuTorchShapeDynamism dynamism = ExecuTorchShapeDynamism::STATIC;
+
+	// Memory planning: arena id (-1 when not planned) and byte offset in it
+	int32_t memory_id = -1;
+	uint64_t memory_offset = 0;
+
+	int64_t get_element_count() const;
+	int64_t get_byte_size() const { return get_element_count() * ExecuTorchTensor::get_element_size(dtype); }
+	bool is_dynamic() const { return dynamism != ExecuTorchShapeDynamism::STATIC; }
+	Dictionary to_dictionary() const;
+};
+
+struct ExecuTorchMethodInfo {
+	String name;
+	Vector<ExecuTorchTensorInfo> inputs;
+	Vector<ExecuTorchTensorInfo> outputs;
+	Vector<String> operators;
+	Vector<String> delegates;
+	// Planned arena sizes; index 0 is reserved by ExecuTorch and always 0
+	Vector<int64_t> non_const_buffer_sizes;
+};
+
+struct ExecuTorchProgramInfo {
+	uint32_t version = 0;
+	Vector<ExecuTorchMethodInfo> methods;
+
+	// Extended header ("eh00"), zero when absent
+	uint64_t program_size = 0;
+	uint64_t segment_base_offset = 0;
+
+	const ExecuTorchMethodInfo *find_method(const String &name) const;
+};
+
+// One entry of an execution plan's value table
+struct ExecuTorchValueInfo {
+	enum Type {
+		TYPE_NULL,
+		TYPE_INT,
+		TYPE_BOOL,
+		TYPE_DOUBLE,
+		TYPE_TENSOR,
+		TYPE_INT_LIST,
+		TYPE_OTHER // Strings, other lists; carried but not decoded
+	};
+
+	Type type = TYPE_NULL;
+	int64_t int_value = 0; // Int and Bool
+	double double_value = 0.0;
+	Vector<int64_t> int_list;
+	ExecuTorchTensorInfo tensor;
+	// Constant tensors: absolute offset of their data in the program buffer, -1 otherwise
+	int64_t data_offset = -1;
+};
+
+struct ExecuTorchInstructionInfo {
+	enum Type {
+		TYPE_KERNEL = 1,
+		TYPE_DELEGATE = 2,
+		TYPE_MOVE = 3,
+		TYPE_JUMP_FALSE = 4,
+		TYPE_FREE = 5
+	};
+
+	Type type = TYPE_KERNEL;
+	int32_t op_index = -1; // Kernel calls: index into operators
+	Vector<int32_t> args; // Value indices, the outputs last
+};
+
+// The operator graph of one method, as the runtime would walk it
+struct ExecuTorchMethodGraph {
+	Vector<String> operators;
+	Vector<ExecuTorchValueInfo> values;
+	Vector<int32_t> inputs;
+	Vector<int32_t> outputs;
+	Vector<ExecuTorchInstructionInfo> instructions; // First chain only
+	int chain_count = 0;
+	int delegate_count = 0;
+};
+
+/**
+ * ExecuTorchPTEParser - Reads method signatures from a .pte program
+ *
+ * Walks the program flatbuffer directly (no flatbuffers dependency) with
+ * bounds checks on every read, so truncated or foreign buffers fail
+ * cleanly instead of reading out of range.
+ *
+ * parse_graph() goes further and decodes one method's values, constant
+ * data locations and instructions for ExecuTorchNativeExecutor.
+ */
+class ExecuTorchPTEParser {
+public:
+	static bool has_program_identifier(const uint8_t *data, size_t size);
+	static Error parse(const uint8_t *data, size_t size, ExecuTorchProgramInfo &r_info);
+	static Error parse_graph(const uint8_t *data, size_t size, const String &method_name, ExecuTorchMethodGraph &r_graph);
+};
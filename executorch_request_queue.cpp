@@ -0,0 +1,390 @@
+/**************************************************************************/
+/*  executorch_request_queue.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "executorch_request_queue.h"
+#include "executorch_runtime.h"
+
+#include "core/os/thread.h"
+
+#include <chrono>
+#include <thread>
+
+void ExecuTorchIndexRing::reserve(size_t capacity) {
+	size_t size = 1;
+	while (size < capacity) {
+		size <<= 1;
+	}
+	cells_.reset(new Cell[size]);
+	for (size_t i = 0; i < size; i++) {
+		cells_[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	mask_ = size - 1;
+	enqueue_pos_.store(0, std::memory_order_relaxed);
+	dequeue_pos_.store(0, std::memory_order_relaxed);
+}
+
+bool ExecuTorchIndexRing::push(uint32_t value) {
+	size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+	for (;;) {
+		Cell &cell = cells_[pos & mask_];
+		size_t sequence = cell.sequence.load(std::memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)pos;
+		if (difference == 0) {
+			if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				cell.value = value;
+				cell.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (difference < 0) {
+			return false; // Full
+		} else {
+			pos = enqueue_pos_.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool ExecuTorchIndexRing::pop(uint32_t &r_value) {
+	size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+	for (;;) {
+		Cell &cell = cells_[pos & mask_];
+		size_t sequence = cell.sequence.load(std::memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)(pos + 1);
+		if (difference == 0) {
+			if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				r_value = cell.value;
+				cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (difference < 0) {
+			return false; // Empty
+		} else {
+			pos = dequeue_pos_.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+ExecuTorchRequestQueue::ExecuTorchRequestQueue(size_t capacity, int workers) :
+		capacity_(capacity > 0 ? capacity : 1), slot_count_(0), stopping_(false), sleeping_(0), depth_(0), in_flight_(0), high_water_(0), submitted_(0), completed_(0), failed_(0), cancelled_(0), dropped_(0), blocked_(0), grown_(0) {
+	for (std::atomic<ExecuTorchRequest *> &chunk : chunks_) {
+		chunk.store(nullptr, std::memory_order_relaxed);
+	}
+
+	// Both rings can hold every slot the queue may ever have, so pushing an index never fails.
+	size_t max_slots = capacity_ << MAX_GROWTH;
+	free_.reserve(max_slots);
+	pending_.reserve(max_slots);
+
+	chunks_[0].store(new ExecuTorchRequest[capacity_], std::memory_order_release);
+	chunk_count_ = 1;
+	slot_count_.store(capacity_, std::memory_order_release);
+	for (size_t i = 0; i < capacity_; i++) {
+		free_.push((uint32_t)i);
+	}
+
+	int count = workers > 0 ? workers : 1;
+	for (int i = 0; i < count; i++) {
+		Thread *thread = memnew(Thread);
+		thread->start(&ExecuTorchRequestQueue::_worker_main, this);
+		workers_.push_back(thread);
+	}
+}
+
+ExecuTorchRequestQueue::~ExecuTorchRequestQueue() {
+	stopping_.store(true);
+	{
+		std::lock_guard<std::mutex> lock(wake_mutex_);
+		wake_condition_.notify_all();
+	}
+	for (Thread *thread : workers_) {
+		thread->wait_to_finish();
+		memdelete(thread);
+	}
+	workers_.clear();
+
+	for (std::atomic<ExecuTorchRequest *> &chunk : chunks_) {
+		delete[] chunk.load(std::memory_order_acquire);
+	}
+}
+
+std::shared_ptr<ExecuTorchRequestQueue> ExecuTorchRequestQueue::acquire(const std::shared_ptr<ExecuTorchRuntime> &runtime) {
+	struct Entry {
+		const ExecuTorchRuntime *key;
+		std::weak_ptr<ExecuTorchRuntime> runtime;
+		std::weak_ptr<ExecuTorchRequestQueue> queue;
+	};
+	static std::mutex mutex;
+	static std::vector<Entry> entries;
+	std::lock_guard<std::mutex> lock(mutex);
+
+	// The runtime is checked too, so a new runtime at a freed one's address gets its own queue
+	for (size_t i = 0; i < entries.size();) {
+		std::shared_ptr<ExecuTorchRequestQueue> queue = entries[i].queue.lock();
+		if (!queue || (entries[i].key && entries[i].runtime.expired())) {
+			entries.erase(entries.begin() + i);
+			continue;
+		}
+		if (entries[i].key == runtime.get()) {
+			return queue;
+		}
+		i++;
+	}
+
+	// Without a runtime the queue takes the config defaults
+	ExecuTorchRuntimeConfig defaults;
+	size_t capacity = runtime ? runtime->get_request_queue_capacity() : defaults.request_queue_capacity;
+	int workers = runtime ? runtime->get_request_workers() : defaults.request_workers;
+	std::shared_ptr<ExecuTorchRequestQueue> queue = std::make_shared<ExecuTorchRequestQueue>(capacity, workers);
+	entries.push_back({ runtime.get(), runtime, queue });
+	return queue;
+}
+
+ExecuTorchRequest &ExecuTorchRequestQueue::_slot(uint32_t index) const {
+	if (index < capacity_) {
+		return chunks_[0].load(std::memory_order_acquire)[index];
+	}
+	size_t multiple = index / capacity_;
+	int chunk = 0;
+	while (multiple >> chunk) {
+		chunk++;
+	}
+	return chunks_[chunk].load(std::memory_order_acquire)[index - (capacity_ << (chunk - 1))];
+}
+
+ExecuTorchRequest *ExecuTorchRequestQueue::_find(int64_t ticket) const {
+	if (ticket < 0 || (uint64_t)(ticket & 0xFFFFFFFF) >= slot_count_.load(std::memory_order_acquire)) {
+		return nullptr;
+	}
+	ExecuTorchRequest &request = _slot((uint32_t)(ticket & 0xFFFFFFFF));
+	uint32_t state = request.state.load(std::memory_order_acquire);
+	if (request.generation.load(std::memory_order_relaxed) != (uint32_t)(ticket >> 32) || state == ExecuTorchRequest::STATE_FREE || state == ExecuTorchRequest::STATE_ABANDONED) {
+		return nullptr;
+	}
+	return &request;
+}
+
+int64_t ExecuTorchRequestQueue::submit(const Ref<ExecuTorchResource> &model, const ExecuTorchTensor *inputs, size_t input_count, OverflowPolicy policy) {
+	uint32_t index = 0;
+	if (!free_.pop(index)) {
+		bool claimed = false;
+		if (policy == OVERFLOW_DROP) {
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return INVALID_TICKET;
+		}
+		if (policy == OVERFLOW_GROW) {
+			claimed = _grow(index);
+		}
+		if (!claimed) {
+			blocked_.fetch_add(1, std::memory_order_relaxed);
+			int spins = 0;
+			while (!free_.pop(index)) {
+				_backoff(spins);
+			}
+		}
+	}
+
+	ExecuTorchRequest &request = _slot(index);
+	request.model = model;
+	request.inputs.assign(inputs, inputs + input_count);
+	request.error = OK;
+	uint32_t generation = (request.generation.load(std::memory_order_relaxed) + 1) & 0x7FFFFFFF;
+	request.generation.store(generation, std::memory_order_relaxed);
+	request.state.store(ExecuTorchRequest::STATE_PENDING, std::memory_order_release);
+	in_flight_.fetch_add(1, std::memory_order_relaxed);
+	submitted_.fetch_add(1, std::memory_order_relaxed);
+
+	int64_t depth = depth_.fetch_add(1) + 1;
+	size_t high_water = high_water_.load(std::memory_order_relaxed);
+	while (depth > (int64_t)high_water && !high_water_.compare_exchange_weak(high_water, (size_t)depth, std::memory_order_relaxed)) {
+	}
+	pending_.push(index);
+	_wake_worker();
+
+	return ((int64_t)generation << 32) | index;
+}
+
+bool ExecuTorchRequestQueue::is_done(int64_t ticket) const {
+	ExecuTorchRequest *request = _find(ticket);
+	return request && request->state.load(std::memory_order_acquire) == ExecuTorchRequest::STATE_DONE;
+}
+
+Error ExecuTorchRequestQueue::take(int64_t ticket, std::vector<ExecuTorchTensor> &r_outputs) {
+	ExecuTorchRequest *request = _find(ticket);
+	ERR_FAIL_NULL_V_MSG(request, ERR_INVALID_PARAMETER, "Unknown, taken or cancelled request ticket.");
+
+	int spins = 0;
+	while (request->state.load(std::memory_order_acquire) != ExecuTorchRequest::STATE_DONE) {
+		_backoff(spins);
+	}
+
+	// The slot gets the caller's old vector, so both sides keep their capacity.
+	r_outputs.swap(request->outputs);
+	Error err = request->error;
+	_recycle((uint32_t)(ticket & 0xFFFFFFFF), *request);
+	return err;
+}
+
+void ExecuTorchRequestQueue::cancel(int64_t ticket) {
+	ExecuTorchRequest *request = _find(ticket);
+	ERR_FAIL_NULL_MSG(request, "Unknown, taken or cancelled request ticket.");
+
+	cancelled_.fetch_add(1, std::memory_order_relaxed);
+	uint32_t state = request->state.load(std::memory_order_acquire);
+	for (;;) {
+		if (state == ExecuTorchRequest::STATE_DONE) {
+			_recycle((uint32_t)(ticket & 0xFFFFFFFF), *request);
+			return;
+		}
+		// A worker that finds the request abandoned recycles it
+		if (request->state.compare_exchange_weak(state, ExecuTorchRequest::STATE_ABANDONED, std::memory_order_acq_rel)) {
+			return;
+		}
+	}
+}
+
+bool ExecuTorchRequestQueue::_grow(uint32_t &r_index) {
+	std::lock_guard<std::mutex> lock(grow_mutex_);
+	// Another thread may have grown or freed a slot while this one waited
+	if (free_.pop(r_index)) {
+		return true;
+	}
+	if (chunk_count_ > MAX_GROWTH) {
+		return false;
+	}
+
+	size_t first = slot_count_.load(std::memory_order_relaxed);
+	size_t size = capacity_ << (chunk_count_ - 1);
+	chunks_[chunk_count_].store(new ExecuTorchRequest[size], std::memory_order_release);
+	chunk_count_++;
+	slot_count_.store(first + size, std::memory_order_release);
+	for (size_t i = 1; i < size; i++) {
+		free_.push((uint32_t)(first + i));
+	}
+	grown_.fetch_add(1, std::memory_order_relaxed);
+	r_index = (uint32_t)first;
+	return true;
+}
+
+void ExecuTorchRequestQueue::_recycle(uint32_t index, ExecuTorchRequest &request) {
+	request.model.unref();
+	request.inputs.clear();
+	request.outputs.clear();
+	request.state.store(ExecuTorchRequest::STATE_FREE, std::memory_order_relaxed);
+	in_flight_.fetch_sub(1, std::memory_order_relaxed);
+	free_.push(index);
+}
+
+void ExecuTorchRequestQueue::_run(uint32_t index) {
+	ExecuTorchRequest &request = _slot(index);
+	uint32_t expected = ExecuTorchRequest::STATE_PENDING;
+	if (!request.state.compare_exchange_strong(expected, ExecuTorchRequest::STATE_RUNNING, std::memory_order_acq_rel)) {
+		_recycle(index, request); // Cancelled before it started
+		return;
+	}
+
+	request.error = request.model.is_valid() ? request.model->forward_tensors(request.inputs, request.outputs) : ERR_UNCONFIGURED;
+	completed_.fetch_add(1, std::memory_order_relaxed);
+	if (request.error != OK) {
+		failed_.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	expected = ExecuTorchRequest::STATE_RUNNING;
+	if (!request.state.compare_exchange_strong(expected, ExecuTorchRequest::STATE_DONE, std::memory_order_acq_rel)) {
+		_recycle(index, request); // Cancelled while running
+	}
+}
+
+void ExecuTorchRequestQueue::_wake_worker() {
+	// Pairs with the sleeping_ increment in _worker_main: either the worker
+	// sees the new depth before it sleeps or this sees it sleeping.
+	if (sleeping_.load() > 0) {
+		std::lock_guard<std::mutex> lock(wake_mutex_);
+		wake_condition_.notify_one();
+	}
+}
+
+void ExecuTorchRequestQueue::_backoff(int &r_spins) {
+	if (r_spins < 64) {
+		r_spins++;
+		std::this_thread::yield();
+	} else {
+		std::this_thread::sleep_for(std::chrono::microseconds(50));
+	}
+}
+
+void ExecuTorchRequestQueue::_worker_main(void *p_userdata) {
+	ExecuTorchRequestQueue *queue = static_cast<ExecuTorchRequestQueue *>(p_userdata);
+	Thread::set_name("ExecuTorch Request Worker");
+
+	int idle_spins = 0;
+	for (;;) {
+		uint32_t index = 0;
+		if (queue->pending_.pop(index)) {
+			queue->depth_.fetch_sub(1, std::memory_order_relaxed);
+			queue->_run(index);
+			idle_spins = 0;
+			continue;
+		}
+		if (queue->stopping_.load()) {
+			return;
+		}
+		// A depth that is up but not yet poppable means a push is a few instructions away.
+		if (idle_spins < 64 || queue->depth_.load() > 0) {
+			idle_spins++;
+			std::this_thread::yield();
+			continue;
+		}
+
+		queue->sleeping_.fetch_add(1);
+		{
+			std::unique_lock<std::mutex> lock(queue->wake_mutex_);
+			queue->wake_condition_.wait(lock, [queue]() { return queue->stopping_.load() || queue->depth_.load() > 0; });
+		}
+		queue->sleeping_.fetch_sub(1);
+		idle_spins = 0;
+	}
+}
+
+ExecuTorchRequestQueue::Stats ExecuTorchRequestQueue::get_stats() const {
+	Stats stats;
+	stats.capacity = slot_count_.load();
+	int64_t depth = depth_.load();
+	stats.depth = depth > 0 ? (size_t)depth : 0;
+	stats.in_flight = in_flight_.load();
+	stats.high_water = high_water_.load();
+	stats.submitted = submitted_.load();
+	stats.completed = completed_.load();
+	stats.failed = failed_.load();
+	stats.cancelled = cancelled_.load();
+	stats.dropped = dropped_.load();
+	stats.blocked = blocked_.load();
+	stats.grown = grown_.load();
+	stats.workers = (int)workers_.size();
+	return stats;
+}
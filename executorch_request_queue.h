@@ -0,0 +1,186 @@
+/**************************************************************************/
+/*  executorch_request_queue.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "executorch_resource.h"
+#include "executorch_tensor.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ExecuTorchRuntime;
+class Thread;
+
+// Bounded multi-producer, multi-consumer ring of slot indices (Vyukov's
+// sequence-numbered cells). push() and pop() are one CAS on the uncontended
+// path and never allocate; a full ring fails the push instead of waiting.
+class ExecuTorchIndexRing {
+private:
+	struct Cell {
+		std::atomic<size_t> sequence;
+		uint32_t value;
+	};
+
+	std::unique_ptr<Cell[]> cells_;
+	size_t mask_ = 0;
+	alignas(64) std::atomic<size_t> enqueue_pos_;
+	alignas(64) std::atomic<size_t> dequeue_pos_;
+
+public:
+	ExecuTorchIndexRing() :
+			enqueue_pos_(0), dequeue_pos_(0) {}
+	ExecuTorchIndexRing(const ExecuTorchIndexRing &) = delete;
+	ExecuTorchIndexRing &operator=(const ExecuTorchIndexRing &) = delete;
+
+	// Rounds up to a power of two; not thread safe, call before sharing the ring
+	void reserve(size_t capacity);
+	size_t get_capacity() const { return mask_ + 1; }
+
+	bool push(uint32_t value);
+	bool pop(uint32_t &r_value);
+};
+
+// One preallocated request. The vectors keep their capacity between uses, so
+// a slot that has run once submits without touching the heap.
+struct alignas(64) ExecuTorchRequest {
+	enum State : uint32_t {
+		STATE_FREE,
+		STATE_PENDING, // Waiting for a worker
+		STATE_RUNNING,
+		STATE_DONE, // Outputs ready for take()
+		STATE_ABANDONED // Cancelled; whoever sees it next recycles the slot
+	};
+
+	std::atomic<uint32_t> state{ STATE_FREE };
+	std::atomic<uint32_t> generation{ 0 }; // Bumped per use so stale tickets are rejected
+	Ref<ExecuTorchResource> model;
+	std::vector<ExecuTorchTensor> inputs;
+	std::vector<ExecuTorchTensor> outputs;
+	Error error = OK;
+};
+
+// Hands inference requests from game threads to a set of worker threads.
+// Submitting claims a free slot and publishes its index through a lock-free
+// ring; tensor handles are copied into the slot, never their data. Tickets
+// pack the slot index with its generation and belong to the thread that
+// submitted them until take() or cancel().
+class ExecuTorchRequestQueue {
+public:
+	enum OverflowPolicy {
+		OVERFLOW_DROP, // Fail the submit and count it
+		OVERFLOW_BLOCK, // Wait for a slot to be taken or cancelled
+		OVERFLOW_GROW // Add slots, up to capacity << MAX_GROWTH, then block
+	};
+
+	struct Stats {
+		size_t capacity = 0; // Slots allocated so far
+		size_t depth = 0; // Requests waiting for a worker
+		size_t in_flight = 0; // Slots submitted and not yet taken or recycled
+		size_t high_water = 0; // Deepest the queue has been
+		uint64_t submitted = 0;
+		uint64_t completed = 0;
+		uint64_t failed = 0;
+		uint64_t cancelled = 0;
+		uint64_t dropped = 0;
+		uint64_t blocked = 0; // Submits that had to wait for a slot
+		uint64_t grown = 0;
+		int workers = 0;
+	};
+
+	static constexpr int64_t INVALID_TICKET = -1;
+	static constexpr int MAX_GROWTH = 4; // Each growth doubles the slot count
+
+private:
+	// Chunk 0 holds capacity_ slots and chunk k capacity_ << (k - 1), so an
+	// index maps to its chunk without a lock and slots never move.
+	size_t capacity_;
+	std::atomic<ExecuTorchRequest *> chunks_[MAX_GROWTH + 1];
+	int chunk_count_ = 0; // Guarded by grow_mutex_
+	std::atomic<size_t> slot_count_;
+	std::mutex grow_mutex_;
+
+	ExecuTorchIndexRing free_;
+	ExecuTorchIndexRing pending_;
+
+	std::vector<Thread *> workers_;
+	std::atomic<bool> stopping_;
+	std::atomic<int> sleeping_;
+	std::mutex wake_mutex_;
+	std::condition_variable wake_condition_;
+
+	std::atomic<int64_t> depth_;
+	std::atomic<size_t> in_flight_;
+	std::atomic<size_t> high_water_;
+	std::atomic<uint64_t> submitted_;
+	std::atomic<uint64_t> completed_;
+	std::atomic<uint64_t> failed_;
+	std::atomic<uint64_t> cancelled_;
+	std::atomic<uint64_t> dropped_;
+	std::atomic<uint64_t> blocked_;
+	std::atomic<uint64_t> grown_;
+
+	ExecuTorchRequest &_slot(uint32_t index) const;
+	ExecuTorchRequest *_find(int64_t ticket) const;
+	bool _grow(uint32_t &r_index);
+	void _recycle(uint32_t index, ExecuTorchRequest &request);
+	void _run(uint32_t index);
+	void _wake_worker();
+	static void _backoff(int &r_spins);
+	static void _worker_main(void *p_userdata);
+
+public:
+	ExecuTorchRequestQueue(size_t capacity, int workers);
+	ExecuTorchRequestQueue(const ExecuTorchRequestQueue &) = delete;
+	ExecuTorchRequestQueue &operator=(const ExecuTorchRequestQueue &) = delete;
+	// Workers finish whatever is pending before they exit
+	~ExecuTorchRequestQueue();
+
+	// One queue per runtime, sized from its request_queue_capacity and
+	// request_workers; lives as long as anything holds it
+	static std::shared_ptr<ExecuTorchRequestQueue> acquire(const std::shared_ptr<ExecuTorchRuntime> &runtime);
+
+	// INVALID_TICKET when the request was dropped. A blocking submit waits for
+	// another thread to take or cancel a request: a thread that holds every
+	// slot itself and blocks never wakes up.
+	int64_t submit(const Ref<ExecuTorchResource> &model, const ExecuTorchTensor *inputs, size_t input_count, OverflowPolicy policy = OVERFLOW_BLOCK);
+	bool is_done(int64_t ticket) const;
+	// Waits for the request, hands back its outputs (model dtypes) and frees the slot
+	Error take(int64_t ticket, std::vector<ExecuTorchTensor> &r_outputs);
+	// Frees the slot without waiting; a request already running finishes first
+	void cancel(int64_t ticket);
+
+	Stats get_stats() const;
+};
@@ -29,22 +29,204 @@
 /**************************************************************************/
 
 #include "executorch_resource.h"
+#include "executorch_container.h"
+#include "executorch_kernels.h"
+#include "executorch_prepared_cache.h"
 #include "core/error/error_macros.h"
 #include "core/io/file_access.h"
+#include "core/object/class_db.h"
 #include "core/os/time.h"
+#include <cstring>
 #include <memory>
+#include <string>
+#include <thread>
+
+// Large enough to keep the disk busy, small enough that progress and cancel stay responsive
+static const uint64_t LOAD_CHUNK_SIZE = 8 * 1024 * 1024;
+
+#ifdef TESTS_ENABLED
+static std::atomic<bool> mock_gate_closed(false);
+#endif
+
+struct ExecuTorchResource::SwapTask {
+	ExecuTorchResource *resource = nullptr;
+	PackedByteArray data;
+	uint64_t generation = 0;
+};
+
+ExecuTorchProgram::ExecuTorchProgram() {
+}
+
+ExecuTorchProgram::~ExecuTorchProgram() {
+	// The evictor touches the caches below, which are destroyed before the account
+	if (memory) {
+		memory->detach();
+	}
+	if (module) {
+		module->unload();
+	}
+}
+
+size_t ExecuTorchProgram::try_unload() {
+	if (active_calls.load() != 0 || !memory) {
+		return 0;
+	}
+	int expected = RESIDENCY_RESIDENT;
+	if (!residency.compare_exchange_strong(expected, RESIDENCY_EVICTING)) {
+		return 0;
+	}
+	// A call that started between the two checks sees EVICTING and waits for us
+	if (active_calls.load() != 0) {
+		residency = RESIDENCY_RESIDENT;
+		return 0;
+	}
+
+	size_t before = memory->get_total_usage();
+	{
+		MutexLock lock(plan_mutex);
+		plans.clear();
+	}
+	{
+		MutexLock lock(result_mutex);
+		result_evictions += results.get_size();
+		results.clear();
+	}
+	if (module) {
+		module->unload();
+		module.reset();
+	}
+	// model_data still holds the bytes, so their charge stays; a reload reuses it
+	activations_charge.reset();
+	size_t after = memory->get_total_usage();
+
+	unloads++;
+	residency = RESIDENCY_EVICTED;
+	return before > after ? before - after : 0;
+}
 
 ExecuTorchResource::ExecuTorchResource() :
-		is_loaded_(false), memory_policy_(MEMORY_POLICY_AUTO), optimization_level_(OPTIMIZATION_BASIC), memory_limit_bytes_(0), enable_profiling_(false), last_inference_time_ms_(0.0), total_inferences_(0) {
+		next_generation_(1), swap_task_id_(WorkerThreadPool::INVALID_TASK_ID), memory_policy_(MEMORY_POLICY_AUTO), optimization_level_(OPTIMIZATION_BASIC), memory_limit_bytes_(0), enable_profiling_(false), output_type_(TENSOR_TYPE_FLOAT32), output_scale_(1.0f), output_zero_point_(0), plan_cache_capacity_(16), runtime_name_(ExecuTorchRuntimeRegistry::DEFAULT_RUNTIME), memory_budget_(0), memory_budget_policy_(MEMORY_BUDGET_REJECT), result_cache_capacity_(0), warmup_on_load_(true), native_executor_enabled_(true), load_progress_(0.0f), load_cancel_requested_(false), last_inference_time_ms_(0.0), total_inferences_(0) {
 	print_line("ExecuTorchResource created");
 }
 
 ExecuTorchResource::~ExecuTorchResource() {
+	// clear() also waits for a pending swap task, which holds a raw pointer to us.
 	clear();
 }
 
+void ExecuTorchResource::_bind_methods() {
+	// Resource interface
+	ClassDB::bind_method(D_METHOD("load_from_file", "path"), &ExecuTorchResource::load_from_file);
+	ClassDB::bind_method(D_METHOD("get_load_progress"), &ExecuTorchResource::get_load_progress);
+	ClassDB::bind_method(D_METHOD("cancel_load"), &ExecuTorchResource::cancel_load);
+	ClassDB::bind_method(D_METHOD("save_to_file", "path"), &ExecuTorchResource::save_to_file);
+	ClassDB::bind_method(D_METHOD("clear"), &ExecuTorchResource::clear);
+
+	// High-level API
+	ClassDB::bind_method(D_METHOD("forward", "inputs"), &ExecuTorchResource::forward);
+	ClassDB::bind_method(D_METHOD("forward_array", "input_data"), &ExecuTorchResource::forward_array);
+	ClassDB::bind_method(D_METHOD("warmup", "iterations"), &ExecuTorchResource::warmup, DEFVAL(3));
+	ClassDB::bind_method(D_METHOD("set_warmup_on_load", "enable"), &ExecuTorchResource::set_warmup_on_load);
+	ClassDB::bind_method(D_METHOD("get_warmup_on_load"), &ExecuTorchResource::get_warmup_on_load);
+	ClassDB::bind_method(D_METHOD("set_native_executor_enabled", "enable"), &ExecuTorchResource::set_native_executor_enabled);
+	ClassDB::bind_method(D_METHOD("is_native_executor_enabled"), &ExecuTorchResource::is_native_executor_enabled);
+	ClassDB::bind_method(D_METHOD("save_prepared_state"), &ExecuTorchResource::save_prepared_state);
+
+	// Low-level API
+	ClassDB::bind_method(D_METHOD("configure_memory", "policy", "limit_bytes"), &ExecuTorchResource::configure_memory, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("set_optimization_level", "level"), &ExecuTorchResource::set_optimization_level);
+	ClassDB::bind_method(D_METHOD("enable_profiling", "enable"), &ExecuTorchResource::enable_profiling);
+	ClassDB::bind_method(D_METHOD("set_memory_budget", "bytes"), &ExecuTorchResource::set_memory_budget);
+	ClassDB::bind_method(D_METHOD("get_memory_budget"), &ExecuTorchResource::get_memory_budget);
+	ClassDB::bind_method(D_METHOD("set_memory_budget_policy", "policy"), &ExecuTorchResource::set_memory_budget_policy);
+	ClassDB::bind_method(D_METHOD("get_memory_budget_policy"), &ExecuTorchResource::get_memory_budget_policy);
+	ClassDB::bind_method(D_METHOD("set_runtime_name", "name"), &ExecuTorchResource::set_runtime_name);
+	ClassDB::bind_method(D_METHOD("get_runtime_name"), &ExecuTorchResource::get_runtime_name);
+
+	// Tensor types
+	ClassDB::bind_method(D_METHOD("set_output_type", "type"), &ExecuTorchResource::set_output_type);
+	ClassDB::bind_method(D_METHOD("get_output_type"), &ExecuTorchResource::get_output_type);
+	ClassDB::bind_method(D_METHOD("set_output_quantization", "scale", "zero_point"), &ExecuTorchResource::set_output_quantization);
+	ClassDB::bind_static_method("ExecuTorchResource", D_METHOD("encode_tensor", "values", "type", "scale", "zero_point"), &ExecuTorchResource::encode_tensor, DEFVAL(1.0), DEFVAL(0));
+	ClassDB::bind_static_method("ExecuTorchResource", D_METHOD("decode_tensor", "data", "type", "scale", "zero_point"), &ExecuTorchResource::decode_tensor, DEFVAL(1.0), DEFVAL(0));
+
+	// Model metadata
+	ClassDB::bind_method(D_METHOD("get_input_names"), &ExecuTorchResource::get_input_names);
+	ClassDB::bind_method(D_METHOD("get_output_names"), &ExecuTorchResource::get_output_names);
+	ClassDB::bind_method(D_METHOD("get_input_shapes"), &ExecuTorchResource::get_input_shapes);
+	ClassDB::bind_method(D_METHOD("get_output_shapes"), &ExecuTorchResource::get_output_shapes);
+	ClassDB::bind_method(D_METHOD("set_plan_cache_capacity", "capacity"), &ExecuTorchResource::set_plan_cache_capacity);
+	ClassDB::bind_method(D_METHOD("get_plan_cache_capacity"), &ExecuTorchResource::get_plan_cache_capacity);
+	ClassDB::bind_method(D_METHOD("get_plan_cache_stats"), &ExecuTorchResource::get_plan_cache_stats);
+	ClassDB::bind_method(D_METHOD("set_result_cache_capacity", "capacity"), &ExecuTorchResource::set_result_cache_capacity);
+	ClassDB::bind_method(D_METHOD("get_result_cache_capacity"), &ExecuTorchResource::get_result_cache_capacity);
+	ClassDB::bind_method(D_METHOD("get_result_cache_stats"), &ExecuTorchResource::get_result_cache_stats);
+	ClassDB::bind_method(D_METHOD("clear_result_cache"), &ExecuTorchResource::clear_result_cache);
+
+	ClassDB::bind_method(D_METHOD("get_input_info"), &ExecuTorchResource::get_input_info);
+	ClassDB::bind_method(D_METHOD("get_output_info"), &ExecuTorchResource::get_output_info);
+	ClassDB::bind_method(D_METHOD("get_model_name"), &ExecuTorchResource::get_model_name);
+	ClassDB::bind_method(D_METHOD("get_model_version"), &ExecuTorchResource::get_model_version);
+
+	// Status and diagnostics
+	ClassDB::bind_method(D_METHOD("is_loaded"), &ExecuTorchResource::is_loaded);
+	ClassDB::bind_method(D_METHOD("is_resident"), &ExecuTorchResource::is_resident);
+	ClassDB::bind_method(D_METHOD("get_model_size"), &ExecuTorchResource::get_model_size);
+	ClassDB::bind_method(D_METHOD("get_last_inference_time"), &ExecuTorchResource::get_last_inference_time);
+	ClassDB::bind_method(D_METHOD("get_total_inferences"), &ExecuTorchResource::get_total_inferences);
+	ClassDB::bind_method(D_METHOD("get_memory_info"), &ExecuTorchResource::get_memory_info);
+
+	// Data access
+	ClassDB::bind_method(D_METHOD("set_model_data", "data"), &ExecuTorchResource::set_model_data);
+	ClassDB::bind_method(D_METHOD("get_model_data"), &ExecuTorchResource::get_model_data);
+	ClassDB::bind_method(D_METHOD("get_source_file_path"), &ExecuTorchResource::get_source_file_path);
+
+	// Hot reload
+	ClassDB::bind_method(D_METHOD("swap_model_data", "data", "threaded"), &ExecuTorchResource::swap_model_data, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_swap_pending"), &ExecuTorchResource::is_swap_pending);
+	ClassDB::bind_method(D_METHOD("wait_for_swap"), &ExecuTorchResource::wait_for_swap);
+	ClassDB::bind_method(D_METHOD("get_model_generation"), &ExecuTorchResource::get_model_generation);
+
+	// Properties
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_BYTE_ARRAY, "model_data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_model_data", "get_model_data");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "warmup_on_load"), "set_warmup_on_load", "get_warmup_on_load");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "native_executor"), "set_native_executor_enabled", "is_native_executor_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "output_type", PROPERTY_HINT_ENUM, "UInt8:0,Int8:1,Int16:2,Int32:3,Int64:4,Float16:5,Float32:6,Float64:7,Bool:11,BFloat16:15"), "set_output_type", "get_output_type");
+
+	// Signals
+	ADD_SIGNAL(MethodInfo("model_swapped", PropertyInfo(Variant::INT, "generation"), PropertyInfo(Variant::INT, "result")));
+
+	BIND_ENUM_CONSTANT(MEMORY_POLICY_AUTO);
+	BIND_ENUM_CONSTANT(MEMORY_POLICY_STATIC);
+	BIND_ENUM_CONSTANT(MEMORY_POLICY_CUSTOM);
+
+	BIND_ENUM_CONSTANT(MEMORY_BUDGET_REJECT);
+	BIND_ENUM_CONSTANT(MEMORY_BUDGET_EVICT);
+
+	BIND_ENUM_CONSTANT(OPTIMIZATION_NONE);
+	BIND_ENUM_CONSTANT(OPTIMIZATION_BASIC);
+	BIND_ENUM_CONSTANT(OPTIMIZATION_AGGRESSIVE);
+
+	BIND_ENUM_CONSTANT(TENSOR_TYPE_UINT8);
+	BIND_ENUM_CONSTANT(TENSOR_TYPE_INT8);
+	BIND_ENUM_CONSTANT(TENSOR_TYPE_INT16);
+	BIND_ENUM_CONSTANT(TENSOR_TYPE_INT32);
+	BIND_ENUM_CONSTANT(TENSOR_TYPE_INT64);
+	BIND_ENUM_CONSTANT(TENSOR_TYPE_FLOAT16);
+	BIND_ENUM_CONSTANT(TENSOR_TYPE_FLOAT32);
+	BIND_ENUM_CONSTANT(TENSOR_TYPE_FLOAT64);
+	BIND_ENUM_CONSTANT(TENSOR_TYPE_BOOL);
+	BIND_ENUM_CONSTANT(TENSOR_TYPE_BFLOAT16);
+}
+
 Error ExecuTorchResource::load_from_file(const String &path) {
+	return stream_from_file(path);
+}
+
+Error ExecuTorchResource::stream_from_file(const String &path, float *r_progress) {
 	print_line("Loading ExecuTorch model from: " + path);
+	load_cancel_requested_ = false;
+	load_progress_ = 0.0f;
 
 	Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
 	if (file.is_null()) {
@@ -52,30 +234,85 @@ Error ExecuTorchResource::load_from_file(const String &path) {
 		return FAILED;
 	}
 
-	uint64_t size = file->get_length();
-	model_data_.resize(size);
-	uint64_t bytes_read = file->get_buffer(model_data_.ptrw(), size);
+	// .ptez containers carry their uncompressed size in the header
+	ExecuTorchContainer::Header container;
+	bool compressed = ExecuTorchContainer::is_container(file);
+	if (compressed) {
+		Error err = ExecuTorchContainer::read_header(file, container);
+		if (err != OK) {
+			print_error("Invalid compressed model: " + path);
+			return err;
+		}
+	}
 
-	if (bytes_read != size) {
-		print_error("Failed to read file data");
-		return FAILED;
+	// Reject before reading gigabytes that could never be charged
+	uint64_t size = compressed ? container.uncompressed_size : file->get_length();
+	int64_t budget = memory_budget_.load();
+	if (budget > 0 && size > (uint64_t)budget) {
+		print_error("Model of " + itos(size) + " bytes exceeds the memory budget");
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	source_file_path_ = path;
+	// Reading is most of the work; the last tenth covers building the program
+	auto report_progress = [&](float fraction) {
+		float progress = 0.9f * fraction;
+		load_progress_ = progress;
+		if (r_progress) {
+			*r_progress = progress;
+		}
+		return !load_cancel_requested_.load();
+	};
+
+	// The buffer read into is the one the program keeps, so the only large
+	// allocation is the model itself; a cancel takes effect within one chunk.
+	PackedByteArray data;
+	ERR_FAIL_COND_V_MSG(data.resize(size) != OK, ERR_OUT_OF_MEMORY, "Cannot allocate " + itos(size) + " bytes for " + path);
+	uint8_t *dst = data.ptrw();
+	Error read_result = OK;
+	if (compressed) {
+		// Compressed chunks decompress in parallel straight into place
+		read_result = ExecuTorchContainer::read_chunks(file, container, dst, report_progress);
+	} else {
+		for (uint64_t offset = 0; offset < size && read_result == OK;) {
+			uint64_t chunk = MIN(LOAD_CHUNK_SIZE, size - offset);
+			if (file->get_buffer(dst + offset, chunk) != chunk) {
+				read_result = FAILED;
+				break;
+			}
+			offset += chunk;
+			if (!report_progress((float)offset / size)) {
+				read_result = ERR_SKIP;
+			}
+		}
+	}
+	file.unref();
 
-	Error result = _load_with_high_level_api();
+	if (read_result == ERR_SKIP) {
+		print_line("Model load cancelled: " + path);
+		load_progress_ = 0.0f;
+		return ERR_SKIP;
+	}
+	if (read_result != OK) {
+		print_error("Failed to read file data");
+		return read_result;
+	}
+
+	std::shared_ptr<ExecuTorchProgram> program;
+	Error result = _build_program(data, next_generation_++, program);
 	if (result != OK) {
-		print_line("High-level API failed, trying low-level API...");
-		result = _load_with_low_level_api();
+		return result;
 	}
 
-	if (result == OK) {
-		_extract_metadata();
-		is_loaded_ = true;
-		print_line("Model loaded successfully (" + itos(model_data_.size()) + " bytes)");
+	model_data_ = data;
+	source_file_path_ = path;
+	_publish_program(program);
+	load_progress_ = 1.0f;
+	if (r_progress) {
+		*r_progress = 1.0f;
 	}
+	print_line("Model loaded successfully (" + itos(model_data_.size()) + " bytes)");
 
-	return result;
+	return OK;
 }
 
 Error ExecuTorchResource::save_to_file(const String &path) {
@@ -90,29 +327,29 @@ Error ExecuTorchResource::save_to_file(const String &path) {
 		return FAILED;
 	}
 
-	file->store_buffer(model_data_.ptr(), model_data_.size());
+	if (path.get_extension().to_lower() == "ptez") {
+		Error err = ExecuTorchContainer::write(file, model_data_.ptr(), model_data_.size());
+		if (err != OK) {
+			print_error("Failed to write compressed model: " + path);
+			return err;
+		}
+	} else {
+		file->store_buffer(model_data_.ptr(), model_data_.size());
+	}
 
 	print_line("Model saved to: " + path);
 	return OK;
 }
 
 void ExecuTorchResource::clear() {
-	if (module_) {
-		module_->unload();
-		module_.reset();
-	}
+	wait_for_swap();
+
+	// In-flight calls keep their own reference; the program is freed after them.
+	std::atomic_store(&program_, std::shared_ptr<ExecuTorchProgram>());
 
 	memory_manager_.reset();
 	model_data_.clear();
 	source_file_path_.clear();
-	is_loaded_ = false;
-
-	input_names_.clear();
-	output_names_.clear();
-	input_shapes_.clear();
-	output_shapes_.clear();
-	model_name_.clear();
-	model_version_.clear();
 
 	last_inference_time_ms_ = 0.0;
 	total_inferences_ = 0;
@@ -121,21 +358,84 @@ void ExecuTorchResource::clear() {
 }
 
 Dictionary ExecuTorchResource::forward(const Dictionary &inputs) {
-	ERR_FAIL_COND_V_MSG(!is_loaded_ || !module_, Dictionary(), "Model not loaded. Please load a model before inference.");
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	ERR_FAIL_COND_V_MSG(!program, Dictionary(), "Model not loaded. Please load a model before inference.");
+
+	ExecuTorchProgramUse use(*program);
+	std::vector<ExecuTorchTensor> input_tensors;
+	Error err = _convert_dictionary_to_tensors(inputs, *program, input_tensors);
+	ERR_FAIL_COND_V_MSG(err != OK, Dictionary(), "Failed to convert inference inputs.");
+
+	std::vector<ExecuTorchTensor> output_tensors;
+	err = _forward_program(*program, input_tensors, output_tensors);
+	if (err != OK) {
+		return Dictionary();
+	}
+	return _convert_tensors_to_dictionary(output_tensors, program->output_names);
+}
+
+Error ExecuTorchResource::forward_tensors(const std::vector<ExecuTorchTensor> &inputs, std::vector<ExecuTorchTensor> &r_outputs) {
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	ERR_FAIL_COND_V_MSG(!program, ERR_UNCONFIGURED, "Model not loaded. Please load a model before inference.");
+
+	ExecuTorchProgramUse use(*program);
+	std::vector<ExecuTorchTensor> input_tensors = inputs; // Handles only; _prepare_inputs may cast them
+	return _forward_program(*program, input_tensors, r_outputs);
+}
+
+Dictionary ExecuTorchResource::tensors_to_dictionary(const std::vector<ExecuTorchTensor> &outputs) const {
+	return _convert_tensors_to_dictionary(outputs, get_output_names());
+}
+
+Error ExecuTorchResource::_forward_program(ExecuTorchProgram &program, std::vector<ExecuTorchTensor> &r_inputs, std::vector<ExecuTorchTensor> &r_outputs) {
+	Error err = _make_resident(program);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Failed to reload the unloaded model.");
+	ERR_FAIL_COND_V_MSG(!program.module, ERR_UNCONFIGURED, "Model not loaded. Please load a model before inference.");
+	program.memory->touch();
+	program.last_used_usec = Time::get_singleton()->get_ticks_usec();
+
+	// Keyed on the inputs as given, before they are cast to the model's dtypes
+	bool use_result_cache = result_cache_capacity_.load() > 0;
+	uint64_t result_key = 0;
+	std::vector<ExecuTorchTensor> key_tensors;
+	if (use_result_cache) {
+		result_key = _hash_inputs(program.generation, r_inputs);
+		std::shared_ptr<const ExecuTorchCachedResult> cached = _find_cached_result(program, result_key, r_inputs);
+		if (cached) {
+			r_outputs = cached->outputs;
+			return OK;
+		}
+		key_tensors = r_inputs;
+	}
+
+	std::shared_ptr<const ExecuTorchExecutionPlan> plan;
+	err = _prepare_inputs(program, r_inputs, plan);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Inputs do not match the model signature.");
 
 	uint64_t start_time = Time::get_singleton()->get_ticks_usec();
-	Dictionary result = module_->forward(inputs);
+	r_outputs.clear();
+	{
+		ExecuTorchThreadScope thread_scope(program.runtime.get());
+		err = program.module->execute(r_inputs, r_outputs, plan.get());
+	}
 	uint64_t end_time = Time::get_singleton()->get_ticks_usec();
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Inference failed.");
 
 	double inference_time_millisecond = (end_time - start_time) / 1000.0;
 	_update_performance_stats(inference_time_millisecond);
-	return result;
+	if (use_result_cache) {
+		_store_cached_result(program, result_key, key_tensors, r_outputs);
+	}
+	return OK;
 }
 
 Array ExecuTorchResource::forward_array(const Array &input_data) {
+	Array input_names = get_input_names();
+	Array output_names = get_output_names();
+
 	Dictionary inputs;
-	if (input_names_.size() > 0) {
-		inputs[input_names_[0]] = input_data; // Pass the Array directly
+	if (input_names.size() > 0) {
+		inputs[input_names[0]] = input_data; // Pass the Array directly
 	} else {
 		inputs["input_0"] = input_data;
 	}
@@ -143,8 +443,8 @@ Array ExecuTorchResource::forward_array(const Array &input_data) {
 	Dictionary result = forward(inputs);
 
 	// Return first output as array
-	if (output_names_.size() > 0 && result.has(output_names_[0])) {
-		return result[output_names_[0]];
+	if (output_names.size() > 0 && result.has(output_names[0])) {
+		return result[output_names[0]];
 	}
 
 	return Array();
@@ -198,6 +498,44 @@ Error ExecuTorchResource::enable_profiling(bool enable) {
 	return OK;
 }
 
+void ExecuTorchResource::set_output_quantization(float scale, int zero_point) {
+	ERR_FAIL_COND_MSG(scale <= 0.0f, "Quantization scale must be positive.");
+	output_scale_ = scale;
+	output_zero_point_ = zero_point;
+}
+
+PackedByteArray ExecuTorchResource::encode_tensor(const PackedFloat32Array &values, TensorType type, float scale, int zero_point) {
+	ERR_FAIL_COND_V_MSG(!ExecuTorchTensor::is_valid_type(type), PackedByteArray(), "Unsupported tensor type: " + itos(type));
+
+	ExecuTorchTensor encoded;
+	Error err = ExecuTorchTensor::from_float32(values).convert((ExecuTorchScalarType)type, encoded, scale, zero_point);
+	ERR_FAIL_COND_V(err != OK, PackedByteArray());
+
+	if (encoded.storage.get_type() == Variant::PACKED_BYTE_ARRAY) {
+		return encoded.storage;
+	}
+
+	PackedByteArray bytes;
+	bytes.resize(encoded.get_byte_size());
+	memcpy(bytes.ptrw(), encoded.get_data(), bytes.size());
+	return bytes;
+}
+
+PackedFloat32Array ExecuTorchResource::decode_tensor(const PackedByteArray &data, TensorType type, float scale, int zero_point) {
+	ERR_FAIL_COND_V_MSG(!ExecuTorchTensor::is_valid_type(type), PackedFloat32Array(), "Unsupported tensor type: " + itos(type));
+
+	ExecuTorchTensor tensor;
+	tensor.dtype = (ExecuTorchScalarType)type;
+	tensor.storage = data;
+	tensor.scale = scale;
+	tensor.zero_point = zero_point;
+
+	PackedFloat32Array values;
+	Error err = tensor.to_float32(values);
+	ERR_FAIL_COND_V(err != OK, PackedFloat32Array());
+	return values;
+}
+
 Dictionary ExecuTorchResource::get_memory_info() const {
 	Dictionary info;
 
@@ -210,29 +548,498 @@ Dictionary ExecuTorchResource::get_memory_info() const {
 	}
 
 	info["policy"] = (int)memory_policy_;
+	info["runtime"] = runtime_name_;
+
+	info["budget_bytes"] = memory_budget_.load();
+	info["kernel_isa"] = ExecuTorchKernels::get_level_name(ExecuTorchKernels::get_level());
+
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	if (program && program->memory) {
+		const ExecuTorchMemoryAccount &memory = *program->memory;
+		info["weights_bytes"] = (int64_t)memory.get_usage(ExecuTorchMemoryTag::WEIGHTS);
+		info["activation_bytes"] = (int64_t)memory.get_usage(ExecuTorchMemoryTag::ACTIVATIONS);
+		info["io_bytes"] = (int64_t)memory.get_usage(ExecuTorchMemoryTag::IO);
+		info["scratch_bytes"] = (int64_t)memory.get_usage(ExecuTorchMemoryTag::SCRATCH);
+		info["model_bytes"] = (int64_t)memory.get_total_usage();
+		info["budget_rejections"] = memory.get_rejections();
+		info["evicted_bytes"] = memory.get_evicted_bytes();
+		info["resident"] = program->is_resident();
+		info["unloads"] = program->unloads.load();
+		info["reloads"] = program->reloads.load();
+		info["load_call_msec"] = program->load_call_msec.load();
+		info["warmup_cold_msec"] = program->warmup_cold_msec.load();
+		info["warmup_warm_msec"] = program->warmup_warm_msec.load();
+		info["load_msec"] = program->load_msec;
+		info["prepared_cache"] = program->prepared_hit ? "hit" : (program->prepared_key ? "miss" : "disabled");
+		info["idle_msec"] = (int64_t)(Time::get_singleton()->get_ticks_usec() - program->last_used_usec.load()) / 1000;
+	}
+	if (program) {
+		// The module can only be unloaded under us while the program is not resident
+		ExecuTorchProgramUse use(*program);
+		if (program->is_resident() && program->module) {
+			info["module_backend"] = program->module->get_backend_name();
+			info["native_executor_bytes"] = program->module->get_native_executor_bytes();
+		}
+	}
+	if (program && program->runtime) {
+		ExecuTorchMemoryPool::Stats pool = program->runtime->get_memory_pool_stats();
+		info["runtime_pool_bytes"] = (int64_t)pool.size;
+		info["runtime_pool_used_bytes"] = (int64_t)pool.used;
+		info["runtime_pool_peak_bytes"] = (int64_t)pool.peak;
+		info["runtime_pool_fallbacks"] = pool.fallbacks;
+		info["runtime_pool_huge_pages"] = pool.huge_pages;
+		info["runtime_pool_prefaulted"] = pool.prefaulted;
+		info["runtime_pool_locked"] = pool.locked;
+		info["runtime_pool_numa_bound"] = pool.numa_bound;
+		info["runtime_numa_node"] = program->runtime->get_numa_node();
+		info["runtime_thread_cpus"] = (int64_t)program->runtime->get_thread_cpus().size();
+		info["runtime_threads"] = program->runtime->get_num_threads();
+		info["runtime_usage_bytes"] = (int64_t)program->runtime->get_memory_usage();
+		info["runtime_budget_bytes"] = (int64_t)program->runtime->get_memory_budget();
+	}
+
+	return info;
+}
+
+void ExecuTorchResource::set_memory_budget(int64_t bytes) {
+	ERR_FAIL_COND_MSG(bytes < 0, "Memory budget must not be negative.");
+	memory_budget_ = bytes;
+
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	if (program && program->memory) {
+		program->memory->set_budget((size_t)bytes);
+	}
+}
+
+void ExecuTorchResource::set_memory_budget_policy(MemoryBudgetPolicy policy) {
+	memory_budget_policy_ = policy;
+
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	if (program && program->memory) {
+		program->memory->set_policy((ExecuTorchBudgetPolicy)policy);
+	}
+}
+
+size_t ExecuTorchResource::_evict_program_memory(ExecuTorchProgram *program, size_t bytes_needed) {
+	// Cached results go first; they are the only memory a model gives up while staying loaded.
+	size_t before = program->memory->get_usage(ExecuTorchMemoryTag::IO);
+	{
+		MutexLock lock(program->result_mutex);
+		program->result_evictions += program->results.get_size();
+		program->results.clear();
+	}
+	size_t after = program->memory->get_usage(ExecuTorchMemoryTag::IO);
+	size_t freed = before > after ? before - after : 0;
+
+	// Still short: unload the whole program if nothing is running it
+	if (freed < bytes_needed) {
+		freed += program->try_unload();
+	}
+	return freed;
+}
+
+bool ExecuTorchResource::is_resident() const {
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	return program && program->is_resident();
+}
+
+Error ExecuTorchResource::_make_resident(ExecuTorchProgram &program) {
+	// An unload that already passed its in-flight check finishes quickly
+	while (program.residency.load() == ExecuTorchProgram::RESIDENCY_EVICTING) {
+		std::this_thread::yield();
+	}
+	if (program.residency.load() != ExecuTorchProgram::RESIDENCY_EVICTED) {
+		return OK;
+	}
+
+	MutexLock lock(program.reload_mutex);
+	if (program.residency.load() != ExecuTorchProgram::RESIDENCY_EVICTED) {
+		return OK; // Another call reloaded it first
+	}
+
+	uint64_t start_time = Time::get_singleton()->get_ticks_usec();
+	Error result = _load_program(program);
+	if (result != OK) {
+		program.module.reset();
+		program.activations_charge.reset();
+		return result;
+	}
+	_warm_program(program);
+
+	program.reloads++;
+	program.residency = ExecuTorchProgram::RESIDENCY_RESIDENT;
+	print_line("Reloaded model generation " + itos(program.generation) + " in " + rtos((Time::get_singleton()->get_ticks_usec() - start_time) / 1000.0) + "ms");
+	return OK;
+}
+
+void ExecuTorchResource::set_runtime_name(const String &name) {
+	ERR_FAIL_COND_MSG(name.is_empty(), "Runtime name must not be empty.");
+
+	// A background swap reads the name while it builds
+	MutexLock lock(swap_mutex_);
+	wait_for_swap();
+	if (name == runtime_name_) {
+		return;
+	}
+	runtime_name_ = name;
+
+	// Rebuild on the new runtime so its pool, threads and accounting take over;
+	// in-flight calls finish on the old one
+	if (is_loaded()) {
+		swap_model_data(model_data_, false);
+	}
+}
+
+void ExecuTorchResource::set_plan_cache_capacity(int capacity) {
+	ERR_FAIL_COND_MSG(capacity < 0, "Plan cache capacity must not be negative.");
+	plan_cache_capacity_ = capacity;
+
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	if (program) {
+		MutexLock lock(program->plan_mutex);
+		// LRUCache cannot grow back from zero, so disabling only empties it
+		if (capacity > 0) {
+			program->plans.set_capacity(capacity);
+		} else {
+			program->plans.clear();
+		}
+	}
+}
+
+void ExecuTorchResource::set_result_cache_capacity(int capacity) {
+	ERR_FAIL_COND_MSG(capacity < 0, "Result cache capacity must not be negative.");
+	result_cache_capacity_ = capacity;
+
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	if (program) {
+		MutexLock lock(program->result_mutex);
+		if (capacity > 0) {
+			program->results.set_capacity(capacity);
+		} else {
+			program->results.clear();
+		}
+	}
+}
+
+Dictionary ExecuTorchResource::get_result_cache_stats() const {
+	Dictionary stats;
+	stats["capacity"] = result_cache_capacity_.load();
+
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	if (program) {
+		MutexLock lock(program->result_mutex);
+		stats["size"] = (int64_t)program->results.get_size();
+		stats["hits"] = program->result_hits;
+		stats["misses"] = program->result_misses;
+		stats["evictions"] = program->result_evictions;
+	} else {
+		stats["size"] = 0;
+		stats["hits"] = 0;
+		stats["misses"] = 0;
+		stats["evictions"] = 0;
+	}
+	return stats;
+}
+
+void ExecuTorchResource::clear_result_cache() {
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	if (program) {
+		MutexLock lock(program->result_mutex);
+		program->results.clear();
+	}
+}
+
+Dictionary ExecuTorchResource::get_plan_cache_stats() const {
+	Dictionary stats;
+	stats["capacity"] = plan_cache_capacity_.load();
+
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	if (program) {
+		MutexLock lock(program->plan_mutex);
+		stats["size"] = (int64_t)program->plans.get_size();
+		stats["hits"] = program->plan_hits;
+		stats["misses"] = program->plan_misses;
+		stats["evictions"] = program->plan_evictions;
+	} else {
+		stats["size"] = 0;
+		stats["hits"] = 0;
+		stats["misses"] = 0;
+		stats["evictions"] = 0;
+	}
+	return stats;
+}
 
+Array ExecuTorchResource::get_input_names() const {
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	return program ? program->input_names : Array();
+}
+
+Array ExecuTorchResource::get_output_names() const {
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	return program ? program->output_names : Array();
+}
+
+Dictionary ExecuTorchResource::get_input_shapes() const {
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	return program ? program->input_shapes : Dictionary();
+}
+
+Dictionary ExecuTorchResource::get_output_shapes() const {
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	return program ? program->output_shapes : Dictionary();
+}
+
+Array ExecuTorchResource::get_input_info() const {
+	Array info;
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	if (program) {
+		for (const ExecuTorchTensorInfo &tensor : program->input_info) {
+			info.push_back(tensor.to_dictionary());
+		}
+	}
 	return info;
 }
 
+Array ExecuTorchResource::get_output_info() const {
+	Array info;
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	if (program) {
+		for (const ExecuTorchTensorInfo &tensor : program->output_info) {
+			info.push_back(tensor.to_dictionary());
+		}
+	}
+	return info;
+}
+
+String ExecuTorchResource::get_model_name() const {
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	return program ? program->model_name : String();
+}
+
+String ExecuTorchResource::get_model_version() const {
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	return program ? program->model_version : String();
+}
+
 void ExecuTorchResource::set_model_data(const PackedByteArray &data) {
-	model_data_ = data;
+	// Hot swap if we had a model loaded; the old program keeps serving until then.
+	if (is_loaded()) {
+		swap_model_data(data, false);
+	} else {
+		model_data_ = data;
+	}
+
+	emit_changed();
+}
 
-	// Reload if we had a model loaded
-	if (is_loaded_) {
-		clear();
-		_load_with_high_level_api();
+Error ExecuTorchResource::swap_model_data(const PackedByteArray &data, bool threaded) {
+	MutexLock lock(swap_mutex_);
+
+	// Only one background swap at a time; a newer request waits for the older one.
+	if (swap_task_id_ != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(swap_task_id_);
+		swap_task_id_ = WorkerThreadPool::INVALID_TASK_ID;
 	}
+
+	// model_data_ follows the published program, so a failed build leaves it alone.
+	uint64_t generation = next_generation_++;
+
+	if (!threaded) {
+		std::shared_ptr<ExecuTorchProgram> program;
+		Error result = _build_program(data, generation, program);
+		if (result == OK) {
+			_publish_program(program);
+			_adopt_published_data();
+		} else {
+			print_error("Hot swap failed, keeping generation " + itos(get_model_generation()));
+		}
+		emit_signal("model_swapped", generation, (int)result);
+		return result;
+	}
+
+	SwapTask *task = memnew(SwapTask);
+	task->resource = this;
+	task->data = data;
+	task->generation = generation;
+
+	swap_task_id_ = WorkerThreadPool::get_singleton()->add_native_task(&ExecuTorchResource::_swap_task, task, false, "ExecuTorch hot swap");
+	return OK;
 }
 
-Error ExecuTorchResource::_load_with_high_level_api() {
+bool ExecuTorchResource::is_swap_pending() {
+	MutexLock lock(swap_mutex_);
+	if (swap_task_id_ == WorkerThreadPool::INVALID_TASK_ID) {
+		return false;
+	}
+	if (!WorkerThreadPool::get_singleton()->is_task_completed(swap_task_id_)) {
+		return true;
+	}
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(swap_task_id_);
+	swap_task_id_ = WorkerThreadPool::INVALID_TASK_ID;
+	_adopt_published_data();
+	return false;
+}
+
+void ExecuTorchResource::wait_for_swap() {
+	MutexLock lock(swap_mutex_);
+	if (swap_task_id_ != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(swap_task_id_);
+		swap_task_id_ = WorkerThreadPool::INVALID_TASK_ID;
+		_adopt_published_data();
+	}
+}
+
+void ExecuTorchResource::_adopt_published_data() {
+	// Called on the owning thread once a swap is settled; the worker never
+	// writes model_data_ itself.
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	if (program) {
+		model_data_ = program->model_data;
+	}
+}
+
+uint64_t ExecuTorchResource::get_model_generation() const {
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	return program ? program->generation : 0;
+}
+
+void ExecuTorchResource::_swap_task(void *p_userdata) {
+	SwapTask *task = static_cast<SwapTask *>(p_userdata);
+
+	std::shared_ptr<ExecuTorchProgram> program;
+	Error result = task->resource->_build_program(task->data, task->generation, program);
+	if (result == OK) {
+		task->resource->_publish_program(program);
+	}
+
+	callable_mp(task->resource, &ExecuTorchResource::_on_swap_finished).call_deferred(task->generation, result);
+	memdelete(task);
+}
+
+void ExecuTorchResource::_on_swap_finished(uint64_t generation, Error result) {
+	is_swap_pending(); // Reaps the finished task and adopts its data
+	if (result != OK) {
+		print_error("Hot swap to generation " + itos(generation) + " failed, keeping generation " + itos(get_model_generation()));
+	}
+	emit_signal("model_swapped", generation, (int)result);
+}
+
+Error ExecuTorchResource::_build_program(const PackedByteArray &data, uint64_t generation, std::shared_ptr<ExecuTorchProgram> &r_program) {
+	std::shared_ptr<ExecuTorchProgram> program = std::make_shared<ExecuTorchProgram>();
+	program->generation = generation;
+	program->model_data = data;
+	program->runtime = ExecuTorchRuntimeRegistry::get_singleton()->acquire(runtime_name_.utf8().get_data());
+	if (!program->runtime) {
+		print_error("ExecuTorch runtime '" + runtime_name_ + "' is unavailable");
+		return FAILED;
+	}
+
+	ExecuTorchProgram *raw_program = program.get();
+	program->memory = std::make_unique<ExecuTorchMemoryAccount>(program->runtime.get(), "generation " + std::to_string(generation));
+	program->memory->set_budget((size_t)memory_budget_.load());
+	program->memory->set_policy((ExecuTorchBudgetPolicy)memory_budget_policy_.load());
+	program->memory->set_evictor([raw_program](size_t bytes_needed) {
+		return _evict_program_memory(raw_program, bytes_needed);
+	});
+
+	if (plan_cache_capacity_.load() > 0) {
+		program->plans.set_capacity(plan_cache_capacity_.load());
+	}
+	if (result_cache_capacity_.load() > 0) {
+		program->results.set_capacity(result_cache_capacity_.load());
+	}
+
+	// Prepared state from an earlier launch replaces parsing and planning
+	uint64_t start_time = Time::get_singleton()->get_ticks_usec();
+	ExecuTorchPreparedState prepared;
+	if (ExecuTorchPreparedCache::is_enabled()) {
+		program->prepared_key = std::make_unique<ExecuTorchPreparedKey>(ExecuTorchPreparedCache::make_key(data));
+		program->prepared_hit = ExecuTorchPreparedCache::load(*program->prepared_key, prepared) == OK;
+	}
+
+	Error result = _load_program(*program, program->prepared_hit ? &prepared.program_info : nullptr);
+	if (result != OK) {
+		return result;
+	}
+
+	_extract_metadata(*program);
+	if (program->prepared_hit) {
+		_restore_prepared_plans(*program, prepared.plans);
+	} else if (program->prepared_key) {
+		_save_prepared_state(*program); // Metadata now; warmup() and save_prepared_state() add plans
+	}
+	program->load_msec = (Time::get_singleton()->get_ticks_usec() - start_time) / 1000.0;
+	_warm_program(*program);
+
+	program->last_used_usec = Time::get_singleton()->get_ticks_usec();
+	program->residency = ExecuTorchProgram::RESIDENCY_RESIDENT;
+	r_program = program;
+	return OK;
+}
+
+Error ExecuTorchResource::_load_program(ExecuTorchProgram &program, const ExecuTorchProgramInfo *prepared_info) {
+	size_t data_size = program.model_data.size();
+	// Still held from the first load when reloading after an eviction
+	if (program.weights_charge.get_bytes() != data_size && !program.weights_charge.acquire(program.memory.get(), ExecuTorchMemoryTag::WEIGHTS, data_size)) {
+		print_error("Model of " + itos(data_size) + " bytes exceeds the memory budget");
+		return ERR_OUT_OF_MEMORY;
+	}
+	if (program.runtime) {
+		// Bandwidth-bound models read their weights on every call; keep them next to the inference threads
+		program.runtime->bind_memory(program.model_data.ptr(), data_size);
+	}
+
+	Error result = _load_with_high_level_api(program, prepared_info);
+	if (result != OK) {
+		print_line("High-level API failed, trying low-level API...");
+		result = _load_with_low_level_api(program);
+	}
+	if (result != OK) {
+		return result;
+	}
+
+	// Planned activation buffers declared by the program, unless the backend
+	// already charged them when it allocated its arenas from the runtime
+	const ExecuTorchMethodInfo *method = program.module ? program.module->get_method_info("forward") : nullptr;
+	int64_t planned_bytes = 0;
+	if (method && !program.module->has_runtime_arenas()) {
+		for (int64_t size : method->non_const_buffer_sizes) {
+			planned_bytes += size;
+		}
+	}
+	if (!program.activations_charge.acquire(program.memory.get(), ExecuTorchMemoryTag::ACTIVATIONS, planned_bytes)) {
+		print_error("Planned activations of " + itos(planned_bytes) + " bytes exceed the memory budget");
+		return ERR_OUT_OF_MEMORY;
+	}
+	return OK;
+}
+
+bool ExecuTorchResource::_publish_program(const std::shared_ptr<ExecuTorchProgram> &program) {
+	// Never replace a newer program with an older one that finished building late.
+	std::shared_ptr<ExecuTorchProgram> current = std::atomic_load(&program_);
+	while (!current || current->generation < program->generation) {
+		if (std::atomic_compare_exchange_weak(&program_, &current, program)) {
+			print_line("Published model generation " + itos(program->generation));
+			return true;
+		}
+	}
+	return false;
+}
+
+Error ExecuTorchResource::_load_with_high_level_api(ExecuTorchProgram &program, const ExecuTorchProgramInfo *prepared_info) {
 	print_line("Loading with high-level ExecuTorch Module API...");
 
 	// Create module using high-level API
-	module_ = std::make_unique<ExecuTorchModule>();
+	program.module = std::make_unique<ExecuTorchModule>();
+	program.module->set_native_executor_enabled(native_executor_enabled_.load());
+	program.module->set_memory_source(program.runtime.get(), program.memory.get());
+	if (program.runtime) {
+		ExecuTorchXNNPACKModule::configure_threads(program.runtime->get_num_threads());
+	}
 
-	Error result = module_->load_from_buffer(model_data_);
+	Error result = program.module->load_from_buffer(program.model_data, prepared_info);
 	if (result != OK) {
-		module_.reset();
+		program.module.reset();
 		return result;
 	}
 
@@ -240,9 +1047,14 @@ Error ExecuTorchResource::_load_with_high_level_api() {
 	return OK;
 }
 
-Error ExecuTorchResource::_load_with_low_level_api() {
+Error ExecuTorchResource::_load_with_low_level_api(ExecuTorchProgram &program) {
 	print_line("Loading with low-level ExecuTorch API...");
 
+	if (program.model_data.size() < 16) { // Minimum .pte file size
+		print_error("Buffer too small to be valid .pte file");
+		return FAILED;
+	}
+
 	// Configure memory management first
 	if (!memory_manager_) {
 		configure_memory(memory_policy_, memory_limit_bytes_);
@@ -258,39 +1070,224 @@ Error ExecuTorchResource::_load_with_low_level_api() {
 	return OK;
 }
 
-void ExecuTorchResource::_extract_metadata() {
-	if (!module_) {
+void ExecuTorchResource::_extract_metadata(ExecuTorchProgram &program) {
+	if (!program.module) {
 		return;
 	}
 
-	// Extract metadata from the loaded module
-	Array method_names = module_->get_method_names();
-	if (method_names.size() > 0) {
-		Dictionary meta = module_->get_method_meta("forward");
+	const ExecuTorchMethodInfo *method = program.module->get_method_info("forward");
+	if (!method && !program.module->get_program_info().methods.is_empty()) {
+		method = &program.module->get_program_info().methods[0];
+	}
+
+	if (method) {
+		program.input_info = method->inputs;
+		program.output_info = method->outputs;
+		program.model_version = itos(program.module->get_program_info().version);
+	} else {
+		// No program header (e.g. raw test buffers): one float32 tensor of any shape in and out
+		ExecuTorchTensorInfo input;
+		input.name = "input_0";
+		input.shape.push_back(1);
+		input.shape.push_back(1);
+		input.dynamism = ExecuTorchShapeDynamism::DYNAMIC_UNBOUND;
+		program.input_info.push_back(input);
+
+		ExecuTorchTensorInfo output = input;
+		output.name = "output_0";
+		program.output_info.push_back(output);
+		program.model_version = "1.0.0";
+	}
 
-		// Extract input/output information
-		// This is simplified - real implementation would parse tensor metadata
-		input_names_ = Array();
-		input_names_.push_back("input_0");
-		output_names_ = Array();
-		output_names_.push_back("output_0");
+	program.input_names = Array();
+	program.output_names = Array();
+	for (const ExecuTorchTensorInfo &tensor : program.input_info) {
+		program.input_names.push_back(tensor.name);
+		program.input_shapes[tensor.name] = tensor.to_dictionary()["shape"];
+	}
+	for (const ExecuTorchTensorInfo &tensor : program.output_info) {
+		program.output_names.push_back(tensor.name);
+		program.output_shapes[tensor.name] = tensor.to_dictionary()["shape"];
+	}
 
-		// Set default shapes for linear regression model
-		Array input_shape;
-		input_shape.push_back(1);
-		input_shape.push_back(1);
-		input_shapes_["input_0"] = input_shape;
+	program.model_name = "ExecuTorchModel";
 
-		Array output_shape;
-		output_shape.push_back(1);
-		output_shape.push_back(1);
-		output_shapes_["output_0"] = output_shape;
+	print_line("Metadata extracted: " + itos(program.input_names.size()) + " inputs, " + itos(program.output_names.size()) + " outputs");
+}
+
+bool ExecuTorchResource::_charge_plan_arena(ExecuTorchProgram &program, uint64_t arena_bytes) const {
+	// Runtime arenas are sized for the program's static shapes and charged already
+	if (program.module && program.module->has_runtime_arenas()) {
+		return true;
 	}
+	return arena_bytes <= program.activations_charge.get_bytes() || program.activations_charge.resize(arena_bytes);
+}
 
-	model_name_ = "ExecuTorchModel";
-	model_version_ = "1.0.0";
+void ExecuTorchResource::_restore_prepared_plans(ExecuTorchProgram &program, const std::vector<std::pair<Vector<int64_t>, ExecuTorchExecutionPlan>> &plans) {
+	MutexLock lock(program.plan_mutex);
+	for (const std::pair<Vector<int64_t>, ExecuTorchExecutionPlan> &entry : plans) {
+		const ExecuTorchExecutionPlan &plan = entry.second;
+		if (!_charge_plan_arena(program, plan.arena_bytes)) {
+			break; // The rest are planned again on first use if memory allows
+		}
+		std::shared_ptr<const ExecuTorchExecutionPlan> restored = std::make_shared<const ExecuTorchExecutionPlan>(plan);
+		if (plan_cache_capacity_.load() > 0) {
+			program.plans.insert(entry.first, restored);
+		}
+		_remember_prepared_plan(program, entry.first, restored);
+	}
+}
 
-	print_line("Metadata extracted: " + itos(input_names_.size()) + " inputs, " + itos(output_names_.size()) + " outputs");
+void ExecuTorchResource::_remember_prepared_plan(ExecuTorchProgram &program, const Vector<int64_t> &key, const std::shared_ptr<const ExecuTorchExecutionPlan> &plan) const {
+	// Bounded like the plan cache, keeping the newest
+	for (size_t i = 0; i < program.prepared_plans.size(); i++) {
+		if (program.prepared_plans[i].first == key) {
+			program.prepared_plans.erase(program.prepared_plans.begin() + i);
+			break;
+		}
+	}
+	program.prepared_plans.push_back(std::make_pair(key, plan));
+	size_t limit = MAX(plan_cache_capacity_.load(), 1);
+	if (program.prepared_plans.size() > limit) {
+		program.prepared_plans.erase(program.prepared_plans.begin(), program.prepared_plans.end() - limit);
+	}
+}
+
+Error ExecuTorchResource::save_prepared_state() {
+	ERR_FAIL_COND_V_MSG(!ExecuTorchPreparedCache::is_enabled(), ERR_UNCONFIGURED, "The prepared cache is disabled (see executorch/prepared_cache/enabled).");
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	ERR_FAIL_COND_V_MSG(!program || !program->prepared_key, ERR_UNCONFIGURED, "No model loaded with the prepared cache enabled.");
+	return _save_prepared_state(*program);
+}
+
+Error ExecuTorchResource::_save_prepared_state(ExecuTorchProgram &program) {
+	ExecuTorchPreparedState state;
+	{
+		// The module (and its parsed header) is gone while the program is unloaded
+		ExecuTorchProgramUse use(program);
+		if (_make_resident(program) != OK || !program.module) {
+			return ERR_UNAVAILABLE;
+		}
+		state.program_info = program.module->get_program_info();
+	}
+	{
+		MutexLock lock(program.plan_mutex);
+		for (const std::pair<Vector<int64_t>, std::shared_ptr<const ExecuTorchExecutionPlan>> &entry : program.prepared_plans) {
+			state.plans.push_back(std::make_pair(entry.first, *entry.second));
+		}
+	}
+
+	Error err = ExecuTorchPreparedCache::save(*program.prepared_key, state);
+	if (err != OK) {
+		print_error("Failed to save prepared state for model generation " + itos(program.generation));
+	}
+	return err;
+}
+
+void ExecuTorchResource::_warm_program(ExecuTorchProgram &program) {
+	if (!program.module || !warmup_on_load_.load()) {
+		return;
+	}
+
+	// Fault the weights in and run one call before publishing, so the first real call
+	// after a load or swap pays for neither page faults nor lazy init.
+	_touch_pages(program.model_data);
+
+	std::vector<ExecuTorchTensor> inputs;
+	for (const ExecuTorchTensorInfo &info : program.input_info) {
+		PackedFloat32Array zeros;
+		zeros.resize(MAX(info.get_element_count(), 1));
+		zeros.fill(0.0f);
+
+		ExecuTorchTensor tensor;
+		if (ExecuTorchTensor::from_float32(zeros, info.shape).convert(info.dtype, tensor) != OK) {
+			return;
+		}
+		inputs.push_back(tensor);
+	}
+
+	uint64_t start_time = Time::get_singleton()->get_ticks_usec();
+	std::vector<ExecuTorchTensor> outputs;
+	program.module->execute(inputs, outputs);
+	program.load_call_msec = (Time::get_singleton()->get_ticks_usec() - start_time) / 1000.0;
+}
+
+Dictionary ExecuTorchResource::warmup(int iterations) {
+	ERR_FAIL_COND_V_MSG(iterations < 1, Dictionary(), "Warmup needs at least one iteration.");
+	std::shared_ptr<ExecuTorchProgram> program = acquire_program();
+	ERR_FAIL_COND_V_MSG(!program, Dictionary(), "Model not loaded. Please load a model before warmup.");
+
+	ExecuTorchProgramUse use(*program);
+	Error err = _make_resident(*program);
+	ERR_FAIL_COND_V_MSG(err != OK || !program->module, Dictionary(), "Failed to reload the unloaded model.");
+	program->memory->touch();
+
+	Dictionary report;
+	report["pages_touched"] = _touch_pages(program->model_data);
+
+	std::vector<ExecuTorchTensor> synthetic;
+	err = _make_synthetic_inputs(*program, synthetic);
+	ERR_FAIL_COND_V_MSG(err != OK, Dictionary(), "Failed to build synthetic warmup inputs.");
+
+	// Same conversions, plan lookup and execution as forward(), minus the stats and result cache
+	double cold_msec = 0.0;
+	double warm_total_msec = 0.0;
+	int completed = 0;
+	for (int i = 0; i < iterations; i++) {
+		uint64_t start_time = Time::get_singleton()->get_ticks_usec();
+		std::vector<ExecuTorchTensor> inputs = synthetic;
+		std::shared_ptr<const ExecuTorchExecutionPlan> plan;
+		std::vector<ExecuTorchTensor> outputs;
+		ExecuTorchThreadScope thread_scope(program->runtime.get());
+		if (_prepare_inputs(*program, inputs, plan) != OK || program->module->execute(inputs, outputs, plan.get()) != OK) {
+			break;
+		}
+		double msec = (Time::get_singleton()->get_ticks_usec() - start_time) / 1000.0;
+		if (completed == 0) {
+			cold_msec = msec;
+		} else {
+			warm_total_msec += msec;
+		}
+		completed++;
+	}
+	ERR_FAIL_COND_V_MSG(completed == 0, Dictionary(), "Warmup inference failed.");
+
+	double warm_msec = completed > 1 ? warm_total_msec / (completed - 1) : cold_msec;
+	program->warmup_cold_msec = cold_msec;
+	program->warmup_warm_msec = warm_msec;
+
+	report["iterations"] = completed;
+	report["cold_msec"] = cold_msec;
+	report["warm_msec"] = warm_msec;
+	if (program->prepared_key) {
+		_save_prepared_state(*program); // Keep the plans warmup just built for the next launch
+	}
+	print_line("Warmup: cold " + rtos(cold_msec) + "ms, warm " + rtos(warm_msec) + "ms over " + itos(completed) + " calls");
+	return report;
+}
+
+Error ExecuTorchResource::_make_synthetic_inputs(const ExecuTorchProgram &program, std::vector<ExecuTorchTensor> &r_tensors) const {
+	// Flat float32 arrays like predict() sends, so warmup primes the plans real calls will use
+	Dictionary inputs;
+	for (const ExecuTorchTensorInfo &info : program.input_info) {
+		PackedFloat32Array zeros;
+		zeros.resize(MAX(info.get_element_count(), 1));
+		zeros.fill(0.0f);
+		inputs[info.name] = zeros;
+	}
+	return _convert_dictionary_to_tensors(inputs, program, r_tensors);
+}
+
+int64_t ExecuTorchResource::_touch_pages(const PackedByteArray &data) {
+	const int64_t page_size = 4096;
+	const uint8_t *ptr = data.ptr();
+	volatile uint8_t sink = 0;
+	int64_t pages = 0;
+	for (int64_t offset = 0; offset < data.size(); offset += page_size) {
+		sink = sink + ptr[offset];
+		pages++;
+	}
+	return pages;
 }
 
 void ExecuTorchResource::_update_performance_stats(double inference_time) const {
@@ -300,32 +1297,232 @@ void ExecuTorchResource::_update_performance_stats(double inference_time) const
 	print_line("Inference #" + itos(total_inferences_) + " completed in " + rtos(inference_time) + "ms");
 }
 
-Dictionary ExecuTorchResource::_convert_tensors_to_dictionary(const std::vector<void *> &tensors, const Array &names) const {
+Dictionary ExecuTorchResource::_convert_tensors_to_dictionary(const std::vector<ExecuTorchTensor> &tensors, const Array &names) const {
 	Dictionary result;
 
-	// In real implementation, this would convert ExecuTorch tensors to Godot types
-	for (size_t i = 0; i < tensors.size() && i < (size_t)names.size(); ++i) {
-		result[names[i]] = PackedFloat32Array(); // Placeholder
+	for (size_t i = 0; i < tensors.size(); ++i) {
+		Variant name = i < (size_t)names.size() ? names[i] : Variant("output_" + itos(i));
+
+		ExecuTorchTensor output;
+		Error err = tensors[i].convert((ExecuTorchScalarType)output_type_, output, output_scale_, output_zero_point_);
+		ERR_CONTINUE_MSG(err != OK, "Failed to convert output " + String(name) + ".");
+		result[name] = output.to_variant();
 	}
 
 	return result;
 }
 
-std::vector<void *> ExecuTorchResource::_convert_dictionary_to_tensors(const Dictionary &inputs) const {
-	std::vector<void *> tensors;
+Error ExecuTorchResource::_convert_dictionary_to_tensors(const Dictionary &inputs, const ExecuTorchProgram &program, std::vector<ExecuTorchTensor> &r_tensors) const {
+	r_tensors.clear();
+	const Array &names = program.input_names;
 
-	// In real implementation, this would convert Godot types to ExecuTorch tensors
-	Array keys = inputs.keys();
-	for (int64_t i = 0; i < keys.size(); i++) {
-		tensors.push_back(nullptr); // Placeholder
+	// Match by name when every declared input is present, otherwise fall back to positional order.
+	bool by_name = names.size() > 0;
+	for (int64_t i = 0; i < names.size() && by_name; i++) {
+		by_name = inputs.has(names[i]);
 	}
 
-	return tensors;
+	Array values;
+	if (by_name) {
+		for (int64_t i = 0; i < names.size(); i++) {
+			values.push_back(inputs[names[i]]);
+		}
+	} else {
+		ERR_FAIL_COND_V_MSG(names.size() > 0 && inputs.size() != names.size(), ERR_INVALID_PARAMETER, "Expected " + itos(names.size()) + " inputs, got " + itos(inputs.size()) + ".");
+		values = inputs.values();
+	}
+
+	r_tensors.resize(values.size());
+	for (int64_t i = 0; i < values.size(); i++) {
+		Error err = ExecuTorchTensor::from_variant(values[i], r_tensors[i]);
+		if (err != OK) {
+			return err;
+		}
+	}
+
+	return OK;
+}
+
+Error ExecuTorchResource::_prepare_inputs(ExecuTorchProgram &program, std::vector<ExecuTorchTensor> &r_tensors, std::shared_ptr<const ExecuTorchExecutionPlan> &r_plan) const {
+	Vector<int64_t> key;
+	key.push_back((int64_t)r_tensors.size());
+	for (const ExecuTorchTensor &tensor : r_tensors) {
+		key.push_back((int64_t)tensor.dtype);
+		key.push_back(tensor.get_element_count()); // Flat inputs carry no shape
+		key.push_back(tensor.shape.size());
+		key.append_array(tensor.shape);
+	}
+
+	{
+		MutexLock lock(program.plan_mutex);
+		const std::shared_ptr<const ExecuTorchExecutionPlan> *cached = program.plans.getptr(key);
+		if (cached) {
+			r_plan = *cached;
+			program.plan_hits++;
+		}
+	}
+
+	if (r_plan) {
+		// Already validated for these shapes; only the declared shapes and dtypes need applying.
+		for (size_t i = 0; i < r_tensors.size(); i++) {
+			r_tensors[i].shape = r_plan->input_shapes[i];
+			Error err = _cast_tensor(r_plan->input_dtypes[i], r_tensors[i]);
+			if (err != OK) {
+				return err;
+			}
+		}
+		return OK;
+	}
+
+	for (size_t i = 0; i < r_tensors.size() && i < (size_t)program.input_info.size(); i++) {
+		Error err = _conform_tensor(program.input_info[i], r_tensors[i]);
+		if (err != OK) {
+			return err;
+		}
+	}
+
+	std::shared_ptr<ExecuTorchExecutionPlan> plan = std::make_shared<ExecuTorchExecutionPlan>();
+	Error err = program.module->prepare_plan(r_tensors, *plan);
+	if (err != OK) {
+		return err;
+	}
+
+	MutexLock lock(program.plan_mutex);
+	if (!_charge_plan_arena(program, plan->arena_bytes)) {
+		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Activations for these input shapes exceed the memory budget.");
+	}
+	program.plan_misses++;
+	if (plan_cache_capacity_.load() > 0) {
+		if (!program.plans.has(key) && program.plans.get_size() >= program.plans.get_capacity()) {
+			program.plan_evictions++;
+		}
+		program.plans.insert(key, plan);
+	}
+	if (program.prepared_key) {
+		_remember_prepared_plan(program, key, plan);
+	}
+	r_plan = plan;
+	return OK;
+}
+
+Error ExecuTorchResource::_conform_tensor(const ExecuTorchTensorInfo &info, ExecuTorchTensor &r_tensor) {
+	int64_t expected = info.get_element_count();
+	// Raw bytes sized exactly for the declared input are that input's data, e.g. int8 or fp16 in a PackedByteArray
+	if (r_tensor.shape.size() <= 1 && r_tensor.reinterpret(info.dtype, expected)) {
+		r_tensor.shape.clear();
+	}
+
+	int64_t count = r_tensor.get_element_count();
+	switch (info.dynamism) {
+		case ExecuTorchShapeDynamism::STATIC:
+			ERR_FAIL_COND_V_MSG(count != expected, ERR_INVALID_PARAMETER, vformat("Input '%s' expects %d elements, got %d.", info.name, expected, count));
+			break;
+		case ExecuTorchShapeDynamism::DYNAMIC_BOUND:
+			ERR_FAIL_COND_V_MSG(count > expected, ERR_INVALID_PARAMETER, vformat("Input '%s' accepts at most %d elements, got %d.", info.name, expected, count));
+			break;
+		case ExecuTorchShapeDynamism::DYNAMIC_UNBOUND:
+			break;
+	}
+
+	// Flat inputs take the declared shape when it fits
+	if (r_tensor.shape.size() <= 1 && count == expected) {
+		r_tensor.shape = info.shape;
+	}
+
+	Error err = _cast_tensor(info.dtype, r_tensor);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot convert input '%s' to %s.", info.name, ExecuTorchTensor::get_type_name(info.dtype)));
+	return OK;
+}
+
+uint64_t ExecuTorchResource::_hash_inputs(uint64_t generation, const std::vector<ExecuTorchTensor> &tensors) {
+	uint32_t hash = hash_murmur3_one_64(generation);
+	for (const ExecuTorchTensor &tensor : tensors) {
+		hash = hash_murmur3_one_32((uint32_t)tensor.dtype, hash);
+		// Quantized inputs are keyed before dequantization, so the same bytes
+		// under another scale are a different input
+		hash = hash_murmur3_one_float(tensor.scale, hash);
+		hash = hash_murmur3_one_32((uint32_t)tensor.zero_point, hash);
+		for (int64_t dim : tensor.shape) {
+			hash = hash_murmur3_one_64(dim, hash);
+		}
+		hash = hash_murmur3_buffer(tensor.get_data(), tensor.get_byte_size(), hash);
+	}
+	return (generation << 32) | hash;
+}
+
+std::shared_ptr<const ExecuTorchCachedResult> ExecuTorchResource::_find_cached_result(ExecuTorchProgram &program, uint64_t key, const std::vector<ExecuTorchTensor> &inputs) const {
+	std::shared_ptr<const ExecuTorchCachedResult> cached;
+	{
+		MutexLock lock(program.result_mutex);
+		const std::shared_ptr<const ExecuTorchCachedResult> *entry = program.results.getptr(key);
+		if (entry) {
+			cached = *entry;
+		}
+	}
+
+	// Rule out hash collisions before trusting the entry
+	bool match = cached && cached->inputs.size() == inputs.size();
+	for (size_t i = 0; match && i < inputs.size(); i++) {
+		const ExecuTorchTensor &a = cached->inputs[i];
+		const ExecuTorchTensor &b = inputs[i];
+		match = a.dtype == b.dtype && a.scale == b.scale && a.zero_point == b.zero_point &&
+				a.shape == b.shape && a.get_byte_size() == b.get_byte_size() &&
+				memcmp(a.get_data(), b.get_data(), b.get_byte_size()) == 0;
+	}
+
+	MutexLock lock(program.result_mutex);
+	if (match) {
+		program.result_hits++;
+		return cached;
+	}
+	program.result_misses++;
+	return nullptr;
+}
+
+void ExecuTorchResource::_store_cached_result(ExecuTorchProgram &program, uint64_t key, const std::vector<ExecuTorchTensor> &inputs, const std::vector<ExecuTorchTensor> &outputs) const {
+	std::shared_ptr<ExecuTorchCachedResult> entry = std::make_shared<ExecuTorchCachedResult>();
+	entry->inputs = inputs;
+	entry->outputs = outputs;
+
+	// Charged before taking result_mutex, since a budget overflow may evict this cache
+	int64_t bytes = 0;
+	for (const ExecuTorchTensor &tensor : inputs) {
+		bytes += tensor.get_byte_size();
+	}
+	for (const ExecuTorchTensor &tensor : outputs) {
+		bytes += tensor.get_byte_size();
+	}
+	if (!entry->charge.acquire(program.memory.get(), ExecuTorchMemoryTag::IO, bytes)) {
+		return;
+	}
+
+	MutexLock lock(program.result_mutex);
+	if (!program.results.has(key) && program.results.get_size() >= program.results.get_capacity()) {
+		program.result_evictions++;
+	}
+	program.results.insert(key, entry);
+}
+
+Error ExecuTorchResource::_cast_tensor(ExecuTorchScalarType dtype, ExecuTorchTensor &r_tensor) {
+	if (r_tensor.dtype == dtype) {
+		return OK;
+	}
+	// Casting would clamp raw bytes instead of reading them, e.g. int8 0x80 as 127
+	if (r_tensor.reinterpret(dtype, r_tensor.get_element_count())) {
+		return OK;
+	}
+	ExecuTorchTensor converted;
+	Error err = r_tensor.convert(dtype, converted, r_tensor.scale, r_tensor.zero_point);
+	if (err != OK) {
+		return err;
+	}
+	r_tensor = converted;
+	return OK;
 }
 
 // ExecuTorchModule implementation
 ExecuTorchModule::ExecuTorchModule() :
-		is_loaded_(false), native_module_(nullptr) {
+		is_loaded_(false), native_executor_enabled_(true), native_executor_(nullptr), runtime_module_(nullptr), memory_runtime_(nullptr), memory_account_(nullptr) {
 }
 
 ExecuTorchModule::~ExecuTorchModule() {
@@ -353,7 +1550,7 @@ Error ExecuTorchModule::load(const String &file_path) {
 	return load_from_buffer(buffer);
 }
 
-Error ExecuTorchModule::load_from_buffer(const PackedByteArray &buffer) {
+Error ExecuTorchModule::load_from_buffer(const PackedByteArray &buffer, const ExecuTorchProgramInfo *prepared_info) {
 	print_line("ExecuTorchModule loading from buffer (" + itos(buffer.size()) + " bytes)");
 
 	if (buffer.size() < 16) { // Minimum .pte file size
@@ -361,8 +1558,41 @@ Error ExecuTorchModule::load_from_buffer(const PackedByteArray &buffer) {
 		return FAILED;
 	}
 
-	// Mock successful load
+	// Buffers without a program header are accepted by the mock module
+	program_info_ = ExecuTorchProgramInfo();
+	if (prepared_info) {
+		program_info_ = *prepared_info;
+	} else if (ExecuTorchPTEParser::has_program_identifier(buffer.ptr(), buffer.size())) {
+		Error err = ExecuTorchPTEParser::parse(buffer.ptr(), buffer.size(), program_info_);
+		if (err != OK) {
+			print_error("Failed to parse ExecuTorch program header");
+			return err;
+		}
+	}
+
 	buffer_data_ = buffer;
+	bool has_program = ExecuTorchPTEParser::has_program_identifier(buffer.ptr(), buffer.size());
+	if (native_executor_enabled_ && has_program) {
+		// Small programs of covered ops skip the runtime's per-call overhead entirely
+		native_executor_ = memnew(ExecuTorchNativeExecutor);
+		native_executor_->set_memory_source(memory_runtime_, memory_account_);
+		if (native_executor_->load(buffer_data_.ptr(), buffer_data_.size()) != OK) {
+			print_verbose("ExecuTorchModule: native executor skipped: " + native_executor_->get_unsupported_reason());
+			memdelete(native_executor_);
+			native_executor_ = nullptr;
+		}
+	}
+	if (!native_executor_ && ExecuTorchXNNPACKModule::is_available() && has_program) {
+		// Everything else goes to the linked runtime; it reads straight from buffer_data_
+		runtime_module_ = memnew(ExecuTorchXNNPACKModule);
+		Error err = runtime_module_->load(buffer_data_.ptr(), buffer_data_.size(), memory_runtime_, memory_account_);
+		if (err != OK) {
+			memdelete(runtime_module_);
+			runtime_module_ = nullptr;
+			buffer_data_.clear();
+			return err;
+		}
+	}
 	is_loaded_ = true;
 
 	print_line("ExecuTorchModule loaded successfully");
@@ -372,49 +1602,190 @@ Error ExecuTorchModule::load_from_buffer(const PackedByteArray &buffer) {
 Dictionary ExecuTorchModule::forward(const Dictionary &inputs) {
 	ERR_FAIL_COND_V_MSG(!is_loaded_, Dictionary(), "Module not loaded");
 
+	std::vector<ExecuTorchTensor> input_tensors;
+	Array values = inputs.values();
+	for (int64_t i = 0; i < values.size(); i++) {
+		ExecuTorchTensor tensor;
+		if (ExecuTorchTensor::from_variant(values[i], tensor) == OK) {
+			input_tensors.push_back(tensor);
+		}
+	}
+
+	std::vector<ExecuTorchTensor> output_tensors;
 	Dictionary outputs;
+	if (execute(input_tensors, output_tensors) != OK) {
+		return outputs;
+	}
 
-	// Mock linear regression: y = 2x + 3
-	Array keys = inputs.keys();
-	for (int64_t i = 0; i < keys.size(); i++) {
-		Variant input_values = inputs[keys[i]];
-		if (input_values.get_type() == Variant::PACKED_FLOAT32_ARRAY) {
-			PackedFloat32Array input_array = input_values;
-			if (input_array.size() > 0) {
-				float x = input_array[0];
-				float y = 2.0f * x + 3.0f;
-
-				PackedFloat32Array output_array;
-				output_array.push_back(y);
-				outputs["output_0"] = output_array;
-			}
+	for (size_t i = 0; i < output_tensors.size(); i++) {
+		outputs["output_" + itos(i)] = output_tensors[i].to_variant();
+	}
+	return outputs;
+}
+
+Error ExecuTorchModule::prepare_plan(const std::vector<ExecuTorchTensor> &inputs, ExecuTorchExecutionPlan &r_plan) const {
+	ERR_FAIL_COND_V_MSG(!is_loaded_, ERR_UNCONFIGURED, "Module not loaded");
+
+	const uint64_t alignment = 64;
+	auto place = [&](int64_t bytes) {
+		r_plan.tensor_offsets.push_back(r_plan.arena_bytes);
+		r_plan.arena_bytes += ((uint64_t)bytes + alignment - 1) / alignment * alignment;
+	};
+
+	for (const ExecuTorchTensor &input : inputs) {
+		r_plan.input_shapes.push_back(input.shape);
+		r_plan.input_dtypes.push_back(input.dtype);
+		place(input.get_byte_size());
+	}
+
+	if (native_executor_) {
+		// Shapes are static, so the program's declared outputs are the plan
+		for (const ExecuTorchTensorInfo &output : native_executor_->get_outputs()) {
+			r_plan.output_shapes.push_back(output.shape);
+			r_plan.output_dtypes.push_back(output.dtype);
+			place(output.get_byte_size());
 		}
+		return OK;
 	}
 
-	return outputs;
+	// Mock: one float32 output per input with the same shape, matching execute()
+	for (const ExecuTorchTensor &input : inputs) {
+		r_plan.output_shapes.push_back(input.shape);
+		r_plan.output_dtypes.push_back(ExecuTorchScalarType::FLOAT32);
+		place(input.get_element_count() * ExecuTorchTensor::get_element_size(ExecuTorchScalarType::FLOAT32));
+	}
+
+	return OK;
 }
 
+Error ExecuTorchModule::execute(const std::vector<ExecuTorchTensor> &inputs, std::vector<ExecuTorchTensor> &outputs, const ExecuTorchExecutionPlan *plan) {
+	ERR_FAIL_COND_V_MSG(!is_loaded_, ERR_UNCONFIGURED, "Module not loaded");
+
+	if (native_executor_) {
+		return native_executor_->execute(inputs, outputs);
+	}
+	if (runtime_module_) {
+		return runtime_module_->execute(inputs, outputs);
+	}
+
+#ifdef TESTS_ENABLED
+	while (mock_gate_closed.load(std::memory_order_acquire)) {
+		std::this_thread::yield();
+	}
+#endif
+
+	outputs.clear();
+
+	// Mock linear regression: y = 2x + 3, elementwise on every input in float32
+	for (const ExecuTorchTensor &input : inputs) {
+		PackedFloat32Array values;
+		Error err = input.to_float32(values);
+		if (err != OK) {
+			return err;
+		}
+
+		PackedFloat32Array output_array;
+		output_array.resize(values.size());
+		ExecuTorchKernels::affine_float32(values.ptr(), output_array.ptrw(), values.size(), 2.0f, 3.0f);
+
+		const Vector<int64_t> &shape = plan ? plan->output_shapes[outputs.size()] : input.shape;
+		outputs.push_back(ExecuTorchTensor::from_float32(output_array, shape));
+	}
+
+	return OK;
+}
+
+#ifdef TESTS_ENABLED
+void ExecuTorchModule::set_mock_gate_closed(bool closed) {
+	mock_gate_closed.store(closed, std::memory_order_release);
+}
+#endif
+
 void ExecuTorchModule::unload() {
-	if (native_module_) {
-		native_module_ = nullptr;
+	if (native_executor_) {
+		memdelete(native_executor_);
+		native_executor_ = nullptr;
+	}
+	if (runtime_module_) {
+		memdelete(runtime_module_);
+		runtime_module_ = nullptr;
 	}
 	is_loaded_ = false;
 	file_path_.clear();
 	buffer_data_.clear();
+	program_info_ = ExecuTorchProgramInfo();
+}
+
+void ExecuTorchModule::set_memory_source(ExecuTorchRuntime *runtime, ExecuTorchMemoryAccount *account) {
+	memory_runtime_ = runtime;
+	memory_account_ = account;
+}
+
+bool ExecuTorchModule::has_runtime_arenas() const {
+	if (native_executor_) {
+		return native_executor_->is_runtime_memory();
+	}
+	return runtime_module_ && runtime_module_->get_planned_bytes() > 0;
+}
+
+String ExecuTorchModule::get_backend_name() const {
+	if (native_executor_) {
+		return "native";
+	}
+	return runtime_module_ ? "runtime" : "mock";
 }
 
 Array ExecuTorchModule::get_method_names() const {
 	Array methods;
-	methods.push_back("forward");
+	for (const ExecuTorchMethodInfo &method : program_info_.methods) {
+		methods.push_back(method.name);
+	}
+	if (methods.is_empty()) {
+		methods.push_back("forward");
+	}
 	return methods;
 }
 
 Dictionary ExecuTorchModule::get_method_meta(const String &method_name) const {
 	Dictionary meta;
 	meta["name"] = method_name;
+
+	const ExecuTorchMethodInfo *method = get_method_info(method_name);
+	if (!method) {
+		return meta;
+	}
+
+	Array inputs, outputs;
+	for (const ExecuTorchTensorInfo &tensor : method->inputs) {
+		inputs.push_back(tensor.to_dictionary());
+	}
+	for (const ExecuTorchTensorInfo &tensor : method->outputs) {
+		outputs.push_back(tensor.to_dictionary());
+	}
+	PackedStringArray operators, delegates;
+	for (const String &op : method->operators) {
+		operators.push_back(op);
+	}
+	for (const String &delegate : method->delegates) {
+		delegates.push_back(delegate);
+	}
+	PackedInt64Array buffer_sizes;
+	for (int64_t size : method->non_const_buffer_sizes) {
+		buffer_sizes.push_back(size);
+	}
+
+	meta["inputs"] = inputs;
+	meta["outputs"] = outputs;
+	meta["operators"] = operators;
+	meta["delegates"] = delegates;
+	meta["non_const_buffer_sizes"] = buffer_sizes;
 	return meta;
 }
 
+const ExecuTorchMethodInfo *ExecuTorchModule::get_method_info(const String &method_name) const {
+	return program_info_.find_method(method_name);
+}
+
 // ExecuTorchMemoryManager implementation
 ExecuTorchMemoryManager::ExecuTorchMemoryManager() :
 		memory_allocator_(nullptr), memory_pool_(nullptr), pool_size_(0), is_static_allocation_(false) {
@@ -30,22 +30,172 @@
 
 #pragma once
 
-#include "core/object/ref_counted.h"
+#include "core/io/resource.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/lru.h"
+#include "executorch_native_executor.h"
+#include "executorch_pte_parser.h"
+#include "executorch_runtime.h"
+#include "executorch_tensor.h"
+#include "executorch_xnnpack.h"
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <utility>
 #include <vector>
 
 class ExecuTorchModule;
 class ExecuTorchMemoryManager;
+struct ExecuTorchPreparedKey;
+
+/**
+ * ExecuTorchExecutionPlan - Shape-specific preparation for one call
+ *
+ * Built the first time a program sees a combination of input dtypes and
+ * shapes: inputs are validated against the method signature, output shapes
+ * are resolved and every tensor gets an offset in one activation arena.
+ * Later calls with the same shapes reuse it and skip all of that work.
+ */
+struct ExecuTorchExecutionPlan {
+	std::vector<Vector<int64_t>> input_shapes;
+	std::vector<ExecuTorchScalarType> input_dtypes;
+	std::vector<Vector<int64_t>> output_shapes;
+	std::vector<ExecuTorchScalarType> output_dtypes;
+
+	// Byte offsets of inputs then outputs in the activation arena
+	std::vector<uint64_t> tensor_offsets;
+	uint64_t arena_bytes = 0;
+};
+
+/**
+ * ExecuTorchCachedResult - Outputs memoized for one exact set of inputs
+ *
+ * The inputs are kept (by copy-on-write reference) so a hit can be
+ * confirmed byte for byte; the cache key is only a hash.
+ */
+struct ExecuTorchCachedResult {
+	std::vector<ExecuTorchTensor> inputs;
+	std::vector<ExecuTorchTensor> outputs;
+	ExecuTorchMemoryCharge charge; // IO bytes held by this entry
+};
+
+// Plan cache key: input count, then dtype, element count, rank and sizes of each input
+struct ExecuTorchShapeKeyHasher {
+	static _FORCE_INLINE_ uint32_t hash(const Vector<int64_t> &p_key) {
+		return hash_murmur3_buffer(p_key.ptr(), p_key.size() * sizeof(int64_t));
+	}
+};
+
+/**
+ * ExecuTorchProgram - One immutable loaded version of a model
+ *
+ * ExecuTorchResource publishes programs with an atomic shared_ptr swap.
+ * Callers take a reference for the duration of a call, so a reload never
+ * tears down a module that is still executing; the old version is freed
+ * when its last user releases it.
+ *
+ * Under runtime memory pressure an idle program can be unloaded in place:
+ * its module, plans, cached results and activations go, and the next call
+ * reloads it. Its metadata and bytes stay, so the weights stay charged. Calls hold an ExecuTorchProgramUse so a program is
+ * never unloaded under them.
+ */
+struct ExecuTorchProgram {
+	enum Residency {
+		RESIDENCY_LOADING, // Being built, not evictable yet
+		RESIDENCY_RESIDENT,
+		RESIDENCY_EVICTING,
+		RESIDENCY_EVICTED
+	};
+
+	uint64_t generation = 0;
+	PackedByteArray model_data;
+	std::unique_ptr<ExecuTorchModule> module;
+	std::shared_ptr<ExecuTorchRuntime> runtime; // Shared through ExecuTorchRuntimeRegistry
+
+	// Tagged memory of this model; declared before everything that charges it
+	std::unique_ptr<ExecuTorchMemoryAccount> memory;
+	ExecuTorchMemoryCharge weights_charge;
+	ExecuTorchMemoryCharge activations_charge; // Grows to the largest planned arena
+
+	// Model metadata
+	Array input_names;
+	Array output_names;
+	Dictionary input_shapes;
+	Dictionary output_shapes;
+	Vector<ExecuTorchTensorInfo> input_info;
+	Vector<ExecuTorchTensorInfo> output_info;
+	String model_name;
+	String model_version;
+
+	// Prepared plans for recently seen input shapes; guarded by plan_mutex
+	Mutex plan_mutex;
+	LRUCache<Vector<int64_t>, std::shared_ptr<const ExecuTorchExecutionPlan>, ExecuTorchShapeKeyHasher> plans;
+	uint64_t plan_hits = 0;
+	uint64_t plan_misses = 0;
+	uint64_t plan_evictions = 0;
+
+	// Every distinct plan built or restored, oldest first, for the prepared cache; guarded by plan_mutex
+	std::vector<std::pair<Vector<int64_t>, std::shared_ptr<const ExecuTorchExecutionPlan>>> prepared_plans;
+	std::unique_ptr<ExecuTorchPreparedKey> prepared_key; // Set when the prepared cache is enabled
+	bool prepared_hit = false;
+	double load_msec = 0.0;
+
+	// Memoized outputs of deterministic models; guarded by result_mutex
+	Mutex result_mutex;
+	LRUCache<uint64_t, std::shared_ptr<const ExecuTorchCachedResult>> results;
+	uint64_t result_hits = 0;
+	uint64_t result_misses = 0;
+	uint64_t result_evictions = 0;
+
+	// Residency under the runtime's memory ceiling; reload_mutex serializes reloads
+	std::atomic<int> residency{ RESIDENCY_LOADING };
+	std::atomic<int> active_calls{ 0 };
+	Mutex reload_mutex;
+	std::atomic<uint64_t> unloads{ 0 };
+	std::atomic<uint64_t> reloads{ 0 };
+	std::atomic<uint64_t> last_used_usec{ 0 };
+
+	// Latency of the lazy-init call made while loading, and of the latest warmup() run
+	std::atomic<double> load_call_msec{ 0.0 };
+	std::atomic<double> warmup_cold_msec{ 0.0 };
+	std::atomic<double> warmup_warm_msec{ 0.0 };
+
+	ExecuTorchProgram();
+	~ExecuTorchProgram();
+
+	bool is_resident() const { return residency.load() == RESIDENCY_RESIDENT; }
+	// Drops the module and its charged memory if no call is using it; returns bytes freed
+	size_t try_unload();
+};
+
+// Marks a call in flight for its scope, which keeps the program from being unloaded
+class ExecuTorchProgramUse {
+private:
+	ExecuTorchProgram *program_;
+
+public:
+	explicit ExecuTorchProgramUse(ExecuTorchProgram &program) :
+			program_(&program) { program_->active_calls++; }
+	~ExecuTorchProgramUse() { program_->active_calls--; }
+	ExecuTorchProgramUse(const ExecuTorchProgramUse &) = delete;
+	ExecuTorchProgramUse &operator=(const ExecuTorchProgramUse &) = delete;
+};
 
 /**
  * ExecuTorchResource - A Godot Resource for .pte (PyTorch ExecuTorch) files
  *
+ * Loaded through ResourceFormatLoaderExecuTorch, so load("model.pte") and
+ * threaded loads share one cached instance per path.
+ *
  * This resource class provides both high-level and low-level APIs for ExecuTorch models:
  * - High-level: Simple forward() method using ExecuTorch Module class
  * - Low-level: Direct memory management and placement control
  */
-class ExecuTorchResource : public RefCounted {
+class ExecuTorchResource : public Resource {
+	GDCLASS(ExecuTorchResource, Resource);
+
 public:
 	enum MemoryPolicy {
 		MEMORY_POLICY_AUTO, // Automatic memory management
@@ -59,14 +209,40 @@ public:
 		OPTIMIZATION_AGGRESSIVE = 2
 	};
 
+	enum MemoryBudgetPolicy {
+		MEMORY_BUDGET_REJECT = (int)ExecuTorchBudgetPolicy::REJECT,
+		MEMORY_BUDGET_EVICT = (int)ExecuTorchBudgetPolicy::EVICT
+	};
+
+	// Mirrors ExecuTorchScalarType for scripting
+	enum TensorType {
+		TENSOR_TYPE_UINT8 = (int)ExecuTorchScalarType::UINT8,
+		TENSOR_TYPE_INT8 = (int)ExecuTorchScalarType::INT8,
+		TENSOR_TYPE_INT16 = (int)ExecuTorchScalarType::INT16,
+		TENSOR_TYPE_INT32 = (int)ExecuTorchScalarType::INT32,
+		TENSOR_TYPE_INT64 = (int)ExecuTorchScalarType::INT64,
+		TENSOR_TYPE_FLOAT16 = (int)ExecuTorchScalarType::FLOAT16,
+		TENSOR_TYPE_FLOAT32 = (int)ExecuTorchScalarType::FLOAT32,
+		TENSOR_TYPE_FLOAT64 = (int)ExecuTorchScalarType::FLOAT64,
+		TENSOR_TYPE_BOOL = (int)ExecuTorchScalarType::BOOL,
+		TENSOR_TYPE_BFLOAT16 = (int)ExecuTorchScalarType::BFLOAT16
+	};
+
 private:
 	// Core model data
 	PackedByteArray model_data_;
 	String source_file_path_;
-	bool is_loaded_;
+
+	// Currently published program, swapped atomically on reload
+	std::shared_ptr<ExecuTorchProgram> program_;
+	std::atomic<uint64_t> next_generation_;
+
+	// Background hot swap
+	struct SwapTask;
+	Mutex swap_mutex_;
+	WorkerThreadPool::TaskID swap_task_id_;
 
 	// ExecuTorch components
-	std::unique_ptr<ExecuTorchModule> module_;
 	std::unique_ptr<ExecuTorchMemoryManager> memory_manager_;
 
 	// Configuration
@@ -74,18 +250,27 @@ private:
 	OptimizationLevel optimization_level_;
 	int64_t memory_limit_bytes_;
 	bool enable_profiling_;
+	TensorType output_type_;
+	float output_scale_;
+	int output_zero_point_;
+	std::atomic<int> plan_cache_capacity_;
+	String runtime_name_;
+	std::atomic<int64_t> memory_budget_;
+	std::atomic<int> memory_budget_policy_;
+	std::atomic<int> result_cache_capacity_;
+	std::atomic<bool> warmup_on_load_;
+	std::atomic<bool> native_executor_enabled_;
 
-	// Model metadata
-	Array input_names_;
-	Array output_names_;
-	Dictionary input_shapes_;
-	Dictionary output_shapes_;
-	String model_name_;
-	String model_version_;
+	// Streaming load state
+	std::atomic<float> load_progress_;
+	std::atomic<bool> load_cancel_requested_;
 
 	// Performance tracking
-	mutable double last_inference_time_ms_;
-	mutable int total_inferences_;
+	mutable std::atomic<double> last_inference_time_ms_;
+	mutable std::atomic<int> total_inferences_;
+
+protected:
+	static void _bind_methods();
 
 public:
 	ExecuTorchResource();
@@ -93,48 +278,151 @@ public:
 
 	// Resource interface
 	virtual Error load_from_file(const String &path);
+	// Reads the file in fixed-size chunks straight into the model buffer, updating
+	// r_progress and get_load_progress(); returns ERR_SKIP when cancelled
+	Error stream_from_file(const String &path, float *r_progress = nullptr);
+	float get_load_progress() const { return load_progress_.load(); }
+	// Stops a stream_from_file()/load_from_file() running on this resource in
+	// another thread, within one read chunk; a call with no load running has no
+	// effect on later loads. Loads through ResourceLoader build their resource
+	// out of reach until they finish, so they cannot be cancelled this way.
+	void cancel_load() { load_cancel_requested_ = true; }
 	virtual Error save_to_file(const String &path);
 	virtual void clear();
 
 	// High-level API (using ExecuTorch Module class)
 	Dictionary forward(const Dictionary &inputs);
 	Array forward_array(const Array &input_data);
+	// forward() without the Variant layer: inputs in declared order, outputs in the
+	// model's own dtypes (output_type is not applied). Safe to call from any thread.
+	Error forward_tensors(const std::vector<ExecuTorchTensor> &inputs, std::vector<ExecuTorchTensor> &r_outputs);
+	// forward()'s result for outputs from forward_tensors(): named, with output_type applied
+	Dictionary tensors_to_dictionary(const std::vector<ExecuTorchTensor> &outputs) const;
+
+	// Touches every weight page, then runs synthetic calls of the declared shapes through
+	// forward()'s path; returns {iterations, pages_touched, cold_msec, warm_msec}
+	Dictionary warmup(int iterations = 3);
+	// Writes metadata and every plan built so far to the prepared cache (see ExecuTorchPreparedCache)
+	Error save_prepared_state();
+	// Touch weights and make one lazy-init call before a load or swap is published
+	void set_warmup_on_load(bool enable) { warmup_on_load_ = enable; }
+	bool get_warmup_on_load() const { return warmup_on_load_.load(); }
+	// Run covered programs on ExecuTorchNativeExecutor instead of the runtime; applies to the next load or swap
+	void set_native_executor_enabled(bool enable) { native_executor_enabled_ = enable; }
+	bool is_native_executor_enabled() const { return native_executor_enabled_.load(); }
 
 	// Low-level API (direct ExecuTorch control)
 	Error configure_memory(MemoryPolicy policy, int64_t limit_bytes = 0);
 	Error set_optimization_level(OptimizationLevel level);
 	Error enable_profiling(bool enable);
 
+	// Output dtype; reduced-precision outputs are returned as raw PackedByteArray
+	void set_output_type(TensorType type) { output_type_ = type; }
+	TensorType get_output_type() const { return output_type_; }
+	void set_output_quantization(float scale, int zero_point);
+
+	// float32 <-> reduced-precision packing for scripts
+	static PackedByteArray encode_tensor(const PackedFloat32Array &values, TensorType type, float scale = 1.0f, int zero_point = 0);
+	static PackedFloat32Array decode_tensor(const PackedByteArray &data, TensorType type, float scale = 1.0f, int zero_point = 0);
+
 	// Model metadata
-	Array get_input_names() const { return input_names_; }
-	Array get_output_names() const { return output_names_; }
-	Dictionary get_input_shapes() const { return input_shapes_; }
-	Dictionary get_output_shapes() const { return output_shapes_; }
-	String get_model_name() const { return model_name_; }
-	String get_model_version() const { return model_version_; }
+	Array get_input_names() const;
+	Array get_output_names() const;
+	Dictionary get_input_shapes() const;
+	Dictionary get_output_shapes() const;
+	// One {name, dtype, dtype_name, shape, dynamism, element_count, byte_size} per tensor
+	Array get_input_info() const;
+	Array get_output_info() const;
+	String get_model_name() const;
+	String get_model_version() const;
 
 	// Status and diagnostics
-	bool is_loaded() const { return is_loaded_; }
+	bool is_loaded() const { return acquire_program() != nullptr; }
+	// False while the loaded program is unloaded to free memory; the next forward() reloads it
+	bool is_resident() const;
 	int64_t get_model_size() const { return model_data_.size(); }
-	double get_last_inference_time() const { return last_inference_time_ms_; }
-	int get_total_inferences() const { return total_inferences_; }
+	double get_last_inference_time() const { return last_inference_time_ms_.load(); }
+	int get_total_inferences() const { return total_inferences_.load(); }
 	Dictionary get_memory_info() const;
 
+	// Per-model budget over all tagged memory; 0 means unlimited
+	void set_memory_budget(int64_t bytes);
+	int64_t get_memory_budget() const { return memory_budget_.load(); }
+	void set_memory_budget_policy(MemoryBudgetPolicy policy);
+	MemoryBudgetPolicy get_memory_budget_policy() const { return (MemoryBudgetPolicy)memory_budget_policy_.load(); }
+
+	// Named runtime from ExecuTorchRuntimeRegistry. A loaded model is rebuilt on
+	// it, for every node sharing this resource.
+	void set_runtime_name(const String &name);
+	String get_runtime_name() const { return runtime_name_; }
+
+	// Shape-keyed execution plan cache; 0 disables it
+	void set_plan_cache_capacity(int capacity);
+	int get_plan_cache_capacity() const { return plan_cache_capacity_.load(); }
+	Dictionary get_plan_cache_stats() const;
+
+	// Opt-in result cache for deterministic models; 0 (default) disables it
+	void set_result_cache_capacity(int capacity);
+	int get_result_cache_capacity() const { return result_cache_capacity_.load(); }
+	Dictionary get_result_cache_stats() const;
+	void clear_result_cache();
+
 	// Data access
 	PackedByteArray get_model_data() const { return model_data_; }
 	void set_model_data(const PackedByteArray &data);
 	String get_source_file_path() const { return source_file_path_; }
 
+	// Hot reload: build the new program off to the side, then publish it atomically
+	Error swap_model_data(const PackedByteArray &data, bool threaded = true);
+	bool is_swap_pending();
+	void wait_for_swap();
+	uint64_t get_model_generation() const;
+
+	// Snapshot of the current program; keeps it alive while the caller holds it
+	std::shared_ptr<ExecuTorchProgram> acquire_program() const { return std::atomic_load(&program_); }
+
 private:
 	// Internal implementation
-	Error _load_with_high_level_api();
-	Error _load_with_low_level_api();
-	void _extract_metadata();
+	Error _build_program(const PackedByteArray &data, uint64_t generation, std::shared_ptr<ExecuTorchProgram> &r_program);
+	// Charges weights, loads the module and charges its planned activations
+	Error _load_program(ExecuTorchProgram &program, const ExecuTorchProgramInfo *prepared_info = nullptr);
+	// Brings an unloaded program back; the caller must hold an ExecuTorchProgramUse
+	Error _make_resident(ExecuTorchProgram &program);
+	bool _publish_program(const std::shared_ptr<ExecuTorchProgram> &program);
+	void _adopt_published_data();
+	static void _swap_task(void *p_userdata);
+	void _on_swap_finished(uint64_t generation, Error result);
+	Error _load_with_high_level_api(ExecuTorchProgram &program, const ExecuTorchProgramInfo *prepared_info = nullptr);
+	Error _load_with_low_level_api(ExecuTorchProgram &program);
+	void _extract_metadata(ExecuTorchProgram &program);
+	void _restore_prepared_plans(ExecuTorchProgram &program, const std::vector<std::pair<Vector<int64_t>, ExecuTorchExecutionPlan>> &plans);
+	bool _charge_plan_arena(ExecuTorchProgram &program, uint64_t arena_bytes) const;
+	void _remember_prepared_plan(ExecuTorchProgram &program, const Vector<int64_t> &key, const std::shared_ptr<const ExecuTorchExecutionPlan> &plan) const;
+	Error _save_prepared_state(ExecuTorchProgram &program);
+	void _warm_program(ExecuTorchProgram &program);
+	Error _make_synthetic_inputs(const ExecuTorchProgram &program, std::vector<ExecuTorchTensor> &r_tensors) const;
+	static int64_t _touch_pages(const PackedByteArray &data);
+	static size_t _evict_program_memory(ExecuTorchProgram *program, size_t bytes_needed);
 	void _update_performance_stats(double inference_time) const;
-	Dictionary _convert_tensors_to_dictionary(const std::vector<void *> &tensors, const Array &names) const;
-	std::vector<void *> _convert_dictionary_to_tensors(const Dictionary &inputs) const;
+	// Residency, result cache, plan and execution shared by forward() and forward_tensors()
+	Error _forward_program(ExecuTorchProgram &program, std::vector<ExecuTorchTensor> &r_inputs, std::vector<ExecuTorchTensor> &r_outputs);
+	Dictionary _convert_tensors_to_dictionary(const std::vector<ExecuTorchTensor> &tensors, const Array &names) const;
+	Error _convert_dictionary_to_tensors(const Dictionary &inputs, const ExecuTorchProgram &program, std::vector<ExecuTorchTensor> &r_tensors) const;
+	// Looks up or builds the plan for these input shapes and applies it to the tensors
+	Error _prepare_inputs(ExecuTorchProgram &program, std::vector<ExecuTorchTensor> &r_tensors, std::shared_ptr<const ExecuTorchExecutionPlan> &r_plan) const;
+	// Checks the element count against the declared shape and casts to the declared dtype
+	static Error _conform_tensor(const ExecuTorchTensorInfo &info, ExecuTorchTensor &r_tensor);
+	static Error _cast_tensor(ExecuTorchScalarType dtype, ExecuTorchTensor &r_tensor);
+	static uint64_t _hash_inputs(uint64_t generation, const std::vector<ExecuTorchTensor> &tensors);
+	std::shared_ptr<const ExecuTorchCachedResult> _find_cached_result(ExecuTorchProgram &program, uint64_t key, const std::vector<ExecuTorchTensor> &inputs) const;
+	void _store_cached_result(ExecuTorchProgram &program, uint64_t key, const std::vector<ExecuTorchTensor> &inputs, const std::vector<ExecuTorchTensor> &outputs) const;
 };
 
+VARIANT_ENUM_CAST(ExecuTorchResource::MemoryPolicy);
+VARIANT_ENUM_CAST(ExecuTorchResource::MemoryBudgetPolicy);
+VARIANT_ENUM_CAST(ExecuTorchResource::OptimizationLevel);
+VARIANT_ENUM_CAST(ExecuTorchResource::TensorType);
+
 /**
  * ExecuTorch Module wrapper - High-level API
  */
@@ -144,7 +432,12 @@ private:
 	bool is_loaded_;
 	String file_path_;
 	PackedByteArray buffer_data_;
-	void *native_module_; // Actual ExecuTorch Module pointer
+	ExecuTorchProgramInfo program_info_; // Empty when the buffer has no program header
+	bool native_executor_enabled_;
+	ExecuTorchNativeExecutor *native_executor_; // Set when every op of forward is covered
+	ExecuTorchXNNPACKModule *runtime_module_; // Otherwise set when the module is built against the real runtime
+	ExecuTorchRuntime *memory_runtime_; // Where backends allocate their arenas; nullptr for the heap
+	ExecuTorchMemoryAccount *memory_account_;
 
 public:
 	ExecuTorchModule();
@@ -152,14 +445,36 @@ public:
 
 	// High-level interface matching ExecuTorch C++ Module class
 	Error load(const String &file_path);
-	Error load_from_buffer(const PackedByteArray &buffer);
+	// prepared_info, when given, replaces parsing the program header
+	Error load_from_buffer(const PackedByteArray &buffer, const ExecuTorchProgramInfo *prepared_info = nullptr);
 	Dictionary forward(const Dictionary &inputs);
+	Error execute(const std::vector<ExecuTorchTensor> &inputs, std::vector<ExecuTorchTensor> &outputs, const ExecuTorchExecutionPlan *plan = nullptr);
+	// Resolves output shapes and lays out the activation arena for these inputs
+	Error prepare_plan(const std::vector<ExecuTorchTensor> &inputs, ExecuTorchExecutionPlan &r_plan) const;
 	void unload();
 	bool is_loaded() const { return is_loaded_; }
+	// Try the native executor before the runtime on the next load (default on)
+	void set_native_executor_enabled(bool enabled) { native_executor_enabled_ = enabled; }
+	bool is_native_executor_enabled() const { return native_executor_enabled_; }
+	// Backend arenas come from the runtime's pool and are charged to account
+	// from the next load on; both must outlive the module
+	void set_memory_source(ExecuTorchRuntime *runtime, ExecuTorchMemoryAccount *account);
+	// Whether the loaded backend charged its activations as it allocated them
+	bool has_runtime_arenas() const;
+	// "native", "runtime" or "mock"
+	String get_backend_name() const;
+	int64_t get_native_executor_bytes() const { return native_executor_ ? native_executor_->get_memory_bytes() : 0; }
 
 	// Metadata access
 	Array get_method_names() const;
 	Dictionary get_method_meta(const String &method_name = "forward") const;
+	const ExecuTorchProgramInfo &get_program_info() const { return program_info_; }
+	const ExecuTorchMethodInfo *get_method_info(const String &method_name = "forward") const;
+
+#ifdef TESTS_ENABLED
+	// While closed, mock executions wait at the gate, so tests can hold a worker mid-request
+	static void set_mock_gate_closed(bool closed);
+#endif
 };
 
 /**
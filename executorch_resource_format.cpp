@@ -0,0 +1,84 @@
+/**************************************************************************/
+/*  executorch_resource_format.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "executorch_resource_format.h"
+#include "executorch_resource.h"
+
+#include "core/object/class_db.h"
+
+Ref<Resource> ResourceFormatLoaderExecuTorch::load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
+	Ref<ExecuTorchResource> resource;
+	resource.instantiate();
+
+	Error err = resource->stream_from_file(p_path, r_progress);
+	if (r_error) {
+		*r_error = err;
+	}
+	if (err != OK) {
+		return Ref<Resource>();
+	}
+
+	return resource;
+}
+
+void ResourceFormatLoaderExecuTorch::get_recognized_extensions(List<String> *p_extensions) const {
+	p_extensions->push_back("pte");
+	p_extensions->push_back("ptez");
+}
+
+bool ResourceFormatLoaderExecuTorch::handles_type(const String &p_type) const {
+	return ClassDB::is_parent_class(p_type, "ExecuTorchResource");
+}
+
+String ResourceFormatLoaderExecuTorch::get_resource_type(const String &p_path) const {
+	String extension = p_path.get_extension().to_lower();
+	if (extension == "pte" || extension == "ptez") {
+		return "ExecuTorchResource";
+	}
+	return "";
+}
+
+Error ResourceFormatSaverExecuTorch::save(const Ref<Resource> &p_resource, const String &p_path, uint32_t p_flags) {
+	Ref<ExecuTorchResource> resource = p_resource;
+	ERR_FAIL_COND_V(resource.is_null(), ERR_INVALID_PARAMETER);
+
+	return resource->save_to_file(p_path);
+}
+
+void ResourceFormatSaverExecuTorch::get_recognized_extensions(const Ref<Resource> &p_resource, List<String> *p_extensions) const {
+	if (Object::cast_to<ExecuTorchResource>(*p_resource)) {
+		p_extensions->push_back("pte");
+		p_extensions->push_back("ptez");
+	}
+}
+
+bool ResourceFormatSaverExecuTorch::recognize(const Ref<Resource> &p_resource) const {
+	return Object::cast_to<ExecuTorchResource>(*p_resource) != nullptr;
+}
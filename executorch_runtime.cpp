@@ -29,14 +29,338 @@
 /**************************************************************************/
 
 #include "executorch_runtime.h"
+#include <algorithm>
+#include <cerrno>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace {
+
+// Allocation header; keeps the payload 16-byte aligned
+struct AllocationHeader {
+	size_t size;
+	size_t tag;
+	ExecuTorchMemoryAccount *account; // Charged instead of the runtime when set
+	size_t padding;
+};
+static_assert(sizeof(AllocationHeader) % 16 == 0, "AllocationHeader must preserve malloc alignment");
+
+std::atomic<uint64_t> use_clock(0);
+
+size_t get_page_size() {
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwPageSize;
+#elif defined(__unix__) || defined(__APPLE__)
+	long page_size = sysconf(_SC_PAGESIZE);
+	return page_size > 0 ? (size_t)page_size : 4096;
+#else
+	return 4096;
+#endif
+}
+
+size_t round_up(size_t value, size_t multiple) {
+	return (value + multiple - 1) / multiple * multiple;
+}
+
+// Prefers the node for the whole pages in the range, migrating any already faulted in
+bool bind_to_numa_node(const void *ptr, size_t size, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+	const int mpol_preferred = 1;
+	const unsigned long mpol_mf_move = 1 << 1;
+	unsigned long mask[1024 / (8 * sizeof(unsigned long))] = {};
+	const size_t bits_per_word = 8 * sizeof(unsigned long);
+	if (node < 0 || (size_t)node >= sizeof(mask) * 8 || !ptr) {
+		return false;
+	}
+
+	size_t page_size = get_page_size();
+	uintptr_t begin = round_up((uintptr_t)ptr, page_size);
+	uintptr_t end = ((uintptr_t)ptr + size) / page_size * page_size;
+	if (end <= begin) {
+		return false;
+	}
+
+	mask[node / bits_per_word] |= 1UL << (node % bits_per_word);
+	// The kernel reads one bit less than maxnode says
+	return syscall(SYS_mbind, begin, end - begin, mpol_preferred, mask, sizeof(mask) * 8 + 1, mpol_mf_move) == 0;
+#else
+	(void)ptr;
+	(void)size;
+	(void)node;
+	return false;
+#endif
+}
+
+} // namespace
+
+// ExecuTorchMemoryPool implementation
+bool ExecuTorchMemoryPool::reserve(size_t size, ExecuTorchHugePages huge_pages, bool prefault, bool lock, int numa_node) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	if (base_ || size == 0) {
+		return base_ != nullptr || size == 0;
+	}
+
+	// With a node to bind to, fault pages in only after binding so they land there
+	if (!_map(size, huge_pages, prefault && numa_node < 0)) {
+		return false;
+	}
+	if (numa_node >= 0) {
+		numa_bound_ = bind_to_numa_node(base_, size_, numa_node);
+	}
+
+	if (prefault && !prefaulted_) {
+		// Writing one byte per page faults it in now instead of during inference.
+		// Steps by the base page size since transparent huge pages are only a hint.
+		size_t page_size = get_page_size();
+		for (size_t offset = 0; offset < size_; offset += page_size) {
+			((volatile uint8_t *)base_)[offset] = 0;
+		}
+		prefaulted_ = true;
+	}
+
+	if (lock) {
+#if defined(_WIN32)
+		locked_ = VirtualLock(base_, size_) != 0;
+#elif defined(__unix__) || defined(__APPLE__)
+		locked_ = mlock(base_, size_) == 0;
+#endif
+		if (!locked_) {
+			std::cerr << "Could not lock the ExecuTorch memory pool; it may be paged out (check the locked memory limit)" << std::endl;
+		}
+	}
+	return true;
+}
+
+bool ExecuTorchMemoryPool::_map(size_t size, ExecuTorchHugePages huge_pages, bool prefault) {
+#if defined(_WIN32)
+	if (huge_pages == ExecuTorchHugePages::EXPLICIT && GetLargePageMinimum() > 0) {
+		// Needs the "Lock pages in memory" privilege; large pages are always resident
+		size_t large_size = round_up(size, GetLargePageMinimum());
+		void *mapping = VirtualAlloc(nullptr, large_size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+		if (mapping) {
+			mapping_ = mapping;
+			mapping_size_ = large_size;
+			base_ = (uint8_t *)mapping;
+			size_ = large_size;
+			huge_pages_ = true;
+			prefaulted_ = true;
+			return true;
+		}
+		std::cerr << "Large pages are unavailable for the ExecuTorch memory pool; using normal pages" << std::endl;
+	}
+
+	size = round_up(size, get_page_size());
+	void *mapping = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if (!mapping) {
+		return false;
+	}
+	mapping_ = mapping;
+	mapping_size_ = size;
+	base_ = (uint8_t *)mapping;
+	size_ = size;
+	return true;
+#elif defined(__unix__) || defined(__APPLE__)
+	int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#if defined(MAP_HUGETLB)
+	if (huge_pages == ExecuTorchHugePages::EXPLICIT) {
+		// Explicit huge pages come from vm.nr_hugepages and are populated on mapping
+		size_t huge_size = round_up(size, HUGE_PAGE_SIZE);
+		void *mapping = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+		if (mapping != MAP_FAILED) {
+			mapping_ = mapping;
+			mapping_size_ = huge_size;
+			base_ = (uint8_t *)mapping;
+			size_ = huge_size;
+			huge_pages_ = true;
+			prefaulted_ = true;
+			return true;
+		}
+	}
+#endif
+	if (huge_pages == ExecuTorchHugePages::EXPLICIT) {
+		std::cerr << "Explicit huge pages are unavailable for the ExecuTorch memory pool; using normal pages" << std::endl;
+	}
+
+#if defined(MADV_HUGEPAGE)
+	if (huge_pages != ExecuTorchHugePages::OFF) {
+		// Transparent huge pages only back 2MB-aligned ranges, so over-map and trim to alignment
+		size_t huge_size = round_up(size, HUGE_PAGE_SIZE);
+		size_t padded_size = huge_size + HUGE_PAGE_SIZE;
+		void *mapping = mmap(nullptr, padded_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+		if (mapping != MAP_FAILED) {
+			uint8_t *aligned = (uint8_t *)round_up((uintptr_t)mapping, HUGE_PAGE_SIZE);
+			size_t head = aligned - (uint8_t *)mapping;
+			if (head > 0) {
+				munmap(mapping, head);
+			}
+			size_t tail = padded_size - head - huge_size;
+			if (tail > 0) {
+				munmap(aligned + huge_size, tail);
+			}
+			mapping_ = aligned;
+			mapping_size_ = huge_size;
+			base_ = aligned;
+			size_ = huge_size;
+			huge_pages_ = madvise(aligned, huge_size, MADV_HUGEPAGE) == 0;
+			// Populating here would fault in small pages before khugepaged sees the hint, so reserve() touches them instead
+			return true;
+		}
+		// The padding can be what does not fit; an exact mapping of normal pages may still
+		std::cerr << "Could not map an aligned huge page pool for ExecuTorch; using normal pages" << std::endl;
+	}
+#endif
+
+#if defined(MAP_POPULATE)
+	if (prefault) {
+		flags |= MAP_POPULATE;
+	}
+#endif
+	size = round_up(size, get_page_size());
+	void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+	mapping_ = mapping;
+	mapping_size_ = size;
+	base_ = (uint8_t *)mapping;
+	size_ = size;
+#if defined(MAP_POPULATE)
+	prefaulted_ = prefault;
+#endif
+	return true;
+#else
+	// No virtual memory API; a heap block still gives one contiguous, pre-touchable pool
+	void *mapping = std::malloc(size + ALIGNMENT);
+	if (!mapping) {
+		return false;
+	}
+	mapping_ = mapping;
+	mapping_size_ = size + ALIGNMENT;
+	base_ = (uint8_t *)round_up((uintptr_t)mapping, ALIGNMENT);
+	size_ = size;
+	return true;
+#endif
+}
+
+void ExecuTorchMemoryPool::_unmap() {
+#if defined(_WIN32)
+	VirtualFree(mapping_, 0, MEM_RELEASE);
+#elif defined(__unix__) || defined(__APPLE__)
+	munmap(mapping_, mapping_size_);
+#else
+	std::free(mapping_);
+#endif
+}
+
+bool ExecuTorchMemoryPool::release() {
+	std::lock_guard<std::mutex> guard(mutex_);
+	if (!base_) {
+		return true;
+	}
+	if (live_ > 0) {
+		std::cerr << "ExecuTorch memory pool still has " << live_ << " allocations; keeping it mapped" << std::endl;
+		return false;
+	}
+
+	_unmap();
+	mapping_ = nullptr;
+	mapping_size_ = 0;
+	base_ = nullptr;
+	size_ = 0;
+	offset_ = 0;
+	peak_ = 0;
+	huge_pages_ = false;
+	prefaulted_ = false;
+	locked_ = false;
+	numa_bound_ = false;
+	return true;
+}
+
+void *ExecuTorchMemoryPool::allocate(size_t size) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	if (!base_) {
+		return nullptr;
+	}
+
+	size_t aligned = round_up(size, ALIGNMENT);
+	if (aligned > size_ - offset_) {
+		fallbacks_++;
+		return nullptr;
+	}
+
+	void *ptr = base_ + offset_;
+	offset_ += aligned;
+	peak_ = std::max(peak_, offset_);
+	live_++;
+	return ptr;
+}
+
+void ExecuTorchMemoryPool::deallocate(void *ptr) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	if (!ptr || live_ == 0) {
+		return;
+	}
+
+	// Everything is reclaimed at once when the last allocation goes
+	if (--live_ == 0) {
+		offset_ = 0;
+	}
+}
+
+ExecuTorchMemoryPool::Stats ExecuTorchMemoryPool::get_stats() const {
+	std::lock_guard<std::mutex> guard(mutex_);
+	Stats stats;
+	stats.size = size_;
+	stats.used = offset_;
+	stats.peak = peak_;
+	stats.allocations = live_;
+	stats.fallbacks = fallbacks_;
+	stats.huge_pages = huge_pages_;
+	stats.prefaulted = prefaulted_;
+	stats.locked = locked_;
+	stats.numa_bound = numa_bound_;
+	return stats;
+}
 
 ExecuTorchRuntime::ExecuTorchRuntime() {
 	is_initialized_ = false;
 	device_ = ExecuTorchDevice::CPU;
 	memory_pool_size_ = 1024 * 1024 * 64; // 64MB default
 	num_threads_ = 1;
+	huge_pages_ = ExecuTorchHugePages::OFF;
+	prefault_pool_ = false;
+	lock_pool_ = false;
+	numa_node_ = -1;
+	thread_priority_ = ExecuTorchThreadPriority::DEFAULT;
+	thread_policy_warned_ = false;
+	request_queue_capacity_ = 256;
+	request_workers_ = 1;
+	for (std::atomic<size_t> &usage : usage_) {
+		usage = 0;
+	}
+	memory_budget_ = 0;
+	budget_policy_ = (int)ExecuTorchBudgetPolicy::REJECT;
+	rejections_ = 0;
 }
 
 ExecuTorchRuntime::~ExecuTorchRuntime() {
@@ -85,20 +409,99 @@ void ExecuTorchRuntime::shutdown() {
 	std::cout << "ExecuTorch runtime shutdown" << std::endl;
 }
 
-void *ExecuTorchRuntime::allocate_memory(size_t size) {
-	// Simple malloc for now - in real implementation would use memory pool
-	return std::malloc(size);
+void *ExecuTorchRuntime::allocate_memory(size_t size, ExecuTorchMemoryTag tag, ExecuTorchMemoryAccount *account) {
+	if (account ? !account->charge(tag, size) : !reserve(tag, size)) {
+		return nullptr;
+	}
+
+	AllocationHeader *header = nullptr;
+	if (tag == ExecuTorchMemoryTag::ACTIVATIONS || tag == ExecuTorchMemoryTag::SCRATCH) {
+		header = (AllocationHeader *)memory_pool_.allocate(sizeof(AllocationHeader) + size);
+	}
+	if (!header) {
+		header = (AllocationHeader *)std::malloc(sizeof(AllocationHeader) + size);
+	}
+	if (!header) {
+		if (account) {
+			account->release(tag, size);
+		} else {
+			release(tag, size);
+		}
+		return nullptr;
+	}
+	header->size = size;
+	header->tag = (size_t)tag;
+	header->account = account;
+	return header + 1;
 }
 
 void ExecuTorchRuntime::deallocate_memory(void *ptr) {
 	if (ptr) {
-		std::free(ptr);
+		AllocationHeader *header = (AllocationHeader *)ptr - 1;
+		if (header->account) {
+			header->account->release((ExecuTorchMemoryTag)header->tag, header->size);
+		} else {
+			release((ExecuTorchMemoryTag)header->tag, header->size);
+		}
+		if (memory_pool_.owns(header)) {
+			memory_pool_.deallocate(header);
+		} else {
+			std::free(header);
+		}
+	}
+}
+
+bool ExecuTorchRuntime::reserve(ExecuTorchMemoryTag tag, size_t bytes) {
+	// Count first, then check, so concurrent reservations can never overshoot together
+	usage_[(int)tag] += bytes;
+	size_t budget = memory_budget_.load();
+	if (budget == 0 || get_memory_usage() <= budget) {
+		return true;
+	}
+
+	if (get_budget_policy() == ExecuTorchBudgetPolicy::EVICT) {
+		_evict(get_memory_usage() - budget);
+		if (get_memory_usage() <= budget) {
+			return true;
+		}
+	}
+
+	usage_[(int)tag] -= bytes;
+	rejections_++;
+	return false;
+}
+
+void ExecuTorchRuntime::release(ExecuTorchMemoryTag tag, size_t bytes) {
+	usage_[(int)tag] -= bytes;
+}
+
+size_t ExecuTorchRuntime::_evict(size_t bytes_needed) {
+	std::lock_guard<std::mutex> lock(accounts_mutex_);
+
+	std::vector<ExecuTorchMemoryAccount *> order = accounts_;
+	std::sort(order.begin(), order.end(), [](ExecuTorchMemoryAccount *a, ExecuTorchMemoryAccount *b) {
+		return a->get_last_used() < b->get_last_used();
+	});
+
+	size_t freed = 0;
+	for (ExecuTorchMemoryAccount *account : order) {
+		if (freed >= bytes_needed) {
+			break;
+		}
+		freed += account->evict(bytes_needed - freed);
 	}
+	return freed;
+}
+
+int ExecuTorchRuntime::get_account_count() {
+	std::lock_guard<std::mutex> lock(accounts_mutex_);
+	return (int)accounts_.size();
 }
 
 void ExecuTorchRuntime::clear_memory_pool() {
-	// Implementation would clear the actual memory pool
-	std::cout << "Memory pool cleared" << std::endl;
+	if (memory_pool_.release()) {
+		std::cout << "Memory pool cleared" << std::endl;
+	}
 }
 
 double ExecuTorchRuntime::get_last_inference_time() const {
@@ -107,8 +510,11 @@ double ExecuTorchRuntime::get_last_inference_time() const {
 }
 
 size_t ExecuTorchRuntime::get_memory_usage() const {
-	// Placeholder - would return actual memory usage
-	return 0;
+	size_t total = 0;
+	for (const std::atomic<size_t> &usage : usage_) {
+		total += usage.load();
+	}
+	return total;
 }
 
 bool ExecuTorchRuntime::_initialize_device() {
@@ -131,10 +537,429 @@ bool ExecuTorchRuntime::_initialize_device() {
 
 bool ExecuTorchRuntime::_setup_memory_pool() {
 	std::cout << "Setting up memory pool of size: " << memory_pool_size_ << " bytes" << std::endl;
+	if (!memory_pool_.reserve(memory_pool_size_, huge_pages_, prefault_pool_, lock_pool_, numa_node_)) {
+		return false;
+	}
+
+	ExecuTorchMemoryPool::Stats stats = memory_pool_.get_stats();
+	if (stats.size > 0) {
+		std::cout << "Memory pool reserved: " << stats.size << " bytes"
+				  << (stats.huge_pages ? ", huge pages" : "")
+				  << (stats.prefaulted ? ", pre-faulted" : "")
+				  << (stats.locked ? ", locked" : "")
+				  << (stats.numa_bound ? ", NUMA bound" : "") << std::endl;
+		if (numa_node_ >= 0 && !stats.numa_bound) {
+			_warn_thread_policy("NUMA placement");
+		}
+	}
 	return true;
 }
 
 bool ExecuTorchRuntime::_configure_threading() {
-	std::cout << "Configuring " << num_threads_ << " threads" << std::endl;
+	thread_cpus_ = cpu_affinity_;
+	if (thread_cpus_.empty() && numa_node_ >= 0) {
+		// Threads follow their memory: default to every CPU of the node
+		std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(numa_node_) + "/cpulist");
+		std::string list;
+		if (std::getline(cpulist, list)) {
+			thread_cpus_ = parse_cpu_list(list);
+		}
+	}
+
+	if (!thread_cpus_.empty() && num_threads_ > (int)thread_cpus_.size()) {
+		num_threads_ = (int)thread_cpus_.size();
+	}
+
+	std::cout << "Configuring " << num_threads_ << " threads";
+	if (!thread_cpus_.empty()) {
+		std::cout << " on " << thread_cpus_.size() << " CPUs";
+	}
+	if (numa_node_ >= 0) {
+		std::cout << ", NUMA node " << numa_node_;
+	}
+	std::cout << std::endl;
 	return true;
 }
+
+void ExecuTorchRuntime::_warn_thread_policy(const char *what) {
+	// Usually missing privileges or hardware; say so once rather than on every call
+	if (!thread_policy_warned_.exchange(true)) {
+		std::cerr << "Could not apply ExecuTorch runtime " << what << "; continuing without it" << std::endl;
+	}
+}
+
+bool ExecuTorchRuntime::bind_memory(const void *ptr, size_t size) {
+	if (numa_node_ < 0) {
+		return false;
+	}
+	return bind_to_numa_node(ptr, size, numa_node_);
+}
+
+std::vector<int> ExecuTorchRuntime::parse_cpu_list(const std::string &list) {
+	std::vector<int> cpus;
+	std::stringstream stream(list);
+	std::string item;
+	while (std::getline(stream, item, ',')) {
+		int first = 0;
+		int last = 0;
+		char dash = 0;
+		std::stringstream range(item);
+		if (!(range >> first)) {
+			continue;
+		}
+		last = first;
+		if (range >> dash && (dash != '-' || !(range >> last))) {
+			continue;
+		}
+		for (int cpu = std::max(first, 0); cpu <= last && cpu < 1024; cpu++) {
+			cpus.push_back(cpu);
+		}
+	}
+
+	std::sort(cpus.begin(), cpus.end());
+	cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+	return cpus;
+}
+
+// ExecuTorchThreadScope implementation
+ExecuTorchThreadScope::ExecuTorchThreadScope(ExecuTorchRuntime *runtime) :
+		runtime_(runtime) {
+	if (!runtime_ || !runtime_->has_thread_policy()) {
+		return;
+	}
+
+	const std::vector<int> &cpus = runtime_->thread_cpus_;
+	if (!cpus.empty()) {
+#if defined(_WIN32)
+		DWORD_PTR mask = 0;
+		for (int cpu : cpus) {
+			if (cpu < (int)(8 * sizeof(DWORD_PTR))) {
+				mask |= (DWORD_PTR)1 << cpu;
+			}
+		}
+		DWORD_PTR previous = mask ? SetThreadAffinityMask(GetCurrentThread(), mask) : 0;
+		previous_affinity_[0] = previous;
+		affinity_applied_ = previous != 0;
+#elif defined(__linux__)
+		static_assert(sizeof(cpu_set_t) <= sizeof(previous_affinity_), "cpu_set_t does not fit the saved affinity");
+		cpu_set_t *previous = (cpu_set_t *)previous_affinity_;
+		if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), previous) == 0) {
+			cpu_set_t wanted;
+			CPU_ZERO(&wanted);
+			for (int cpu : cpus) {
+				if (cpu < CPU_SETSIZE) {
+					CPU_SET(cpu, &wanted);
+				}
+			}
+			affinity_applied_ = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &wanted) == 0;
+		}
+#endif
+		if (!affinity_applied_) {
+			runtime_->_warn_thread_policy("CPU affinity");
+		}
+	}
+
+	switch (runtime_->thread_priority_) {
+		case ExecuTorchThreadPriority::DEFAULT:
+			break;
+		case ExecuTorchThreadPriority::HIGH:
+		case ExecuTorchThreadPriority::REALTIME: {
+			bool realtime = runtime_->thread_priority_ == ExecuTorchThreadPriority::REALTIME;
+#if defined(_WIN32)
+			previous_priority_ = GetThreadPriority(GetCurrentThread());
+			priority_applied_ = SetThreadPriority(GetCurrentThread(), realtime ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_ABOVE_NORMAL) != 0;
+#elif defined(__unix__) || defined(__APPLE__)
+			if (realtime) {
+				sched_param param;
+				if (pthread_getschedparam(pthread_self(), &previous_policy_, &param) == 0) {
+					previous_priority_ = param.sched_priority;
+					sched_param wanted;
+					wanted.sched_priority = sched_get_priority_min(SCHED_FIFO);
+					priority_applied_ = pthread_setschedparam(pthread_self(), SCHED_FIFO, &wanted) == 0;
+				}
+			} else {
+#if defined(__linux__)
+				// Linux keeps a nice value per thread
+				id_t tid = (id_t)syscall(SYS_gettid);
+				errno = 0;
+				previous_priority_ = getpriority(PRIO_PROCESS, tid);
+				previous_policy_ = -1;
+				if (errno == 0 && previous_priority_ > -5) {
+					priority_applied_ = setpriority(PRIO_PROCESS, tid, -5) == 0;
+				}
+#endif
+			}
+#endif
+			if (!priority_applied_) {
+				runtime_->_warn_thread_policy("thread priority");
+			}
+		} break;
+	}
+}
+
+ExecuTorchThreadScope::~ExecuTorchThreadScope() {
+	if (affinity_applied_) {
+#if defined(_WIN32)
+		SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)previous_affinity_[0]);
+#elif defined(__linux__)
+		pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), (cpu_set_t *)previous_affinity_);
+#endif
+	}
+
+	if (priority_applied_) {
+#if defined(_WIN32)
+		SetThreadPriority(GetCurrentThread(), previous_priority_);
+#elif defined(__unix__) || defined(__APPLE__)
+		if (previous_policy_ < 0) {
+#if defined(__linux__)
+			setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), previous_priority_);
+#endif
+		} else {
+			sched_param param;
+			param.sched_priority = previous_priority_;
+			pthread_setschedparam(pthread_self(), previous_policy_, &param);
+		}
+#endif
+	}
+}
+
+// ExecuTorchMemoryAccount implementation
+ExecuTorchMemoryAccount::ExecuTorchMemoryAccount(ExecuTorchRuntime *runtime, const std::string &name) :
+		runtime_(runtime), name_(name) {
+	for (std::atomic<size_t> &usage : usage_) {
+		usage = 0;
+	}
+	budget_ = 0;
+	policy_ = (int)ExecuTorchBudgetPolicy::REJECT;
+	last_used_ = ++use_clock;
+	rejections_ = 0;
+	evicted_bytes_ = 0;
+
+	if (runtime_) {
+		std::lock_guard<std::mutex> lock(runtime_->accounts_mutex_);
+		runtime_->accounts_.push_back(this);
+		registered_ = true;
+	}
+}
+
+ExecuTorchMemoryAccount::~ExecuTorchMemoryAccount() {
+	if (!runtime_) {
+		return;
+	}
+
+	detach();
+
+	// Anything still charged leaves with the model
+	for (int tag = 0; tag < (int)ExecuTorchMemoryTag::MAX; tag++) {
+		runtime_->release((ExecuTorchMemoryTag)tag, usage_[tag].load());
+	}
+}
+
+void ExecuTorchMemoryAccount::detach() {
+	if (!runtime_) {
+		return;
+	}
+
+	// Waits for an eviction pass that may be using this account to finish
+	std::lock_guard<std::mutex> lock(runtime_->accounts_mutex_);
+	if (registered_) {
+		std::vector<ExecuTorchMemoryAccount *> &accounts = runtime_->accounts_;
+		accounts.erase(std::remove(accounts.begin(), accounts.end(), this), accounts.end());
+		registered_ = false;
+	}
+}
+
+bool ExecuTorchMemoryAccount::charge(ExecuTorchMemoryTag tag, size_t bytes) {
+	if (bytes == 0) {
+		return true;
+	}
+	touch();
+
+	usage_[(int)tag] += bytes;
+	size_t budget = budget_.load();
+	if (budget > 0 && get_total_usage() > budget) {
+		if (get_policy() == ExecuTorchBudgetPolicy::EVICT) {
+			evict(get_total_usage() - budget);
+		}
+		if (get_total_usage() > budget) {
+			usage_[(int)tag] -= bytes;
+			rejections_++;
+			return false;
+		}
+	}
+
+	if (runtime_ && !runtime_->reserve(tag, bytes)) {
+		usage_[(int)tag] -= bytes;
+		rejections_++;
+		return false;
+	}
+	return true;
+}
+
+void ExecuTorchMemoryAccount::release(ExecuTorchMemoryTag tag, size_t bytes) {
+	usage_[(int)tag] -= bytes;
+	if (runtime_) {
+		runtime_->release(tag, bytes);
+	}
+}
+
+void ExecuTorchMemoryAccount::set_evictor(const Evictor &evictor) {
+	// The runtime may already be walking its accounts on another thread
+	if (runtime_) {
+		std::lock_guard<std::mutex> lock(runtime_->accounts_mutex_);
+		evictor_ = evictor;
+	} else {
+		evictor_ = evictor;
+	}
+}
+
+size_t ExecuTorchMemoryAccount::evict(size_t bytes_needed) {
+	if (!evictor_) {
+		return 0;
+	}
+	size_t freed = evictor_(bytes_needed);
+	evicted_bytes_ += freed;
+	return freed;
+}
+
+void ExecuTorchMemoryAccount::touch() {
+	last_used_ = ++use_clock;
+}
+
+size_t ExecuTorchMemoryAccount::get_total_usage() const {
+	size_t total = 0;
+	for (const std::atomic<size_t> &usage : usage_) {
+		total += usage.load();
+	}
+	return total;
+}
+
+// ExecuTorchMemoryCharge implementation
+bool ExecuTorchMemoryCharge::acquire(ExecuTorchMemoryAccount *account, ExecuTorchMemoryTag tag, size_t bytes) {
+	reset();
+	if (!account || !account->charge(tag, bytes)) {
+		return false;
+	}
+	account_ = account;
+	tag_ = tag;
+	bytes_ = bytes;
+	return true;
+}
+
+bool ExecuTorchMemoryCharge::resize(size_t bytes) {
+	if (!account_) {
+		return false;
+	}
+	if (bytes > bytes_) {
+		if (!account_->charge(tag_, bytes - bytes_)) {
+			return false;
+		}
+	} else {
+		account_->release(tag_, bytes_ - bytes);
+	}
+	bytes_ = bytes;
+	return true;
+}
+
+void ExecuTorchMemoryCharge::reset() {
+	if (account_) {
+		account_->release(tag_, bytes_);
+	}
+	account_ = nullptr;
+	bytes_ = 0;
+}
+
+// ExecuTorchRuntimeRegistry implementation
+ExecuTorchRuntimeRegistry *ExecuTorchRuntimeRegistry::get_singleton() {
+	static ExecuTorchRuntimeRegistry registry;
+	return &registry;
+}
+
+std::shared_ptr<ExecuTorchRuntime> ExecuTorchRuntimeRegistry::acquire(const std::string &name) {
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	auto found = runtimes_.find(name);
+	if (found != runtimes_.end()) {
+		return found->second;
+	}
+
+	ExecuTorchRuntimeConfig config = configs_.count(name) ? configs_[name] : default_config_;
+	int threads = config.num_threads;
+	if (threads <= 0) {
+		// Leave one core for the main thread
+		int cores = (int)std::thread::hardware_concurrency();
+		threads = cores > 1 ? cores - 1 : 1;
+	}
+
+	std::shared_ptr<ExecuTorchRuntime> runtime = std::make_shared<ExecuTorchRuntime>();
+	runtime->set_device(config.device);
+	runtime->set_memory_pool_size(config.memory_pool_size);
+	runtime->set_num_threads(threads);
+	runtime->set_memory_budget(config.memory_budget);
+	runtime->set_budget_policy(config.budget_policy);
+	runtime->set_huge_pages(config.huge_pages);
+	runtime->set_prefault_pool(config.prefault_pool);
+	runtime->set_lock_pool(config.lock_pool);
+	runtime->set_cpu_affinity(config.cpu_affinity);
+	runtime->set_numa_node(config.numa_node);
+	runtime->set_thread_priority(config.thread_priority);
+	runtime->set_request_queue_capacity(config.request_queue_capacity);
+	runtime->set_request_workers(config.request_workers);
+	if (!runtime->initialize()) {
+		std::cerr << "Failed to initialize ExecuTorch runtime '" << name << "'" << std::endl;
+		return nullptr;
+	}
+
+	std::cout << "Created shared ExecuTorch runtime '" << name << "'" << std::endl;
+	runtimes_[name] = runtime;
+	return runtime;
+}
+
+bool ExecuTorchRuntimeRegistry::has_runtime(const std::string &name) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return runtimes_.count(name) > 0;
+}
+
+std::vector<std::string> ExecuTorchRuntimeRegistry::get_runtime_names() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::vector<std::string> names;
+	for (const auto &entry : runtimes_) {
+		names.push_back(entry.first);
+	}
+	return names;
+}
+
+void ExecuTorchRuntimeRegistry::set_default_config(const ExecuTorchRuntimeConfig &config) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	default_config_ = config;
+}
+
+void ExecuTorchRuntimeRegistry::set_runtime_config(const std::string &name, const ExecuTorchRuntimeConfig &config) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	configs_[name] = config;
+}
+
+ExecuTorchRuntimeConfig ExecuTorchRuntimeRegistry::get_runtime_config(const std::string &name) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return configs_.count(name) ? configs_[name] : default_config_;
+}
+
+int ExecuTorchRuntimeRegistry::release_unused() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	int released = 0;
+	for (auto it = runtimes_.begin(); it != runtimes_.end();) {
+		if (it->second.use_count() == 1) {
+			it = runtimes_.erase(it);
+			released++;
+		} else {
+			++it;
+		}
+	}
+	return released;
+}
+
+void ExecuTorchRuntimeRegistry::clear() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	runtimes_.clear();
+	configs_.clear();
+}
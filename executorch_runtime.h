@@ -30,7 +30,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 enum class ExecuTorchDevice {
 	CPU,
@@ -39,14 +47,196 @@ enum class ExecuTorchDevice {
 	VULKAN
 };
 
+enum class ExecuTorchMemoryTag {
+	WEIGHTS, // Program data and constants
+	ACTIVATIONS, // Planned intermediate tensors
+	IO, // Input/output buffers kept alive by the runtime (e.g. cached results)
+	SCRATCH, // Temporary allocations
+	MAX
+};
+
+enum class ExecuTorchBudgetPolicy {
+	REJECT, // Fail the allocation
+	EVICT // Ask least recently used models to drop evictable memory first
+};
+
+enum class ExecuTorchHugePages {
+	OFF,
+	TRANSPARENT, // Ask the kernel to back the pool with huge pages when it can (Linux THP)
+	EXPLICIT // Map from the reserved huge page pool; falls back to normal pages if none are free
+};
+
+enum class ExecuTorchThreadPriority {
+	DEFAULT, // Leave the calling thread as it is
+	HIGH, // Above normal (a negative nice value on Linux; needs CAP_SYS_NICE or RLIMIT_NICE)
+	REALTIME // SCHED_FIFO / time critical; needs elevated privileges
+};
+// There is no LOW: an unprivileged thread that lowers its own priority cannot raise it back.
+
+class ExecuTorchRuntime;
+
+// Per-model ledger of tagged memory. Every charge also counts against the
+// runtime, so both the model and the runtime budget apply.
+class ExecuTorchMemoryAccount {
+public:
+	// Frees evictable memory (at least bytes_needed if it can); returns bytes freed
+	typedef std::function<size_t(size_t bytes_needed)> Evictor;
+
+private:
+	ExecuTorchRuntime *runtime_;
+	std::string name_;
+	std::atomic<size_t> usage_[(int)ExecuTorchMemoryTag::MAX];
+	std::atomic<size_t> budget_;
+	std::atomic<int> policy_;
+	std::atomic<uint64_t> last_used_;
+	std::atomic<uint64_t> rejections_;
+	std::atomic<uint64_t> evicted_bytes_;
+	Evictor evictor_;
+	bool registered_ = false;
+
+public:
+	ExecuTorchMemoryAccount(ExecuTorchRuntime *runtime, const std::string &name);
+	~ExecuTorchMemoryAccount();
+
+	bool charge(ExecuTorchMemoryTag tag, size_t bytes);
+	void release(ExecuTorchMemoryTag tag, size_t bytes);
+	size_t evict(size_t bytes_needed);
+	// Stops the runtime from evicting through this account; call before tearing down what the evictor touches
+	void detach();
+	void touch();
+
+	void set_evictor(const Evictor &evictor);
+	void set_budget(size_t bytes) { budget_ = bytes; }
+	size_t get_budget() const { return budget_.load(); }
+	void set_policy(ExecuTorchBudgetPolicy policy) { policy_ = (int)policy; }
+	ExecuTorchBudgetPolicy get_policy() const { return (ExecuTorchBudgetPolicy)policy_.load(); }
+
+	const std::string &get_name() const { return name_; }
+	size_t get_usage(ExecuTorchMemoryTag tag) const { return usage_[(int)tag].load(); }
+	size_t get_total_usage() const;
+	uint64_t get_last_used() const { return last_used_.load(); }
+	uint64_t get_rejections() const { return rejections_.load(); }
+	uint64_t get_evicted_bytes() const { return evicted_bytes_.load(); }
+};
+
+// Scoped charge against an account, released on destruction
+class ExecuTorchMemoryCharge {
+private:
+	ExecuTorchMemoryAccount *account_ = nullptr;
+	ExecuTorchMemoryTag tag_ = ExecuTorchMemoryTag::SCRATCH;
+	size_t bytes_ = 0;
+
+public:
+	ExecuTorchMemoryCharge() {}
+	ExecuTorchMemoryCharge(const ExecuTorchMemoryCharge &) = delete;
+	ExecuTorchMemoryCharge &operator=(const ExecuTorchMemoryCharge &) = delete;
+	~ExecuTorchMemoryCharge() { reset(); }
+
+	bool acquire(ExecuTorchMemoryAccount *account, ExecuTorchMemoryTag tag, size_t bytes);
+	// Grows or shrinks an acquired charge; on failure the old size is kept
+	bool resize(size_t bytes);
+	void reset();
+	size_t get_bytes() const { return bytes_; }
+};
+
+// One up-front mapping that activation and scratch allocations are carved
+// from, so inference never takes a first-touch page fault. Allocations are
+// bumped off the front and the whole pool rewinds once the last one is freed.
+class ExecuTorchMemoryPool {
+public:
+	static constexpr size_t ALIGNMENT = 64;
+	static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+	struct Stats {
+		size_t size = 0;
+		size_t used = 0;
+		size_t peak = 0;
+		size_t allocations = 0;
+		uint64_t fallbacks = 0; // Requests that did not fit and went to the heap
+		bool huge_pages = false;
+		bool prefaulted = false;
+		bool locked = false;
+		bool numa_bound = false;
+	};
+
+private:
+	void *mapping_ = nullptr; // What to unmap; base_ may sit past it for alignment
+	size_t mapping_size_ = 0;
+	uint8_t *base_ = nullptr;
+	size_t size_ = 0;
+	size_t offset_ = 0;
+	size_t peak_ = 0;
+	size_t live_ = 0;
+	uint64_t fallbacks_ = 0;
+	bool huge_pages_ = false;
+	bool prefaulted_ = false;
+	bool locked_ = false;
+	bool numa_bound_ = false;
+	mutable std::mutex mutex_;
+
+	bool _map(size_t size, ExecuTorchHugePages huge_pages, bool prefault);
+	void _unmap();
+
+public:
+	ExecuTorchMemoryPool() {}
+	ExecuTorchMemoryPool(const ExecuTorchMemoryPool &) = delete;
+	ExecuTorchMemoryPool &operator=(const ExecuTorchMemoryPool &) = delete;
+	~ExecuTorchMemoryPool() { release(); }
+
+	// Huge pages, pre-faulting and locking are best effort; only a failed mapping fails
+	bool reserve(size_t size, ExecuTorchHugePages huge_pages, bool prefault, bool lock, int numa_node = -1);
+	// Refuses while allocations are outstanding; returns whether the pool is gone
+	bool release();
+
+	// nullptr when the pool is missing or full
+	void *allocate(size_t size);
+	void deallocate(void *ptr);
+	bool owns(const void *ptr) const { return base_ && ptr >= base_ && ptr < base_ + size_; }
+
+	bool is_reserved() const { return base_ != nullptr; }
+	Stats get_stats() const;
+};
+
 class ExecuTorchRuntime {
 private:
 	bool is_initialized_;
 	ExecuTorchDevice device_;
 	size_t memory_pool_size_;
 	int num_threads_;
+	ExecuTorchHugePages huge_pages_;
+	bool prefault_pool_;
+	bool lock_pool_;
+	ExecuTorchMemoryPool memory_pool_;
+
+	// Thread placement; thread_cpus_ is the resolved set once initialized
+	std::vector<int> cpu_affinity_;
+	int numa_node_;
+	ExecuTorchThreadPriority thread_priority_;
+	std::vector<int> thread_cpus_;
+
+	// Shape of the ExecuTorchRequestQueue created for this runtime
+	size_t request_queue_capacity_;
+	int request_workers_;
+	std::atomic<bool> thread_policy_warned_;
+	friend class ExecuTorchThreadScope;
+
+	void _warn_thread_policy(const char *what);
+
+	// Memory accounting
+	std::atomic<size_t> usage_[(int)ExecuTorchMemoryTag::MAX];
+	std::atomic<size_t> memory_budget_;
+	std::atomic<int> budget_policy_;
+	std::atomic<uint64_t> rejections_;
+	std::mutex accounts_mutex_;
+	std::vector<ExecuTorchMemoryAccount *> accounts_;
+	friend class ExecuTorchMemoryAccount;
+
+	size_t _evict(size_t bytes_needed);
 
 public:
+	// Part of every prepared-cache key; bump when plans or metadata change meaning
+	static constexpr const char *VERSION = "0.1.0";
+
 	ExecuTorchRuntime();
 	~ExecuTorchRuntime();
 
@@ -58,18 +248,131 @@ public:
 	ExecuTorchDevice get_device() const { return device_; }
 	void set_memory_pool_size(size_t size) { memory_pool_size_ = size; }
 	size_t get_memory_pool_size() const { return memory_pool_size_; }
+	void set_huge_pages(ExecuTorchHugePages huge_pages) { huge_pages_ = huge_pages; }
+	ExecuTorchHugePages get_huge_pages() const { return huge_pages_; }
+	void set_prefault_pool(bool prefault) { prefault_pool_ = prefault; }
+	bool get_prefault_pool() const { return prefault_pool_; }
+	void set_lock_pool(bool lock) { lock_pool_ = lock; }
+	bool get_lock_pool() const { return lock_pool_; }
+	ExecuTorchMemoryPool::Stats get_memory_pool_stats() const { return memory_pool_.get_stats(); }
+
+	// Empty means any CPU (or every CPU of the NUMA node, when one is set)
+	void set_cpu_affinity(const std::vector<int> &cpus) { cpu_affinity_ = cpus; }
+	const std::vector<int> &get_cpu_affinity() const { return cpu_affinity_; }
+	const std::vector<int> &get_thread_cpus() const { return thread_cpus_; }
+	// -1 leaves placement to the OS
+	void set_numa_node(int node) { numa_node_ = node; }
+	int get_numa_node() const { return numa_node_; }
+	void set_thread_priority(ExecuTorchThreadPriority priority) { thread_priority_ = priority; }
+	ExecuTorchThreadPriority get_thread_priority() const { return thread_priority_; }
+	bool has_thread_policy() const { return !thread_cpus_.empty() || thread_priority_ != ExecuTorchThreadPriority::DEFAULT; }
+
+	// Moves the whole pages inside the range to the runtime's NUMA node; false if nothing was bound
+	bool bind_memory(const void *ptr, size_t size);
+
+	// Parses Linux cpulist syntax such as "0-3,8,10-11"; invalid entries are skipped
+	static std::vector<int> parse_cpu_list(const std::string &list);
 	void set_num_threads(int threads) { num_threads_ = threads; }
 	int get_num_threads() const { return num_threads_; }
+	// Read when the runtime's request queue is first acquired
+	void set_request_queue_capacity(size_t capacity) { request_queue_capacity_ = capacity; }
+	size_t get_request_queue_capacity() const { return request_queue_capacity_; }
+	void set_request_workers(int workers) { request_workers_ = workers; }
+	int get_request_workers() const { return request_workers_; }
 
-	void *allocate_memory(size_t size);
+	// Tagged allocations count against the runtime budget, or against account
+	// (and through it the runtime) when given; nullptr when over budget.
+	// Activations and scratch come from the memory pool while it has room.
+	void *allocate_memory(size_t size, ExecuTorchMemoryTag tag = ExecuTorchMemoryTag::SCRATCH, ExecuTorchMemoryAccount *account = nullptr);
 	void deallocate_memory(void *ptr);
 	void clear_memory_pool();
 
+	// Accounts for memory owned elsewhere (e.g. a model's data buffer)
+	bool reserve(ExecuTorchMemoryTag tag, size_t bytes);
+	void release(ExecuTorchMemoryTag tag, size_t bytes);
+
+	// 0 means unlimited
+	void set_memory_budget(size_t bytes) { memory_budget_ = bytes; }
+	size_t get_memory_budget() const { return memory_budget_.load(); }
+	void set_budget_policy(ExecuTorchBudgetPolicy policy) { budget_policy_ = (int)policy; }
+	ExecuTorchBudgetPolicy get_budget_policy() const { return (ExecuTorchBudgetPolicy)budget_policy_.load(); }
+	uint64_t get_budget_rejections() const { return rejections_.load(); }
+
 	double get_last_inference_time() const;
 	size_t get_memory_usage() const;
+	size_t get_memory_usage(ExecuTorchMemoryTag tag) const { return usage_[(int)tag].load(); }
+	int get_account_count();
 
 private:
 	bool _initialize_device();
 	bool _setup_memory_pool();
 	bool _configure_threading();
 };
+
+// Applies the runtime's CPU affinity and priority to the calling thread for
+// the lifetime of the scope and puts back what the thread had before, so
+// inference can run on engine threads without pinning them for good.
+class ExecuTorchThreadScope {
+private:
+	ExecuTorchRuntime *runtime_ = nullptr;
+	uint64_t previous_affinity_[16] = {}; // Room for a glibc cpu_set_t (1024 CPUs)
+	bool affinity_applied_ = false;
+	int previous_policy_ = 0;
+	int previous_priority_ = 0;
+	bool priority_applied_ = false;
+
+public:
+	explicit ExecuTorchThreadScope(ExecuTorchRuntime *runtime);
+	ExecuTorchThreadScope(const ExecuTorchThreadScope &) = delete;
+	ExecuTorchThreadScope &operator=(const ExecuTorchThreadScope &) = delete;
+	~ExecuTorchThreadScope();
+};
+
+// Shared runtimes are created from this; thread count 0 means one per spare core.
+struct ExecuTorchRuntimeConfig {
+	ExecuTorchDevice device = ExecuTorchDevice::CPU;
+	size_t memory_pool_size = 1024 * 1024 * 64;
+	int num_threads = 0;
+	size_t memory_budget = 0; // 0 means unlimited
+	ExecuTorchBudgetPolicy budget_policy = ExecuTorchBudgetPolicy::REJECT;
+	ExecuTorchHugePages huge_pages = ExecuTorchHugePages::OFF;
+	bool prefault_pool = false; // Fault every pool page in at startup
+	bool lock_pool = false; // Keep the pool out of swap
+	std::vector<int> cpu_affinity; // Empty means any CPU
+	int numa_node = -1; // -1 leaves placement to the OS
+	ExecuTorchThreadPriority thread_priority = ExecuTorchThreadPriority::DEFAULT;
+	size_t request_queue_capacity = 256; // Request slots before the overflow policy applies
+	int request_workers = 1; // Threads draining the request queue
+};
+
+// Process-wide set of named runtimes, so every node and resource that asks
+// for the same name shares one device, memory pool and thread set. A
+// runtime lives as long as anything holds it.
+class ExecuTorchRuntimeRegistry {
+private:
+	std::mutex mutex_;
+	std::map<std::string, std::shared_ptr<ExecuTorchRuntime>> runtimes_;
+	std::map<std::string, ExecuTorchRuntimeConfig> configs_;
+	ExecuTorchRuntimeConfig default_config_;
+
+	ExecuTorchRuntimeRegistry() {}
+
+public:
+	static constexpr const char *DEFAULT_RUNTIME = "default";
+
+	static ExecuTorchRuntimeRegistry *get_singleton();
+
+	// Creates and initializes the runtime on first use
+	std::shared_ptr<ExecuTorchRuntime> acquire(const std::string &name = DEFAULT_RUNTIME);
+	bool has_runtime(const std::string &name);
+	std::vector<std::string> get_runtime_names();
+
+	// Applies to runtimes created after the call
+	void set_default_config(const ExecuTorchRuntimeConfig &config);
+	void set_runtime_config(const std::string &name, const ExecuTorchRuntimeConfig &config);
+	ExecuTorchRuntimeConfig get_runtime_config(const std::string &name);
+
+	// Drops runtimes nobody else holds; returns how many were released
+	int release_unused();
+	void clear();
+};
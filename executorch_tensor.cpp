@@ -0,0 +1,480 @@
+/**************************************************************************/
+/*  executorch_tensor.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "executorch_tensor.h"
+#include "executorch_kernels.h"
+
+#include "core/variant/variant_internal.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#ifdef TESTS_ENABLED
+static std::atomic<uint64_t> copied_bytes(0);
+#endif
+
+static void _count_copy(int64_t bytes) {
+#ifdef TESTS_ENABLED
+	copied_bytes.fetch_add((uint64_t)bytes, std::memory_order_relaxed);
+#endif
+}
+
+static int64_t _get_storage_byte_size(const Variant &storage) {
+	switch (storage.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return VariantInternal::get_byte_array(&storage)->size();
+		case Variant::PACKED_INT32_ARRAY:
+			return VariantInternal::get_int32_array(&storage)->size() * (int64_t)sizeof(int32_t);
+		case Variant::PACKED_INT64_ARRAY:
+			return VariantInternal::get_int64_array(&storage)->size() * (int64_t)sizeof(int64_t);
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return VariantInternal::get_float32_array(&storage)->size() * (int64_t)sizeof(float);
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return VariantInternal::get_float64_array(&storage)->size() * (int64_t)sizeof(double);
+		default:
+			return 0;
+	}
+}
+
+// Allocates the packed array type that best matches the dtype and returns its writable bytes.
+static uint8_t *_allocate_storage(ExecuTorchScalarType dtype, int64_t count, Variant &r_storage) {
+	switch (dtype) {
+		case ExecuTorchScalarType::FLOAT32: {
+			r_storage = PackedFloat32Array();
+			PackedFloat32Array *array = VariantInternal::get_float32_array(&r_storage);
+			array->resize(count);
+			return (uint8_t *)array->ptrw();
+		}
+		case ExecuTorchScalarType::FLOAT64: {
+			r_storage = PackedFloat64Array();
+			PackedFloat64Array *array = VariantInternal::get_float64_array(&r_storage);
+			array->resize(count);
+			return (uint8_t *)array->ptrw();
+		}
+		case ExecuTorchScalarType::INT32: {
+			r_storage = PackedInt32Array();
+			PackedInt32Array *array = VariantInternal::get_int32_array(&r_storage);
+			array->resize(count);
+			return (uint8_t *)array->ptrw();
+		}
+		case ExecuTorchScalarType::INT64: {
+			r_storage = PackedInt64Array();
+			PackedInt64Array *array = VariantInternal::get_int64_array(&r_storage);
+			array->resize(count);
+			return (uint8_t *)array->ptrw();
+		}
+		default: {
+			r_storage = PackedByteArray();
+			PackedByteArray *array = VariantInternal::get_byte_array(&r_storage);
+			array->resize(count * ExecuTorchTensor::get_element_size(dtype));
+			return array->ptrw();
+		}
+	}
+}
+
+template <typename T>
+static void _decode_scalar(const uint8_t *src, int64_t count, float *dst) {
+	for (int64_t i = 0; i < count; i++) {
+		T value;
+		memcpy(&value, src + i * sizeof(T), sizeof(T));
+		dst[i] = (float)value;
+	}
+}
+
+template <typename T>
+static void _encode_scalar(const float *src, int64_t count, uint8_t *dst) {
+	for (int64_t i = 0; i < count; i++) {
+		T value;
+		if constexpr (std::is_integral_v<T>) {
+			// Truncates toward zero like torch.Tensor.to(), but saturates and maps
+			// NaN to 0 as the int8 quantizer does; the plain cast is undefined there.
+			const float v = src[i];
+			if (std::isnan(v)) {
+				value = 0;
+			} else if (v >= (float)std::numeric_limits<T>::max()) {
+				value = std::numeric_limits<T>::max();
+			} else if (v <= (float)std::numeric_limits<T>::min()) {
+				value = std::numeric_limits<T>::min();
+			} else {
+				value = (T)v;
+			}
+		} else {
+			value = (T)src[i];
+		}
+		memcpy(dst + i * sizeof(T), &value, sizeof(T));
+	}
+}
+
+int64_t ExecuTorchTensor::get_element_count() const {
+	if (shape.is_empty()) {
+		int64_t element_size = get_element_size(dtype);
+		return element_size > 0 ? get_byte_size() / element_size : 0;
+	}
+
+	int64_t count = 1;
+	for (int64_t dim : shape) {
+		count *= dim;
+	}
+	return count;
+}
+
+int64_t ExecuTorchTensor::get_byte_size() const {
+	return _get_storage_byte_size(storage);
+}
+
+const uint8_t *ExecuTorchTensor::get_data() const {
+	switch (storage.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return VariantInternal::get_byte_array(&storage)->ptr();
+		case Variant::PACKED_INT32_ARRAY:
+			return (const uint8_t *)VariantInternal::get_int32_array(&storage)->ptr();
+		case Variant::PACKED_INT64_ARRAY:
+			return (const uint8_t *)VariantInternal::get_int64_array(&storage)->ptr();
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return (const uint8_t *)VariantInternal::get_float32_array(&storage)->ptr();
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return (const uint8_t *)VariantInternal::get_float64_array(&storage)->ptr();
+		default:
+			return nullptr;
+	}
+}
+
+bool ExecuTorchTensor::reinterpret(ExecuTorchScalarType target, int64_t count) {
+	if (!raw || dtype == target) {
+		return false;
+	}
+	int64_t element_size = get_element_size(target);
+	if (dtype != ExecuTorchScalarType::UINT8 && get_element_size(dtype) == element_size) {
+		return false;
+	}
+	if (get_byte_size() != count * element_size) {
+		return false;
+	}
+	dtype = target;
+	raw = false;
+	return true;
+}
+
+Error ExecuTorchTensor::to_float32(PackedFloat32Array &r_values) const {
+	if (dtype == ExecuTorchScalarType::FLOAT32 && storage.get_type() == Variant::PACKED_FLOAT32_ARRAY) {
+		r_values = *VariantInternal::get_float32_array(&storage);
+		return OK;
+	}
+
+	int64_t count = get_element_count();
+	ERR_FAIL_COND_V_MSG(count * get_element_size(dtype) > get_byte_size(), ERR_INVALID_DATA, "Tensor shape does not fit its storage.");
+
+	r_values.resize(count);
+	_count_copy(count * (int64_t)sizeof(float));
+	return decode_to_float32(get_data(), dtype, count, scale, zero_point, r_values.ptrw());
+}
+
+Error ExecuTorchTensor::convert(ExecuTorchScalarType target, ExecuTorchTensor &r_tensor, float target_scale, int32_t target_zero_point) const {
+	bool quantized = target == ExecuTorchScalarType::INT8 || target == ExecuTorchScalarType::UINT8;
+	if (target == dtype && (!quantized || (target_scale == scale && target_zero_point == zero_point))) {
+		r_tensor = *this;
+		return OK;
+	}
+
+	PackedFloat32Array values;
+	Error err = to_float32(values);
+	if (err != OK) {
+		return err;
+	}
+
+	if (target == ExecuTorchScalarType::FLOAT32) {
+		r_tensor = from_float32(values, shape);
+		return OK;
+	}
+
+	ExecuTorchTensor result;
+	result.dtype = target;
+	result.shape = shape;
+	result.scale = target_scale;
+	result.zero_point = target_zero_point;
+	uint8_t *dst = _allocate_storage(target, values.size(), result.storage);
+	_count_copy(values.size() * get_element_size(target));
+	err = encode_from_float32(values.ptr(), target, values.size(), target_scale, target_zero_point, dst);
+	if (err != OK) {
+		return err;
+	}
+
+	r_tensor = result;
+	return OK;
+}
+
+Variant ExecuTorchTensor::to_variant() const {
+	Variant::Type type = storage.get_type();
+	bool natural = type == Variant::PACKED_BYTE_ARRAY ||
+			(dtype == ExecuTorchScalarType::FLOAT32 && type == Variant::PACKED_FLOAT32_ARRAY) ||
+			(dtype == ExecuTorchScalarType::FLOAT64 && type == Variant::PACKED_FLOAT64_ARRAY) ||
+			(dtype == ExecuTorchScalarType::INT32 && type == Variant::PACKED_INT32_ARRAY) ||
+			(dtype == ExecuTorchScalarType::INT64 && type == Variant::PACKED_INT64_ARRAY);
+	if (natural) {
+		return storage;
+	}
+
+	// Reinterpreted storage (e.g. fp16 packed into PackedInt32Array) goes back out as raw bytes.
+	PackedByteArray bytes;
+	bytes.resize(get_byte_size());
+	memcpy(bytes.ptrw(), get_data(), bytes.size());
+	_count_copy(bytes.size());
+	return bytes;
+}
+
+Error ExecuTorchTensor::from_variant(const Variant &value, ExecuTorchTensor &r_tensor) {
+	ExecuTorchTensor tensor;
+
+	switch (value.get_type()) {
+		case Variant::PACKED_FLOAT32_ARRAY:
+			tensor.dtype = ExecuTorchScalarType::FLOAT32;
+			tensor.storage = value;
+			break;
+		case Variant::PACKED_BYTE_ARRAY:
+			tensor.dtype = ExecuTorchScalarType::UINT8;
+			tensor.storage = value;
+			tensor.raw = true;
+			break;
+		case Variant::PACKED_INT32_ARRAY:
+			tensor.dtype = ExecuTorchScalarType::INT32;
+			tensor.storage = value;
+			tensor.raw = true;
+			break;
+		case Variant::PACKED_INT64_ARRAY:
+			tensor.dtype = ExecuTorchScalarType::INT64;
+			tensor.storage = value;
+			break;
+		case Variant::PACKED_FLOAT64_ARRAY:
+			tensor.dtype = ExecuTorchScalarType::FLOAT64;
+			tensor.storage = value;
+			break;
+		case Variant::ARRAY: {
+			PackedFloat32Array values = value;
+			_count_copy(values.size() * (int64_t)sizeof(float));
+			tensor = from_float32(values);
+		} break;
+		case Variant::FLOAT:
+		case Variant::INT: {
+			PackedFloat32Array values;
+			values.push_back((float)value);
+			tensor = from_float32(values);
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary description = value;
+			ERR_FAIL_COND_V_MSG(!description.has("data"), ERR_INVALID_PARAMETER, "Tensor dictionary needs a \"data\" entry.");
+
+			Error err = from_variant(description["data"], tensor);
+			if (err != OK) {
+				return err;
+			}
+			ERR_FAIL_COND_V_MSG(tensor.storage.get_type() == Variant::NIL, ERR_INVALID_PARAMETER, "Tensor \"data\" must be a packed array.");
+
+			if (description.has("dtype")) {
+				int type = description["dtype"];
+				ERR_FAIL_COND_V_MSG(!is_valid_type(type), ERR_INVALID_PARAMETER, "Unsupported tensor dtype: " + itos(type));
+				tensor.dtype = (ExecuTorchScalarType)type;
+				tensor.raw = false;
+			}
+			if (description.has("shape")) {
+				PackedInt64Array dims = description["shape"];
+				tensor.shape.resize(dims.size());
+				for (int64_t i = 0; i < dims.size(); i++) {
+					tensor.shape.write[i] = dims[i];
+				}
+			}
+			tensor.scale = description.get("scale", 1.0f);
+			tensor.zero_point = description.get("zero_point", 0);
+
+			int64_t element_size = get_element_size(tensor.dtype);
+			ERR_FAIL_COND_V_MSG(tensor.get_byte_size() % element_size != 0, ERR_INVALID_DATA, "Tensor data size is not a multiple of its " + get_type_name(tensor.dtype) + " element size.");
+			ERR_FAIL_COND_V_MSG(tensor.get_element_count() * element_size != tensor.get_byte_size(), ERR_INVALID_DATA, "Tensor shape does not match its data size.");
+		} break;
+		default:
+			ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Unsupported tensor value type: " + Variant::get_type_name(value.get_type()));
+	}
+
+	r_tensor = tensor;
+	return OK;
+}
+
+ExecuTorchTensor ExecuTorchTensor::from_float32(const PackedFloat32Array &values, const Vector<int64_t> &shape) {
+	ExecuTorchTensor tensor;
+	tensor.dtype = ExecuTorchScalarType::FLOAT32;
+	tensor.shape = shape;
+	tensor.storage = values;
+	return tensor;
+}
+
+#ifdef TESTS_ENABLED
+uint64_t ExecuTorchTensor::get_copied_bytes() {
+	return copied_bytes.load(std::memory_order_relaxed);
+}
+#endif
+
+bool ExecuTorchTensor::is_valid_type(int dtype) {
+	switch ((ExecuTorchScalarType)dtype) {
+		case ExecuTorchScalarType::UINT8:
+		case ExecuTorchScalarType::INT8:
+		case ExecuTorchScalarType::INT16:
+		case ExecuTorchScalarType::INT32:
+		case ExecuTorchScalarType::INT64:
+		case ExecuTorchScalarType::FLOAT16:
+		case ExecuTorchScalarType::FLOAT32:
+		case ExecuTorchScalarType::FLOAT64:
+		case ExecuTorchScalarType::BOOL:
+		case ExecuTorchScalarType::BFLOAT16:
+			return true;
+	}
+	return false;
+}
+
+int64_t ExecuTorchTensor::get_element_size(ExecuTorchScalarType dtype) {
+	switch (dtype) {
+		case ExecuTorchScalarType::UINT8:
+		case ExecuTorchScalarType::INT8:
+		case ExecuTorchScalarType::BOOL:
+			return 1;
+		case ExecuTorchScalarType::INT16:
+		case ExecuTorchScalarType::FLOAT16:
+		case ExecuTorchScalarType::BFLOAT16:
+			return 2;
+		case ExecuTorchScalarType::INT32:
+		case ExecuTorchScalarType::FLOAT32:
+			return 4;
+		case ExecuTorchScalarType::INT64:
+		case ExecuTorchScalarType::FLOAT64:
+			return 8;
+	}
+	return 0;
+}
+
+String ExecuTorchTensor::get_type_name(ExecuTorchScalarType dtype) {
+	switch (dtype) {
+		case ExecuTorchScalarType::UINT8:
+			return "uint8";
+		case ExecuTorchScalarType::INT8:
+			return "int8";
+		case ExecuTorchScalarType::INT16:
+			return "int16";
+		case ExecuTorchScalarType::INT32:
+			return "int32";
+		case ExecuTorchScalarType::INT64:
+			return "int64";
+		case ExecuTorchScalarType::FLOAT16:
+			return "float16";
+		case ExecuTorchScalarType::FLOAT32:
+			return "float32";
+		case ExecuTorchScalarType::FLOAT64:
+			return "float64";
+		case ExecuTorchScalarType::BOOL:
+			return "bool";
+		case ExecuTorchScalarType::BFLOAT16:
+			return "bfloat16";
+	}
+	return "unknown";
+}
+
+Error ExecuTorchTensor::decode_to_float32(const uint8_t *src, ExecuTorchScalarType dtype, int64_t count, float scale, int32_t zero_point, float *dst) {
+	switch (dtype) {
+		case ExecuTorchScalarType::FLOAT32:
+			memcpy(dst, src, count * sizeof(float));
+			return OK;
+		case ExecuTorchScalarType::FLOAT16:
+			ExecuTorchKernels::float16_to_float32((const uint16_t *)src, dst, count);
+			return OK;
+		case ExecuTorchScalarType::BFLOAT16:
+			ExecuTorchKernels::bfloat16_to_float32((const uint16_t *)src, dst, count);
+			return OK;
+		case ExecuTorchScalarType::INT8:
+			ExecuTorchKernels::dequantize_int8((const int8_t *)src, dst, count, scale, zero_point);
+			return OK;
+		case ExecuTorchScalarType::UINT8:
+			ExecuTorchKernels::dequantize_uint8(src, dst, count, scale, zero_point);
+			return OK;
+		case ExecuTorchScalarType::INT16:
+			_decode_scalar<int16_t>(src, count, dst);
+			return OK;
+		case ExecuTorchScalarType::INT32:
+			_decode_scalar<int32_t>(src, count, dst);
+			return OK;
+		case ExecuTorchScalarType::INT64:
+			_decode_scalar<int64_t>(src, count, dst);
+			return OK;
+		case ExecuTorchScalarType::FLOAT64:
+			_decode_scalar<double>(src, count, dst);
+			return OK;
+		case ExecuTorchScalarType::BOOL:
+			for (int64_t i = 0; i < count; i++) {
+				dst[i] = src[i] ? 1.0f : 0.0f;
+			}
+			return OK;
+	}
+	ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Unsupported tensor dtype: " + itos((int)dtype));
+}
+
+Error ExecuTorchTensor::encode_from_float32(const float *src, ExecuTorchScalarType dtype, int64_t count, float scale, int32_t zero_point, uint8_t *dst) {
+	switch (dtype) {
+		case ExecuTorchScalarType::FLOAT32:
+			memcpy(dst, src, count * sizeof(float));
+			return OK;
+		case ExecuTorchScalarType::FLOAT16:
+			ExecuTorchKernels::float32_to_float16(src, (uint16_t *)dst, count);
+			return OK;
+		case ExecuTorchScalarType::BFLOAT16:
+			ExecuTorchKernels::float32_to_bfloat16(src, (uint16_t *)dst, count);
+			return OK;
+		case ExecuTorchScalarType::INT8:
+			ExecuTorchKernels::quantize_int8(src, (int8_t *)dst, count, scale, zero_point);
+			return OK;
+		case ExecuTorchScalarType::UINT8:
+			ExecuTorchKernels::quantize_uint8(src, dst, count, scale, zero_point);
+			return OK;
+		case ExecuTorchScalarType::INT16:
+			_encode_scalar<int16_t>(src, count, dst);
+			return OK;
+		case ExecuTorchScalarType::INT32:
+			_encode_scalar<int32_t>(src, count, dst);
+			return OK;
+		case ExecuTorchScalarType::INT64:
+			_encode_scalar<int64_t>(src, count, dst);
+			return OK;
+		case ExecuTorchScalarType::FLOAT64:
+			_encode_scalar<double>(src, count, dst);
+			return OK;
+		case ExecuTorchScalarType::BOOL:
+			for (int64_t i = 0; i < count; i++) {
+				dst[i] = src[i] != 0.0f ? 1 : 0;
+			}
+			return OK;
+	}
+	ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Unsupported tensor dtype: " + itos((int)dtype));
+}
@@ -0,0 +1,97 @@
+/**************************************************************************/
+/*  executorch_tensor.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/vector.h"
+#include "core/variant/variant.h"
+#include <cstdint>
+
+// Values match ExecuTorch's ScalarType so they can be read straight from a program.
+enum class ExecuTorchScalarType : int8_t {
+	UINT8 = 0,
+	INT8 = 1,
+	INT16 = 2,
+	INT32 = 3,
+	INT64 = 4,
+	FLOAT16 = 5,
+	FLOAT32 = 6,
+	FLOAT64 = 7,
+	BOOL = 11,
+	BFLOAT16 = 15
+};
+
+/**
+ * ExecuTorchTensor - dtype-tagged tensor backed by a Godot packed array
+ *
+ * Storage holds the caller's Packed*Array by copy-on-write reference, so
+ * wrapping an input never copies its elements. The bytes may be
+ * reinterpreted (e.g. a PackedByteArray holding fp16 or int8 data).
+ * Conversions allocate a new packed array sized for the target dtype.
+ */
+struct ExecuTorchTensor {
+	ExecuTorchScalarType dtype = ExecuTorchScalarType::FLOAT32;
+	Vector<int64_t> shape;
+	Variant storage;
+
+	// Affine quantization parameters for INT8/UINT8 data
+	float scale = 1.0f;
+	int32_t zero_point = 0;
+	// The dtype was only guessed from a bare PackedByteArray or PackedInt32Array,
+	// so the bytes may hold another dtype of the same total size
+	bool raw = false;
+
+	int64_t get_element_count() const;
+	int64_t get_byte_size() const;
+	const uint8_t *get_data() const;
+
+	// Zero-copy when the tensor already holds a PackedFloat32Array
+	Error to_float32(PackedFloat32Array &r_values) const;
+	// Retags raw storage holding exactly count elements of target, without touching the bytes.
+	// Byte arrays always qualify; int32 arrays only when a value cast could not keep the count.
+	bool reinterpret(ExecuTorchScalarType target, int64_t count);
+	Error convert(ExecuTorchScalarType target, ExecuTorchTensor &r_tensor, float target_scale = 1.0f, int32_t target_zero_point = 0) const;
+	Variant to_variant() const;
+
+	// Accepts Packed*Array, Array, scalars, or a {"data", "dtype", "shape", "scale", "zero_point"} Dictionary
+	static Error from_variant(const Variant &value, ExecuTorchTensor &r_tensor);
+	static ExecuTorchTensor from_float32(const PackedFloat32Array &values, const Vector<int64_t> &shape = Vector<int64_t>());
+
+	static bool is_valid_type(int dtype);
+	static int64_t get_element_size(ExecuTorchScalarType dtype);
+	static String get_type_name(ExecuTorchScalarType dtype);
+	static Error decode_to_float32(const uint8_t *src, ExecuTorchScalarType dtype, int64_t count, float scale, int32_t zero_point, float *dst);
+	static Error encode_from_float32(const float *src, ExecuTorchScalarType dtype, int64_t count, float scale, int32_t zero_point, uint8_t *dst);
+
+#ifdef TESTS_ENABLED
+	// Process-wide total of bytes materialized by conversions; wrapping a packed array adds nothing
+	static uint64_t get_copied_bytes();
+#endif
+};
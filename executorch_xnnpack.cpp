@@ -0,0 +1,207 @@
+/**************************************************************************/
+/*  executorch_xnnpack.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "executorch_xnnpack.h"
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "executorch_runtime.h"
+
+#ifdef EXECUTORCH_XNNPACK_ENABLED
+
+#include <executorch/extension/data_loader/buffer_data_loader.h>
+#include <executorch/extension/module/module.h>
+#include <executorch/extension/tensor/tensor.h>
+#include <executorch/extension/threadpool/threadpool.h>
+#include <executorch/runtime/core/hierarchical_allocator.h>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+using executorch::aten::ScalarType;
+using executorch::aten::SizesType;
+using executorch::aten::Tensor;
+using executorch::extension::BufferDataLoader;
+using executorch::extension::Module;
+using executorch::extension::TensorPtr;
+using executorch::runtime::EValue;
+using executorch::runtime::HierarchicalAllocator;
+using executorch::runtime::MethodMeta;
+using executorch::runtime::Result;
+using executorch::runtime::Span;
+
+struct ExecuTorchXNNPACKModule::Data {
+	std::unique_ptr<Module> module;
+	// A loaded method keeps per-call state, so calls on one program take turns
+	std::mutex mutex;
+
+	// Planned buffers carved from the runtime's pool; the method points into
+	// them, so they are freed only after the module is gone
+	ExecuTorchRuntime *runtime = nullptr;
+	std::vector<Span<uint8_t>> planned_spans;
+	std::unique_ptr<HierarchicalAllocator> planned_memory;
+	uint64_t planned_bytes = 0;
+
+	~Data() {
+		module.reset();
+		planned_memory.reset();
+		for (const Span<uint8_t> &span : planned_spans) {
+			runtime->deallocate_memory(span.data());
+		}
+	}
+};
+
+ExecuTorchXNNPACKModule::~ExecuTorchXNNPACKModule() {
+	if (data_) {
+		memdelete(data_);
+	}
+}
+
+bool ExecuTorchXNNPACKModule::is_available() {
+	return true;
+}
+
+void ExecuTorchXNNPACKModule::configure_threads(int threads) {
+	// Resizing the pool under a running delegate is unsafe, so it is only done before the first load
+	static std::once_flag once;
+	std::call_once(once, [threads]() {
+		executorch::extension::threadpool::ThreadPool *pool = executorch::extension::threadpool::get_threadpool();
+		if (pool && threads > 0 && pool->get_thread_count() != (size_t)threads) {
+			pool->_unsafe_reset_threadpool(threads);
+		}
+	});
+}
+
+Error ExecuTorchXNNPACKModule::load(const uint8_t *data, size_t size, ExecuTorchRuntime *runtime, ExecuTorchMemoryAccount *account) {
+	ERR_FAIL_COND_V_MSG(data_, ERR_ALREADY_IN_USE, "ExecuTorch program already loaded.");
+
+	Data *loaded = memnew(Data);
+	loaded->module = std::make_unique<Module>(std::make_unique<BufferDataLoader>(data, size));
+	if (runtime) {
+		Result<MethodMeta> meta = loaded->module->method_meta("forward");
+		if (!meta.ok()) {
+			memdelete(loaded);
+			ERR_FAIL_V_MSG(ERR_CANT_CREATE, "ExecuTorch failed to read method 'forward' (error " + itos((int)meta.error()) + ").");
+		}
+		loaded->runtime = runtime;
+		for (size_t i = 0; i < meta->num_memory_planned_buffers(); i++) {
+			Result<int64_t> buffer_size = meta->memory_planned_buffer_size(i);
+			uint8_t *buffer = buffer_size.ok() ? (uint8_t *)runtime->allocate_memory((size_t)*buffer_size, ExecuTorchMemoryTag::ACTIVATIONS, account) : nullptr;
+			if (!buffer) {
+				memdelete(loaded);
+				ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "ExecuTorch planned buffers exceed the memory budget.");
+			}
+			loaded->planned_spans.emplace_back(buffer, (size_t)*buffer_size);
+			loaded->planned_bytes += (uint64_t)*buffer_size;
+		}
+		loaded->planned_memory = std::make_unique<HierarchicalAllocator>(Span<Span<uint8_t>>(loaded->planned_spans.data(), loaded->planned_spans.size()));
+	}
+	executorch::runtime::Error err = loaded->module->load_method("forward", loaded->planned_memory.get());
+	if (err != executorch::runtime::Error::Ok) {
+		memdelete(loaded);
+		ERR_FAIL_V_MSG(ERR_CANT_CREATE, "ExecuTorch failed to load method 'forward' (error " + itos((int)err) + ").");
+	}
+
+	data_ = loaded;
+	return OK;
+}
+
+uint64_t ExecuTorchXNNPACKModule::get_planned_bytes() const {
+	return data_ ? data_->planned_bytes : 0;
+}
+
+Error ExecuTorchXNNPACKModule::execute(const std::vector<ExecuTorchTensor> &inputs, std::vector<ExecuTorchTensor> &outputs) {
+	ERR_FAIL_NULL_V_MSG(data_, ERR_UNCONFIGURED, "ExecuTorch program not loaded.");
+
+	// Inputs are wrapped in place; the portable dtype codes match ExecuTorch's ScalarType
+	std::vector<TensorPtr> tensors;
+	std::vector<EValue> values;
+	tensors.reserve(inputs.size());
+	values.reserve(inputs.size());
+	for (const ExecuTorchTensor &input : inputs) {
+		std::vector<SizesType> sizes;
+		for (int64_t dim : input.shape) {
+			sizes.push_back((SizesType)dim);
+		}
+		tensors.push_back(executorch::extension::from_blob(const_cast<uint8_t *>(input.get_data()), sizes, (ScalarType)input.dtype));
+		values.push_back(EValue(*tensors.back()));
+	}
+
+	std::lock_guard<std::mutex> lock(data_->mutex);
+	Result<std::vector<EValue>> result = data_->module->forward(values);
+	ERR_FAIL_COND_V_MSG(!result.ok(), FAILED, "ExecuTorch execution failed (error " + itos((int)result.error()) + ").");
+
+	outputs.clear();
+	for (const EValue &value : *result) {
+		if (!value.isTensor()) {
+			continue;
+		}
+		const Tensor &tensor = value.toTensor();
+		ERR_FAIL_COND_V_MSG(!ExecuTorchTensor::is_valid_type((int)tensor.scalar_type()), ERR_INVALID_DATA, "ExecuTorch returned an unsupported output dtype.");
+
+		ExecuTorchTensor output;
+		output.dtype = (ExecuTorchScalarType)tensor.scalar_type();
+		for (ssize_t dim = 0; dim < tensor.dim(); dim++) {
+			output.shape.push_back(tensor.size(dim));
+		}
+		// Outputs live in the method's planned memory and are overwritten by the next call
+		PackedByteArray bytes;
+		bytes.resize(tensor.nbytes());
+		memcpy(bytes.ptrw(), tensor.const_data_ptr(), tensor.nbytes());
+		output.storage = bytes;
+		outputs.push_back(output);
+	}
+	return OK;
+}
+
+#else
+
+ExecuTorchXNNPACKModule::~ExecuTorchXNNPACKModule() {
+}
+
+bool ExecuTorchXNNPACKModule::is_available() {
+	return false;
+}
+
+void ExecuTorchXNNPACKModule::configure_threads(int threads) {
+}
+
+Error ExecuTorchXNNPACKModule::load(const uint8_t *data, size_t size, ExecuTorchRuntime *runtime, ExecuTorchMemoryAccount *account) {
+	return ERR_UNAVAILABLE;
+}
+
+uint64_t ExecuTorchXNNPACKModule::get_planned_bytes() const {
+	return 0;
+}
+
+Error ExecuTorchXNNPACKModule::execute(const std::vector<ExecuTorchTensor> &inputs, std::vector<ExecuTorchTensor> &outputs) {
+	return ERR_UNAVAILABLE;
+}
+
+#endif // EXECUTORCH_XNNPACK_ENABLED
@@ -0,0 +1,74 @@
+/**************************************************************************/
+/*  executorch_xnnpack.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/error/error_list.h"
+#include "executorch_tensor.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ExecuTorchMemoryAccount;
+class ExecuTorchRuntime;
+
+/**
+ * ExecuTorchXNNPACKModule - A program run by the real ExecuTorch runtime
+ *
+ * Only functional when the module is built with executorch_xnnpack=yes,
+ * which links a vendored ExecuTorch build (see scripts/build_executorch.py)
+ * and defines EXECUTORCH_XNNPACK_ENABLED. Subgraphs the exporter delegated
+ * to XNNPACK run on its optimized CPU kernels; everything else runs on
+ * ExecuTorch's portable kernels. Without that build is_available() is
+ * false and ExecuTorchModule keeps its built-in kernels.
+ */
+class ExecuTorchXNNPACKModule {
+private:
+	struct Data;
+	Data *data_ = nullptr;
+
+public:
+	ExecuTorchXNNPACKModule() {}
+	ExecuTorchXNNPACKModule(const ExecuTorchXNNPACKModule &) = delete;
+	ExecuTorchXNNPACKModule &operator=(const ExecuTorchXNNPACKModule &) = delete;
+	~ExecuTorchXNNPACKModule();
+
+	static bool is_available();
+	// XNNPACK runs on ExecuTorch's process-wide thread pool; the first call sizes it
+	static void configure_threads(int threads);
+
+	// The buffer is not copied and must outlive the module. With a runtime the
+	// method's planned buffers come from its pool and are charged to account;
+	// otherwise ExecuTorch allocates them on the heap.
+	Error load(const uint8_t *data, size_t size, ExecuTorchRuntime *runtime = nullptr, ExecuTorchMemoryAccount *account = nullptr);
+	// Planned buffer bytes taken from the runtime, 0 when they live on the heap
+	uint64_t get_planned_bytes() const;
+	Error execute(const std::vector<ExecuTorchTensor> &inputs, std::vector<ExecuTorchTensor> &outputs);
+};
@@ -29,22 +29,100 @@
 /**************************************************************************/
 
 #include "register_types.h"
+#include "core/config/project_settings.h"
 #include "core/object/class_db.h"
+#include "executorch_kernels.h"
+#include "executorch_inference_context.h"
 #include "executorch_linear_regression.h"
 #include "executorch_node.h"
+#include "executorch_pipeline.h"
+#include "executorch_prepared_cache.h"
+#include "executorch_resource.h"
+#include "executorch_resource_format.h"
+#include "executorch_runtime.h"
 #include "mcp_server.h"
 
+static Ref<ResourceFormatLoaderExecuTorch> resource_loader_executorch;
+static Ref<ResourceFormatSaverExecuTorch> resource_saver_executorch;
+
 void initialize_executorch_module(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
+	ClassDB::register_class<ExecuTorchResource>();
 	ClassDB::register_class<ModelContextProtocolServer>();
 	ClassDB::register_class<ExecuTorchNode>();
 	ClassDB::register_class<ExecuTorchLinearRegression>();
+	ClassDB::register_class<ExecuTorchPipeline>();
+	ClassDB::register_class<ExecuTorchInferenceContext>();
+	ClassDB::register_class<ExecuTorchStateSnapshot>();
+
+	// Shared runtimes are sized once per machine, not per node
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "executorch/runtime/threads", PROPERTY_HINT_RANGE, "0,256,1"), 0);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "executorch/runtime/memory_pool_size_mb", PROPERTY_HINT_RANGE, "1,4096,1,or_greater"), 64);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "executorch/runtime/memory_budget_mb", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), 0);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "executorch/runtime/budget_policy", PROPERTY_HINT_ENUM, "Reject,Evict"), 0);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "executorch/runtime/huge_pages", PROPERTY_HINT_ENUM, "Off,Transparent,Explicit"), 0);
+	GLOBAL_DEF_RST("executorch/runtime/prefault_memory_pool", false);
+	GLOBAL_DEF_RST("executorch/runtime/lock_memory_pool", false);
+	GLOBAL_DEF_RST("executorch/runtime/cpu_affinity", "");
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "executorch/runtime/numa_node", PROPERTY_HINT_RANGE, "-1,63,1"), -1);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "executorch/runtime/thread_priority", PROPERTY_HINT_ENUM, "Default,High,Realtime"), 0);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "executorch/runtime/request_queue_capacity", PROPERTY_HINT_RANGE, "1,65536,1,or_greater"), 256);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "executorch/runtime/request_workers", PROPERTY_HINT_RANGE, "1,64,1"), 1);
+
+	ExecuTorchRuntimeConfig runtime_config;
+	runtime_config.num_threads = GLOBAL_GET("executorch/runtime/threads");
+	runtime_config.memory_pool_size = (size_t)(int64_t)GLOBAL_GET("executorch/runtime/memory_pool_size_mb") * 1024 * 1024;
+	runtime_config.memory_budget = (size_t)(int64_t)GLOBAL_GET("executorch/runtime/memory_budget_mb") * 1024 * 1024;
+	runtime_config.budget_policy = (ExecuTorchBudgetPolicy)(int)GLOBAL_GET("executorch/runtime/budget_policy");
+	runtime_config.huge_pages = (ExecuTorchHugePages)(int)GLOBAL_GET("executorch/runtime/huge_pages");
+	runtime_config.prefault_pool = GLOBAL_GET("executorch/runtime/prefault_memory_pool");
+	runtime_config.lock_pool = GLOBAL_GET("executorch/runtime/lock_memory_pool");
+	runtime_config.cpu_affinity = ExecuTorchRuntime::parse_cpu_list(String(GLOBAL_GET("executorch/runtime/cpu_affinity")).utf8().get_data());
+	runtime_config.numa_node = GLOBAL_GET("executorch/runtime/numa_node");
+	runtime_config.thread_priority = (ExecuTorchThreadPriority)(int)GLOBAL_GET("executorch/runtime/thread_priority");
+	runtime_config.request_queue_capacity = (size_t)(int64_t)GLOBAL_GET("executorch/runtime/request_queue_capacity");
+	runtime_config.request_workers = GLOBAL_GET("executorch/runtime/request_workers");
+	ExecuTorchRuntimeRegistry::get_singleton()->set_default_config(runtime_config);
+
+	// Kernels pick the best instruction set at startup; a lower level can be forced for testing
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "executorch/kernels/isa_level", PROPERTY_HINT_ENUM, "Auto,Scalar,SSE2,AVX2,AVX-512,Neon"), 0);
+	int isa_level = GLOBAL_GET("executorch/kernels/isa_level");
+	if (isa_level > 0) {
+		ExecuTorchKernels::Level requested = (ExecuTorchKernels::Level)(isa_level - 1);
+		ExecuTorchKernels::Level level = ExecuTorchKernels::set_level(requested);
+		if (level != requested) {
+			WARN_PRINT(vformat("ExecuTorch kernels: %s is not supported here, using %s.", ExecuTorchKernels::get_level_name(requested), ExecuTorchKernels::get_level_name(level)));
+		}
+	}
+	print_verbose(vformat("ExecuTorch kernels: %s", ExecuTorchKernels::get_level_name(ExecuTorchKernels::get_level())));
+
+	// Prepared program state survives restarts when enabled
+	GLOBAL_DEF_RST("executorch/prepared_cache/enabled", false);
+	GLOBAL_DEF_RST("executorch/prepared_cache/directory", "user://executorch_cache");
+	if (GLOBAL_GET("executorch/prepared_cache/enabled")) {
+		ExecuTorchPreparedCache::set_directory(GLOBAL_GET("executorch/prepared_cache/directory"));
+	}
+
+	resource_loader_executorch.instantiate();
+	ResourceLoader::add_resource_format_loader(resource_loader_executorch);
+
+	resource_saver_executorch.instantiate();
+	ResourceSaver::add_resource_format_saver(resource_saver_executorch);
 }
 
 void uninitialize_executorch_module(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
+
+	ResourceLoader::remove_resource_format_loader(resource_loader_executorch);
+	resource_loader_executorch.unref();
+
+	ResourceSaver::remove_resource_format_saver(resource_saver_executorch);
+	resource_saver_executorch.unref();
+
+	ExecuTorchRuntimeRegistry::get_singleton()->clear();
+	ExecuTorchPreparedCache::set_directory(String());
 }
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""
+Build the vendored ExecuTorch runtime with the XNNPACK delegate for SCons
+
+Produces static, position independent libraries and headers in
+<source>/install, which the module links with `scons executorch_xnnpack=yes`.
+The CMake compile database is kept in <source>/cmake-out for reference.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+MODULE_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def main():
+    """Configure, build and install ExecuTorch with CMake"""
+    parser = argparse.ArgumentParser(description="Build ExecuTorch and XNNPACK for the Godot module")
+    parser.add_argument(
+        "--source",
+        default=os.path.join(MODULE_DIR, "thirdparty", "executorch"),
+        help="ExecuTorch checkout with submodules (default: thirdparty/executorch)",
+    )
+    parser.add_argument("--build-type", default="Release", choices=["Release", "RelWithDebInfo", "Debug"])
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1)
+    args = parser.parse_args()
+
+    source = os.path.abspath(args.source)
+    if not os.path.isfile(os.path.join(source, "CMakeLists.txt")):
+        print(f"❌ No ExecuTorch checkout in {source}")
+        print("git clone --recursive https://github.com/pytorch/executorch.git " + source)
+        return 1
+
+    build_dir = os.path.join(source, "cmake-out")
+    install_dir = os.path.join(source, "install")
+    configure = [
+        "cmake",
+        "-S",
+        source,
+        "-B",
+        build_dir,
+        f"-DCMAKE_BUILD_TYPE={args.build_type}",
+        f"-DCMAKE_INSTALL_PREFIX={install_dir}",
+        "-DCMAKE_POSITION_INDEPENDENT_CODE=ON",
+        "-DCMAKE_EXPORT_COMPILE_COMMANDS=ON",
+        "-DBUILD_SHARED_LIBS=OFF",
+        "-DEXECUTORCH_BUILD_XNNPACK=ON",
+        "-DEXECUTORCH_BUILD_EXTENSION_MODULE=ON",
+        "-DEXECUTORCH_BUILD_EXTENSION_DATA_LOADER=ON",
+        "-DEXECUTORCH_BUILD_EXTENSION_FLAT_TENSOR=ON",
+        "-DEXECUTORCH_BUILD_EXTENSION_TENSOR=ON",
+        "-DEXECUTORCH_BUILD_PTHREADPOOL=ON",
+        "-DEXECUTORCH_BUILD_CPUINFO=ON",
+    ]
+
+    try:
+        subprocess.run(configure, check=True)
+        subprocess.run(
+            ["cmake", "--build", build_dir, "--target", "install", "--parallel", str(args.jobs)],
+            check=True,
+        )
+    except (OSError, subprocess.CalledProcessError) as e:
+        print(f"❌ ExecuTorch build failed: {e}")
+        return 1
+
+    print(f"✅ ExecuTorch installed to {install_dir}")
+    print("Build Godot with: scons executorch_xnnpack=yes")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -4,8 +4,10 @@ Common utilities and shared code for ExecuTorch model conversion and testing
 """
 
 import os
+import subprocess
 import sys
-from typing import Tuple
+import tempfile
+from typing import Dict, List, Tuple
 
 import torch
 import torch.nn as nn
@@ -105,11 +107,16 @@ class ExecuTorchConverter:
             sys.exit(1)
 
     def convert_model(
-        self, model: nn.Module, example_input: torch.Tensor, output_path: str, verbose: bool = True
+        self,
+        model: nn.Module,
+        example_input: torch.Tensor,
+        output_path: str,
+        verbose: bool = True,
+        xnnpack: bool = False,
     ) -> bool:
-        """Convert PyTorch model to ExecuTorch format"""
+        """Convert PyTorch model to ExecuTorch format, optionally delegating to XNNPACK"""
         try:
-            from executorch.exir import to_edge
+            from executorch.exir import to_edge, to_edge_transform_and_lower
             from torch.export import export
 
             if verbose:
@@ -123,7 +130,12 @@ class ExecuTorchConverter:
             # Convert to Edge IR
             if verbose:
                 print("Converting to Edge IR...")
-            edge_program = to_edge(exported_program)
+            if xnnpack:
+                from executorch.backends.xnnpack.partition.xnnpack_partitioner import XnnpackPartitioner
+
+                edge_program = to_edge_transform_and_lower(exported_program, partitioner=[XnnpackPartitioner()])
+            else:
+                edge_program = to_edge(exported_program)
 
             # Convert to ExecuTorch format
             if verbose:
@@ -250,3 +262,33 @@ def load_executorch_runtime(model_path: str):
     except Exception as e:
         print(f"Failed to load ExecuTorch runtime: {e}")
         return None, None, None
+
+
+def run_godot_script(script: str, args: List[str], settings: Dict[str, str] = None) -> List[str]:
+    """Run a SceneTree script in a throwaway headless project, return its output lines
+
+    The Godot binary (built with this module) comes from the GODOT environment
+    variable. settings are written to project.godot as "section/key": value.
+    """
+    godot = os.environ.get("GODOT", "godot")
+    with tempfile.TemporaryDirectory() as project:
+        sections: Dict[str, List[str]] = {}
+        for name, value in (settings or {}).items():
+            section, key = name.split("/", 1)
+            sections.setdefault(section, []).append(f"{key}={value}")
+        with open(os.path.join(project, "project.godot"), "w") as f:
+            f.write("config_version=5\n")
+            for section, lines in sections.items():
+                f.write(f"\n[{section}]\n" + "\n".join(lines) + "\n")
+        with open(os.path.join(project, "benchmark.gd"), "w") as f:
+            f.write(script)
+
+        result = subprocess.run(
+            [godot, "--headless", "--path", project, "--script", "res://benchmark.gd", "--", *args],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        if result.returncode != 0:
+            raise RuntimeError(f"{godot} exited with {result.returncode}:\n{result.stderr}")
+        return result.stdout.splitlines()
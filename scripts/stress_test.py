@@ -15,6 +15,7 @@ Unified script for PyTorch to ExecuTorch conversion and validation
 """
 
 import os
+import tempfile
 
 from common_utils import (
     ExecuTorchConverter,
@@ -23,9 +24,50 @@ from common_utils import (
     SimpleLinearModel,
     get_model_path,
     load_executorch_runtime,
+    run_godot_script,
     setup_directories,
 )
 
+# Loads the model once, runs one inference and reports the time to each
+STARTUP_SCRIPT = """extends SceneTree
+
+func _init():
+    var path = OS.get_cmdline_user_args()[0]
+    var start = Time.get_ticks_usec()
+    var model = ExecuTorchResource.new()
+    var err = model.load_from_file(path)
+    var loaded = Time.get_ticks_usec()
+    var inputs = {}
+    inputs[model.get_input_names()[0]] = PackedFloat32Array([0.0, 0.0, 0.0, 0.0])
+    model.forward(inputs)
+    var first = Time.get_ticks_usec()
+    model.save_prepared_state()
+    print("STARTUP %d %d %d %s" % [err, loaded - start, first - start, model.get_memory_info().get("prepared_cache", "disabled")])
+    quit()
+"""
+
+# Times forward() on the native executor and on the runtime (or the mock
+# without a linked runtime) for the same program
+NATIVE_SCRIPT = """extends SceneTree
+
+func _init():
+    var path = OS.get_cmdline_user_args()[0]
+    var iterations = int(OS.get_cmdline_user_args()[1])
+    for native in [true, false]:
+        var model = ExecuTorchResource.new()
+        model.native_executor = native
+        var err = model.load_from_file(path)
+        var inputs = {}
+        inputs[model.get_input_names()[0]] = PackedFloat32Array([1.0, 2.0, 3.0, 4.0])
+        model.forward(inputs)
+        var start = Time.get_ticks_usec()
+        for i in iterations:
+            model.forward(inputs)
+        var usec = float(Time.get_ticks_usec() - start) / iterations
+        print("NATIVE %d %s %f" % [err, model.get_memory_info().get("module_backend", "none"), usec])
+    quit()
+"""
+
 
 def setup_model():
     """Setup and export the model"""
@@ -165,6 +207,98 @@ def benchmark_performance(model, method, num_runs=100):
         print(f"⚠️ PyTorch is {1 / speedup:.2f}x faster")
 
 
+def time_method(method, test_input, num_runs):
+    """Mean and standard deviation of one ExecuTorch method in milliseconds"""
+    for _ in range(10):
+        _ = method.execute([test_input])
+
+    times = []
+    for _ in range(num_runs):
+        start = time.perf_counter()
+        _ = method.execute([test_input])
+        end = time.perf_counter()
+        times.append(end - start)
+    return np.mean(times) * 1000, np.std(times) * 1000
+
+
+def benchmark_backends(model, num_runs=100):
+    """Benchmark the XNNPACK delegate against ExecuTorch's portable kernels"""
+    print("=== Backend Benchmark ===")
+
+    converter = ExecuTorchConverter()
+    methods = {}
+    for name, xnnpack in [("portable", False), ("xnnpack", True)]:
+        model_path = get_model_path(f"model_{name}.pte")
+        if not os.path.exists(model_path):
+            if not converter.convert_model(model, model.get_example_input(), model_path, verbose=False, xnnpack=xnnpack):
+                raise RuntimeError(f"Failed to export the {name} model")
+        _, _, methods[name] = load_executorch_runtime(model_path)
+        if methods[name] is None:
+            raise RuntimeError(f"Failed to load the {name} model")
+
+    test_input = torch.randn(1, 4)
+    portable_out = methods["portable"].execute([test_input])[0]
+    xnnpack_out = methods["xnnpack"].execute([test_input])[0]
+    if not ModelValidator().compare_outputs(portable_out, xnnpack_out, verbose=False):
+        print("⚠️ XNNPACK output differs from the portable kernels")
+
+    portable_mean, portable_std = time_method(methods["portable"], test_input, num_runs)
+    xnnpack_mean, xnnpack_std = time_method(methods["xnnpack"], test_input, num_runs)
+    speedup = portable_mean / xnnpack_mean if xnnpack_mean > 0 else 0
+
+    print(f"Portable: {portable_mean:.3f} ± {portable_std:.3f} ms")
+    print(f"XNNPACK:  {xnnpack_mean:.3f} ± {xnnpack_std:.3f} ms")
+    print(f"Speedup:  {speedup:.2f}x")
+
+
+def benchmark_startup(model_path, num_runs=5):
+    """Time model load and first inference in Godot, cold and with a warm prepared cache"""
+    print("=== Startup Benchmark ===")
+
+    model_path = os.path.abspath(model_path)
+    with tempfile.TemporaryDirectory() as cache_dir:
+        settings = {
+            "executorch/prepared_cache/enabled": "true",
+            "executorch/prepared_cache/directory": f'"{cache_dir}"',
+        }
+
+        # The first launch misses and writes the entry; every later one should hit
+        results = {"miss": [], "hit": []}
+        for _ in range(num_runs + 1):
+            for line in run_godot_script(STARTUP_SCRIPT, [model_path], settings):
+                if line.startswith("STARTUP "):
+                    err, load_us, first_us, cache = line.split()[1:]
+                    if err != "0":
+                        raise RuntimeError(f"Godot failed to load {model_path} (error {err})")
+                    results.setdefault(cache, []).append((int(load_us) / 1000, int(first_us) / 1000))
+
+    for cache in ["miss", "hit"]:
+        if not results[cache]:
+            print(f"{cache:>5}: no runs")
+            continue
+        load_ms = np.mean([r[0] for r in results[cache]])
+        first_ms = np.mean([r[1] for r in results[cache]])
+        print(f"{cache:>5}: load {load_ms:.3f} ms, first inference {first_ms:.3f} ms ({len(results[cache])} runs)")
+
+    if results["miss"] and results["hit"]:
+        cold = np.mean([r[1] for r in results["miss"]])
+        warm = np.mean([r[1] for r in results["hit"]])
+        print(f"Warm cache saves {cold - warm:.3f} ms to first inference")
+
+
+def benchmark_native(model_path, num_runs=2000):
+    """Compare the native executor with the runtime on the same program in Godot"""
+    print("=== Native Executor Benchmark ===")
+
+    model_path = os.path.abspath(model_path)
+    for line in run_godot_script(NATIVE_SCRIPT, [model_path, str(num_runs)]):
+        if line.startswith("NATIVE "):
+            err, backend, usec = line.split()[1:]
+            if err != "0":
+                raise RuntimeError(f"Godot failed to load {model_path} (error {err})")
+            print(f"{backend:>8}: {float(usec):.2f} us/call")
+
+
 def validate_outputs(model, method, tolerance=1e-5):
     """Validate that outputs match within tolerance"""
     print("=== Output Validation ===")
@@ -212,9 +346,9 @@ def main():
     parser = argparse.ArgumentParser(description="PyTorch to ExecuTorch conversion and testing")
     parser.add_argument(
         "--mode",
-        choices=["single", "stress", "benchmark", "validate", "custom", "both"],
+        choices=["single", "stress", "benchmark", "backends", "startup", "native", "validate", "custom", "both"],
         default="both",
-        help="Test mode: single test, stress test, benchmark, validate, custom input, or both",
+        help="Test mode: single test, stress test, benchmark, backend benchmark, startup benchmark, native executor benchmark, validate, custom input, or both",
     )
     parser.add_argument("--input", type=str, help="Custom input values (comma-separated, for custom mode)")
     args = parser.parse_args()
@@ -234,6 +368,15 @@ def main():
     if args.mode == "benchmark":
         benchmark_performance(model, method)
 
+    if args.mode == "backends":
+        benchmark_backends(model)
+
+    if args.mode == "startup":
+        benchmark_startup(get_model_path("model.pte"))
+
+    if args.mode == "native":
+        benchmark_native(get_model_path("model.pte"))
+
     if args.mode == "validate":
         validate_outputs(model, method)
 
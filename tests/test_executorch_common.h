@@ -0,0 +1,71 @@
+/**************************************************************************/
+/*  tests/test_executorch_common.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../executorch_resource.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace TestExecuTorch {
+
+// The 64-byte buffer the mock module recognizes; it computes output_0 = 2 * input_0 + 3
+inline PackedByteArray make_mock_model_data() {
+	PackedByteArray model_data;
+	model_data.resize(64);
+	model_data.fill(0x42);
+	return model_data;
+}
+
+// A resource with the mock model loaded; the mock always loads, so a failure fails the test
+inline Ref<ExecuTorchResource> make_mock_model() {
+	Ref<ExecuTorchResource> model;
+	model.instantiate();
+	model->set_model_data(make_mock_model_data());
+	REQUIRE(model->is_loaded());
+	return model;
+}
+
+// Saves the mock model to file_name in the OS cache directory and returns its path
+inline String save_mock_model(const String &file_name) {
+	String path = OS::get_singleton()->get_cache_path().path_join(file_name);
+	REQUIRE(make_mock_model()->save_to_file(path) == OK);
+	return path;
+}
+
+// Holds every mock execution from construction until open() or the end of the scope
+struct MockGate {
+	MockGate() { ExecuTorchModule::set_mock_gate_closed(true); }
+	~MockGate() { open(); }
+	void open() { ExecuTorchModule::set_mock_gate_closed(false); }
+};
+
+} // namespace TestExecuTorch
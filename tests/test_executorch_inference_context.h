@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*  test_executorch_inference_context.h                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../executorch_inference_context.h"
+#include "test_executorch_common.h"
+
+#include "tests/test_macros.h"
+
+namespace TestExecuTorchInferenceContext {
+
+TEST_SUITE("[ExecuTorch] ExecuTorchInferenceContext Tests") {
+	TEST_CASE("ExecuTorchInferenceContext - Persistent State") {
+		Ref<ExecuTorchResource> model = TestExecuTorch::make_mock_model();
+
+		// The mock computes output_0 = 2 * input_0 + 3, so feeding it back iterates s -> 2s + 3
+		Ref<ExecuTorchInferenceContext> context;
+		context.instantiate();
+		context->set_model(model);
+		REQUIRE(context->bind_state("input_0", "output_0") == OK);
+		CHECK(context->get_state("input_0").get_type() == Variant::NIL);
+
+		CHECK(context->step(Dictionary()).is_empty()); // The only output is state
+		PackedFloat32Array state = context->get_state("input_0");
+		REQUIRE(state.size() == 1);
+		CHECK(state[0] == doctest::Approx(3.0f));
+
+		context->step(Dictionary());
+		Ref<ExecuTorchStateSnapshot> snapshot = context->snapshot_state();
+		REQUIRE(snapshot.is_valid());
+		CHECK(snapshot->get_state_names() == PackedStringArray({ "input_0" }));
+		context->step(Dictionary());
+		CHECK(PackedFloat32Array(context->get_state("input_0"))[0] == doctest::Approx(21.0f));
+
+		SUBCASE("Restore Rewinds") {
+			REQUIRE(context->restore_state(snapshot) == OK);
+			CHECK(PackedFloat32Array(context->get_state("input_0"))[0] == doctest::Approx(9.0f));
+			context->step(Dictionary());
+			CHECK(PackedFloat32Array(context->get_state("input_0"))[0] == doctest::Approx(21.0f));
+			CHECK(context->get_step_count() == 4);
+		}
+
+		SUBCASE("Reset Starts From Zeros") {
+			context->reset_state();
+			context->step(Dictionary());
+			CHECK(PackedFloat32Array(context->get_state("input_0"))[0] == doctest::Approx(3.0f));
+		}
+
+		SUBCASE("Snapshots Keep Dtype And Shape") {
+			// 1.5 as fp16; a raw byte round trip would come back as two uint8 values
+			Dictionary half;
+			half["data"] = PackedByteArray({ 0x00, 0x3e });
+			half["dtype"] = (int)ExecuTorchScalarType::FLOAT16;
+			half["shape"] = PackedInt64Array({ 1, 1 });
+			REQUIRE(context->set_state("input_0", half) == OK);
+			Ref<ExecuTorchStateSnapshot> half_snapshot = context->snapshot_state();
+
+			// Restores into another context over the same model
+			Ref<ExecuTorchInferenceContext> branch;
+			branch.instantiate();
+			branch->set_model(model);
+			REQUIRE(branch->bind_state("input_0", "output_0") == OK);
+			REQUIRE(branch->restore_state(half_snapshot) == OK);
+			branch->step(Dictionary());
+			PackedFloat32Array stepped = branch->get_state("input_0");
+			REQUIRE(stepped.size() == 1);
+			CHECK(stepped[0] == doctest::Approx(6.0f));
+
+			REQUIRE(context->restore_state(snapshot) == OK);
+			CHECK(PackedFloat32Array(context->get_state("input_0"))[0] == doctest::Approx(9.0f));
+		}
+
+		SUBCASE("Unknown Names Fail") {
+			ERR_PRINT_OFF;
+			CHECK(context->set_state("missing", PackedFloat32Array()) == ERR_DOES_NOT_EXIST);
+			REQUIRE(context->bind_state("hidden") == OK);
+			context->step(Dictionary());
+			ERR_PRINT_ON;
+			// The model has no "hidden" input, so the step is refused as a whole
+			CHECK(context->get_step_count() == 3);
+			CHECK(PackedFloat32Array(context->get_state("input_0"))[0] == doctest::Approx(21.0f));
+			CHECK(context->get_state("hidden").get_type() == Variant::NIL);
+
+			Ref<ExecuTorchInferenceContext> other;
+			other.instantiate();
+			other->set_model(model);
+			ERR_PRINT_OFF;
+			CHECK(other->restore_state(snapshot) == ERR_DOES_NOT_EXIST);
+			ERR_PRINT_ON;
+		}
+	}
+}
+
+} // namespace TestExecuTorchInferenceContext
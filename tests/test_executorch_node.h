@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  test_executorch_node.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../executorch_node.h"
+#include "../executorch_tensor.h"
+#include "test_executorch_common.h"
+
+#include "core/io/resource_loader.h"
+#include "tests/test_macros.h"
+
+namespace TestExecuTorchNode {
+
+TEST_SUITE("[ExecuTorch] ExecuTorchNode Tests") {
+	TEST_CASE("ExecuTorchNode - Copy-Free Predict") {
+		String temp_file = TestExecuTorch::save_mock_model("test_node_predict.pte");
+		ExecuTorchNode *node = memnew(ExecuTorchNode);
+		bool loaded = node->load_model(temp_file);
+		if (!loaded) {
+			memdelete(node);
+		}
+		REQUIRE(loaded);
+
+		PackedFloat32Array input;
+		input.resize(1 << 20);
+		input.fill(0.5f);
+
+		SUBCASE("Input Is Never Copied") {
+			uint64_t copied_before = ExecuTorchTensor::get_copied_bytes();
+			PackedFloat32Array output = node->predict(input);
+			uint64_t copied_after = ExecuTorchTensor::get_copied_bytes();
+
+			CHECK(copied_after == copied_before);
+			REQUIRE(output.size() == input.size());
+			CHECK(output[0] == doctest::Approx(4.0f));
+			CHECK(output[output.size() - 1] == doctest::Approx(4.0f));
+		}
+
+		SUBCASE("Named Predict Uses Model Names") {
+			Dictionary inputs;
+			inputs["input_0"] = input;
+			Dictionary outputs = node->predict_named(inputs);
+			CHECK(PackedFloat32Array(outputs.get("output_0", PackedFloat32Array())).size() == input.size());
+		}
+
+		SUBCASE("Queued Requests Match Predict") {
+			int64_t ticket = node->submit(input);
+			REQUIRE(ticket >= 0);
+			PackedFloat32Array output = node->take_result(ticket);
+			REQUIRE(output.size() == input.size());
+			CHECK(output[0] == doctest::Approx(4.0f));
+
+			Dictionary stats = node->get_queue_stats();
+			CHECK(int64_t(stats["submitted"]) >= 1);
+			CHECK(int64_t(stats["in_flight"]) == 0);
+		}
+
+		SUBCASE("Runtime Name Applies To The Resource") {
+			Ref<ExecuTorchResource> shared = ResourceLoader::load(temp_file, "ExecuTorchResource", ResourceFormatLoader::CACHE_MODE_REUSE);
+			REQUIRE(shared.is_valid());
+			uint64_t generation = shared->get_model_generation();
+
+			node->set_runtime_name("test_node_runtime");
+			CHECK(node->get_runtime_name() == "test_node_runtime");
+			CHECK(shared->get_runtime_name() == "test_node_runtime");
+			CHECK(String(shared->get_memory_info()["runtime"]) == "test_node_runtime");
+			CHECK(shared->get_model_generation() > generation);
+			CHECK(node->predict(input)[0] == doctest::Approx(4.0f));
+
+			// Setting the name again does not rebuild the program
+			generation = shared->get_model_generation();
+			node->set_runtime_name("test_node_runtime");
+			CHECK(shared->get_model_generation() == generation);
+		}
+
+		SUBCASE("Pipelined Predict Lags One Frame") {
+			node->set_pipeline_mode(ExecuTorchNode::PIPELINE_DOUBLE);
+			PackedFloat32Array frame;
+			frame.resize(16);
+
+			frame.fill(0.5f);
+			CHECK(node->predict_pipelined(frame).is_empty());
+			frame.fill(1.0f);
+			PackedFloat32Array output = node->predict_pipelined(frame);
+			REQUIRE(output.size() == frame.size());
+			CHECK(output[0] == doctest::Approx(4.0f)); // The 0.5 frame
+			frame.fill(2.0f);
+			output = node->predict_pipelined(frame);
+			CHECK(output[0] == doctest::Approx(5.0f)); // The 1.0 frame
+
+			Dictionary stats = node->get_pipeline_stats();
+			CHECK(int64_t(stats["frames"]) == 3);
+			CHECK(int64_t(stats["in_flight"]) == 1);
+			CHECK(int(stats["latency_frames"]) == 1);
+
+			node->flush_pipeline();
+			CHECK(int64_t(node->get_pipeline_stats()["in_flight"]) == 0);
+			CHECK(node->predict_pipelined(frame).is_empty());
+		}
+
+		SUBCASE("Triple Buffering Takes The Newest Finished Frame") {
+			node->set_pipeline_mode(ExecuTorchNode::PIPELINE_TRIPLE);
+			PackedFloat32Array frame;
+			frame.resize(16);
+
+			{
+				// The gate holds the worker in the mock module until it opens
+				TestExecuTorch::MockGate gate;
+				frame.fill(0.5f);
+				CHECK(node->predict_pipelined(frame).is_empty());
+				frame.fill(1.0f);
+				CHECK(node->predict_pipelined(frame).is_empty()); // One frame may still be running
+				CHECK(int64_t(node->get_pipeline_stats()["in_flight"]) == 2);
+			}
+
+			// The queue has one worker, so this finishes after both frames
+			node->take_result(node->submit(frame));
+
+			{
+				TestExecuTorch::MockGate gate;
+				frame.fill(2.0f);
+				PackedFloat32Array output = node->predict_pipelined(frame);
+				REQUIRE(output.size() == frame.size());
+				CHECK(output[0] == doctest::Approx(5.0f)); // The 1.0 frame; the 0.5 frame is skipped
+				frame.fill(3.0f);
+				output = node->predict_pipelined(frame);
+				REQUIRE(output.size() == frame.size());
+				CHECK(output[0] == doctest::Approx(5.0f)); // The 2.0 frame is late, so the last result repeats
+			}
+
+			Dictionary stats = node->get_pipeline_stats();
+			CHECK(int64_t(stats["frames"]) == 4);
+			CHECK(int64_t(stats["repeats"]) == 1);
+			CHECK(int64_t(stats["stalls"]) == 0);
+			CHECK(int64_t(stats["in_flight"]) == 2);
+
+			// Switching runtimes or models drops the frames in flight and the last result
+			node->set_runtime_name(node->get_runtime_name());
+			CHECK(int64_t(node->get_pipeline_stats()["in_flight"]) == 0);
+			CHECK(node->predict_pipelined(frame).is_empty());
+			REQUIRE(node->load_model(temp_file));
+			CHECK(int64_t(node->get_pipeline_stats()["in_flight"]) == 0);
+			CHECK(node->predict_pipelined(frame).is_empty());
+		}
+
+		memdelete(node);
+	}
+}
+
+} // namespace TestExecuTorchNode
@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*  test_executorch_pipeline.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../executorch_pipeline.h"
+#include "test_executorch_common.h"
+
+#include "tests/test_macros.h"
+
+namespace TestExecuTorchPipeline {
+
+TEST_SUITE("[ExecuTorch] ExecuTorchPipeline Tests") {
+	TEST_CASE("ExecuTorchPipeline - Chained Stages") {
+		Ref<ExecuTorchResource> encoder = TestExecuTorch::make_mock_model();
+		Ref<ExecuTorchResource> head = TestExecuTorch::make_mock_model();
+
+		Ref<ExecuTorchPipeline> pipeline;
+		pipeline.instantiate();
+		CHECK(pipeline->add_stage(encoder, "encoder") == 0);
+		CHECK(pipeline->add_stage(head) == 1);
+		CHECK(pipeline->get_stage_names()[1] == "stage_1");
+
+		PackedFloat32Array values;
+		values.resize(4);
+		values.fill(0.5f);
+		Dictionary inputs;
+		inputs["input_0"] = values;
+
+		SUBCASE("Linked Output Feeds The Next Stage") {
+			REQUIRE(pipeline->connect_stages("encoder", "output_0", "stage_1", "input_0") == OK);
+			CHECK(pipeline->get_input_names().size() == 1);
+
+			// The mock computes 2x + 3: 0.5 -> 4 -> 11
+			uint64_t copied_before = ExecuTorchTensor::get_copied_bytes();
+			Dictionary outputs = pipeline->run(inputs);
+			CHECK(ExecuTorchTensor::get_copied_bytes() == copied_before);
+			PackedFloat32Array result = outputs.get("output_0", PackedFloat32Array());
+			REQUIRE(result.size() == values.size());
+			CHECK(result[0] == doctest::Approx(11.0f));
+		}
+
+		SUBCASE("Unlinked Inputs Come From The Pipeline") {
+			PackedStringArray names = pipeline->get_input_names();
+			REQUIRE(names.size() == 1);
+			CHECK(names[0] == "input_0");
+
+			PackedFloat32Array result = pipeline->run(inputs).get("output_0", PackedFloat32Array());
+			REQUIRE(result.size() == values.size());
+			CHECK(result[0] == doctest::Approx(4.0f));
+		}
+
+		SUBCASE("Stages Only Feed Later Ones") {
+			ERR_PRINT_OFF;
+			CHECK(pipeline->connect_stages("stage_1", "output_0", "encoder", "input_0") == ERR_INVALID_PARAMETER);
+			CHECK(pipeline->connect_stages("missing", "output_0", "encoder", "input_0") == ERR_DOES_NOT_EXIST);
+			ERR_PRINT_ON;
+		}
+	}
+}
+
+} // namespace TestExecuTorchPipeline
@@ -0,0 +1,883 @@
+/**************************************************************************/
+/*  test_executorch_pte_parser.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../executorch_native_executor.h"
+#include "../executorch_pte_parser.h"
+#include "../executorch_resource.h"
+
+#include "tests/test_macros.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace TestExecuTorchPTEParser {
+
+// Writes a .pte flatbuffer front to back. Offsets are unsigned in the
+// format, so a parent is written first and linked to children added later.
+class ProgramWriter {
+	std::vector<uint8_t> bytes_;
+
+public:
+	size_t alloc(size_t size, size_t align = 4) {
+		size_t pos = (bytes_.size() + align - 1) / align * align;
+		bytes_.resize(pos + size, 0);
+		return pos;
+	}
+
+	template <typename T>
+	void put(size_t pos, T value) {
+		memcpy(bytes_.data() + pos, &value, sizeof(T));
+	}
+
+	void link(size_t slot, size_t target) {
+		put<uint32_t>(slot, (uint32_t)(target - slot));
+	}
+
+	// field_sizes[i] is the byte size of field i, 0 when absent; r_slots gets each field's position.
+	size_t table(const std::vector<uint8_t> &field_sizes, std::vector<size_t> &r_slots) {
+		size_t vtable = alloc(4 + 2 * field_sizes.size(), 2);
+		std::vector<uint16_t> offsets;
+		uint16_t table_size = 4;
+		for (uint8_t field_size : field_sizes) {
+			if (field_size == 0) {
+				offsets.push_back(0);
+				continue;
+			}
+			table_size = (table_size + field_size - 1) / field_size * field_size;
+			offsets.push_back(table_size);
+			table_size += field_size;
+		}
+
+		size_t table = alloc(table_size, 8);
+		put<uint16_t>(vtable, (uint16_t)(4 + 2 * field_sizes.size()));
+		put<uint16_t>(vtable + 2, table_size);
+		put<int32_t>(table, (int32_t)(table - vtable));
+		r_slots.clear();
+		for (size_t i = 0; i < offsets.size(); i++) {
+			put<uint16_t>(vtable + 4 + 2 * i, offsets[i]);
+			r_slots.push_back(offsets[i] ? table + offsets[i] : 0);
+		}
+		return table;
+	}
+
+	// Returns the vector position; elements start 4 bytes later.
+	size_t vector(uint32_t count, size_t element_size) {
+		size_t align = element_size < 4 ? 4 : element_size;
+		size_t pos = alloc(4 + count * element_size, align);
+		if ((pos + 4) % align != 0) {
+			bytes_.resize(pos + 4 + count * element_size + 4, 0);
+			pos += 4;
+		}
+		put<uint32_t>(pos, count);
+		return pos;
+	}
+
+	size_t string(const String &value) {
+		CharString utf8 = value.utf8();
+		size_t pos = alloc(4 + utf8.length() + 1);
+		put<uint32_t>(pos, (uint32_t)utf8.length());
+		memcpy(bytes_.data() + pos + 4, utf8.get_data(), utf8.length());
+		return pos;
+	}
+
+	PackedByteArray finish() const {
+		PackedByteArray result;
+		result.resize(bytes_.size());
+		memcpy(result.ptrw(), bytes_.data(), bytes_.size());
+		return result;
+	}
+};
+
+struct TensorSpec {
+	ExecuTorchScalarType dtype;
+	std::vector<int32_t> sizes;
+	ExecuTorchShapeDynamism dynamism;
+};
+
+// Builds a one-method "forward" program whose values are the given tensors
+// plus a trailing Int; inputs and outputs index into the tensors.
+static PackedByteArray make_program(const std::vector<TensorSpec> &tensors, const std::vector<int32_t> &inputs, const std::vector<int32_t> &outputs, const String &encoded_inputs = String()) {
+	ProgramWriter writer;
+	std::vector<size_t> slots;
+
+	size_t root = writer.alloc(8);
+	writer.put<char>(root + 4, 'E');
+	writer.put<char>(root + 5, 'T');
+	writer.put<char>(root + 6, '1');
+	writer.put<char>(root + 7, '2');
+
+	std::vector<size_t> program_slots;
+	size_t program = writer.table({ 4, 4 }, program_slots);
+	writer.link(root, program);
+
+	size_t plans = writer.vector(1, 4);
+	writer.link(program_slots[1], plans);
+
+	std::vector<size_t> plan;
+	size_t plan_table = writer.table({ 4, (uint8_t)(encoded_inputs.is_empty() ? 0 : 4), 4, 4, 4, 0, 4, 0, 8 }, plan);
+	writer.link(plans + 4, plan_table);
+	writer.link(plan[0], writer.string("forward"));
+
+	if (!encoded_inputs.is_empty()) {
+		size_t meta = writer.table({ 4 }, slots);
+		writer.link(plan[1], meta);
+		writer.link(slots[0], writer.string(encoded_inputs));
+	}
+
+	size_t values = writer.vector(tensors.size() + 1, 4);
+	writer.link(plan[2], values);
+	for (size_t i = 0; i <= tensors.size(); i++) {
+		std::vector<size_t> evalue;
+		size_t evalue_table = writer.table({ 1, 4 }, evalue);
+		writer.link(values + 4 + 4 * i, evalue_table);
+
+		if (i == tensors.size()) {
+			writer.put<uint8_t>(evalue[0], 2); // Int
+			size_t int_table = writer.table({ 8 }, slots);
+			writer.put<int64_t>(slots[0], 7);
+			writer.link(evalue[1], int_table);
+			continue;
+		}
+
+		const TensorSpec &spec = tensors[i];
+		writer.put<uint8_t>(evalue[0], 5); // Tensor
+		std::vector<size_t> tensor;
+		size_t tensor_table = writer.table({ 1, 0, 4, 4, 0, 0, 0, 0, 1 }, tensor);
+		writer.link(evalue[1], tensor_table);
+		writer.put<int8_t>(tensor[0], (int8_t)spec.dtype);
+		writer.put<int8_t>(tensor[8], (int8_t)spec.dynamism);
+
+		size_t sizes = writer.vector(spec.sizes.size(), 4);
+		writer.link(tensor[2], sizes);
+		size_t dim_order = writer.vector(spec.sizes.size(), 1);
+		writer.link(tensor[3], dim_order);
+		for (size_t d = 0; d < spec.sizes.size(); d++) {
+			writer.put<int32_t>(sizes + 4 + 4 * d, spec.sizes[d]);
+			writer.put<uint8_t>(dim_order + 4 + d, (uint8_t)d);
+		}
+	}
+
+	const std::vector<int32_t> *io[2] = { &inputs, &outputs };
+	for (int k = 0; k < 2; k++) {
+		size_t list = writer.vector(io[k]->size(), 4);
+		writer.link(plan[3 + k], list);
+		for (size_t i = 0; i < io[k]->size(); i++) {
+			writer.put<int32_t>(list + 4 + 4 * i, (*io[k])[i]);
+		}
+	}
+
+	size_t operators = writer.vector(1, 4);
+	writer.link(plan[6], operators);
+	size_t op = writer.table({ 4, 4 }, slots);
+	writer.link(operators + 4, op);
+	size_t overload_slot = slots[1];
+	writer.link(slots[0], writer.string("aten::linear"));
+	writer.link(overload_slot, writer.string("out"));
+
+	size_t buffer_sizes = writer.vector(2, 8);
+	writer.link(plan[8], buffer_sizes);
+	writer.put<int64_t>(buffer_sizes + 4, 0);
+	writer.put<int64_t>(buffer_sizes + 12, 96);
+
+	return writer.finish();
+}
+
+static PackedByteArray make_linear_program() {
+	return make_program({ { ExecuTorchScalarType::FLOAT32, { 1, 3 }, ExecuTorchShapeDynamism::STATIC },
+								{ ExecuTorchScalarType::INT8, { 4 }, ExecuTorchShapeDynamism::DYNAMIC_BOUND },
+								{ ExecuTorchScalarType::FLOAT32, { 1, 3 }, ExecuTorchShapeDynamism::STATIC } },
+			{ 0, 1 }, { 2 });
+}
+
+// forward(x) = activation(linear(x, weight, bias)) on a [1, 3] input, with the
+// weights inlined as constant buffers the way older exports store them.
+static PackedByteArray make_mlp_program(const char *activation = "aten::relu") {
+	ProgramWriter writer;
+	std::vector<size_t> slots;
+
+	size_t root = writer.alloc(8);
+	writer.put<char>(root + 4, 'E');
+	writer.put<char>(root + 5, 'T');
+	writer.put<char>(root + 6, '1');
+	writer.put<char>(root + 7, '2');
+
+	std::vector<size_t> program;
+	size_t program_table = writer.table({ 4, 4, 4 }, program);
+	writer.link(root, program_table);
+
+	size_t plans = writer.vector(1, 4);
+	writer.link(program[1], plans);
+	std::vector<size_t> plan;
+	size_t plan_table = writer.table({ 4, 0, 4, 4, 4, 4, 4 }, plan);
+	writer.link(plans + 4, plan_table);
+	writer.link(plan[0], writer.string("forward"));
+
+	// x, weight, bias, hidden, y; weight and bias are constant buffers 1 and 2
+	const std::vector<std::vector<int32_t>> shapes = { { 1, 3 }, { 2, 3 }, { 2 }, { 1, 2 }, { 1, 2 } };
+	const uint32_t buffers[] = { 0, 1, 2, 0, 0 };
+	size_t values = writer.vector(shapes.size(), 4);
+	writer.link(plan[2], values);
+	for (size_t i = 0; i < shapes.size(); i++) {
+		std::vector<size_t> evalue;
+		size_t evalue_table = writer.table({ 1, 4 }, evalue);
+		writer.link(values + 4 + 4 * i, evalue_table);
+		writer.put<uint8_t>(evalue[0], 5); // Tensor
+
+		std::vector<size_t> tensor;
+		size_t tensor_table = writer.table({ 1, 0, 4, 0, 0, 4 }, tensor);
+		writer.link(evalue[1], tensor_table);
+		writer.put<int8_t>(tensor[0], (int8_t)ExecuTorchScalarType::FLOAT32);
+		writer.put<uint32_t>(tensor[5], buffers[i]);
+		size_t sizes = writer.vector(shapes[i].size(), 4);
+		writer.link(tensor[2], sizes);
+		for (size_t d = 0; d < shapes[i].size(); d++) {
+			writer.put<int32_t>(sizes + 4 + 4 * d, shapes[i][d]);
+		}
+	}
+
+	const int32_t io[2] = { 0, 4 };
+	for (int k = 0; k < 2; k++) {
+		size_t list = writer.vector(1, 4);
+		writer.link(plan[3 + k], list);
+		writer.put<int32_t>(list + 4, io[k]);
+	}
+
+	const char *names[2] = { "aten::linear", activation };
+	size_t operators = writer.vector(2, 4);
+	writer.link(plan[6], operators);
+	for (size_t i = 0; i < 2; i++) {
+		size_t op = writer.table({ 4, 4 }, slots);
+		writer.link(operators + 4 + 4 * i, op);
+		size_t overload_slot = slots[1];
+		writer.link(slots[0], writer.string(names[i]));
+		writer.link(overload_slot, writer.string("out"));
+	}
+
+	// Out variants take the out tensor as their last argument and return it
+	const std::vector<std::vector<int32_t>> calls = { { 0, 1, 2, 3, 3 }, { 3, 4, 4 } };
+	size_t chains = writer.vector(1, 4);
+	writer.link(plan[5], chains);
+	std::vector<size_t> chain;
+	size_t chain_table = writer.table({ 0, 0, 4 }, chain);
+	writer.link(chains + 4, chain_table);
+	size_t instructions = writer.vector(calls.size(), 4);
+	writer.link(chain[2], instructions);
+	for (size_t i = 0; i < calls.size(); i++) {
+		std::vector<size_t> instruction;
+		size_t instruction_table = writer.table({ 1, 4 }, instruction);
+		writer.link(instructions + 4 + 4 * i, instruction_table);
+		writer.put<uint8_t>(instruction[0], 1); // KernelCall
+
+		std::vector<size_t> call;
+		size_t call_table = writer.table({ 4, 4 }, call);
+		writer.link(instruction[1], call_table);
+		writer.put<int32_t>(call[0], (int32_t)i);
+		size_t args = writer.vector(calls[i].size(), 4);
+		writer.link(call[1], args);
+		for (size_t j = 0; j < calls[i].size(); j++) {
+			writer.put<int32_t>(args + 4 + 4 * j, calls[i][j]);
+		}
+	}
+
+	// Buffer 0 is reserved
+	const std::vector<std::vector<float>> constants = { {}, { 1.0f, 0.0f, -1.0f, 0.5f, 0.5f, 0.5f }, { 0.5f, 1.0f } };
+	size_t buffer_list = writer.vector(constants.size(), 4);
+	writer.link(program[2], buffer_list);
+	for (size_t i = 0; i < constants.size(); i++) {
+		size_t buffer = writer.table({ 4 }, slots);
+		writer.link(buffer_list + 4 + 4 * i, buffer);
+		size_t storage_slot = slots[0];
+		size_t storage = writer.vector(constants[i].size() * sizeof(float), 1);
+		writer.link(storage_slot, storage);
+		for (size_t j = 0; j < constants[i].size(); j++) {
+			writer.put<float>(storage + 4 + 4 * j, constants[i][j]);
+		}
+	}
+
+	return writer.finish();
+}
+
+// One value of a hand-built graph: a tensor (constant when it has data,
+// planned when memory_id is set) or a scalar argument
+struct GraphValue {
+	uint8_t type = 5; // KernelTypes: 1 Null, 2 Int, 3 Bool, 5 Tensor, 7 IntList
+	std::vector<int32_t> shape;
+	std::vector<float> data;
+	int64_t scalar = 0;
+	std::vector<int64_t> items; // IntList items are indices of Int values
+	int32_t memory_id = -1;
+	uint32_t memory_offset = 0;
+};
+
+static GraphValue graph_tensor(const std::vector<int32_t> &shape, const std::vector<float> &data = {}) {
+	GraphValue value;
+	value.shape = shape;
+	value.data = data;
+	return value;
+}
+
+static GraphValue graph_planned(const std::vector<int32_t> &shape, int32_t memory_id, uint32_t memory_offset) {
+	GraphValue value;
+	value.shape = shape;
+	value.memory_id = memory_id;
+	value.memory_offset = memory_offset;
+	return value;
+}
+
+static GraphValue graph_scalar(uint8_t type, int64_t scalar) {
+	GraphValue value;
+	value.type = type;
+	value.scalar = scalar;
+	return value;
+}
+
+static GraphValue graph_int_list(const std::vector<int64_t> &items) {
+	GraphValue value;
+	value.type = 7;
+	value.items = items;
+	return value;
+}
+
+// args end with the out tensor, which the builder repeats as the return value
+struct GraphCall {
+	const char *name;
+	const char *overload;
+	std::vector<int32_t> args;
+};
+
+// Builds a "forward" method that runs calls in order over float32 values,
+// with constants inlined as buffers like make_mlp_program.
+static PackedByteArray make_graph_program(const std::vector<GraphValue> &values, const std::vector<int32_t> &inputs, const std::vector<int32_t> &outputs, const std::vector<GraphCall> &calls) {
+	ProgramWriter writer;
+	std::vector<size_t> slots;
+
+	size_t root = writer.alloc(8);
+	writer.put<char>(root + 4, 'E');
+	writer.put<char>(root + 5, 'T');
+	writer.put<char>(root + 6, '1');
+	writer.put<char>(root + 7, '2');
+
+	std::vector<size_t> program;
+	size_t program_table = writer.table({ 4, 4, 4 }, program);
+	writer.link(root, program_table);
+
+	size_t plans = writer.vector(1, 4);
+	writer.link(program[1], plans);
+	std::vector<size_t> plan;
+	size_t plan_table = writer.table({ 4, 0, 4, 4, 4, 4, 4, 0, 4 }, plan);
+	writer.link(plans + 4, plan_table);
+	writer.link(plan[0], writer.string("forward"));
+
+	std::vector<const std::vector<float> *> constants = { nullptr }; // Buffer 0 is reserved
+	std::vector<int64_t> arena_bytes = { 0 };
+	size_t value_list = writer.vector(values.size(), 4);
+	writer.link(plan[2], value_list);
+	for (size_t i = 0; i < values.size(); i++) {
+		const GraphValue &value = values[i];
+		std::vector<size_t> evalue;
+		size_t evalue_table = writer.table({ 1, (uint8_t)(value.type == 1 ? 0 : 4) }, evalue);
+		writer.link(value_list + 4 + 4 * i, evalue_table);
+		writer.put<uint8_t>(evalue[0], value.type);
+
+		if (value.type == 2 || value.type == 3) {
+			size_t scalar_table = writer.table({ (uint8_t)(value.type == 2 ? 8 : 1) }, slots);
+			if (value.type == 2) {
+				writer.put<int64_t>(slots[0], value.scalar);
+			} else {
+				writer.put<uint8_t>(slots[0], (uint8_t)value.scalar);
+			}
+			writer.link(evalue[1], scalar_table);
+		} else if (value.type == 7) {
+			size_t list_table = writer.table({ 4 }, slots);
+			writer.link(evalue[1], list_table);
+			size_t items = writer.vector(value.items.size(), 8);
+			writer.link(slots[0], items);
+			for (size_t j = 0; j < value.items.size(); j++) {
+				writer.put<int64_t>(items + 4 + 8 * j, value.items[j]);
+			}
+		} else if (value.type == 5) {
+			std::vector<size_t> tensor;
+			size_t tensor_table = writer.table({ 1, 0, 4, 0, 0, 4, (uint8_t)(value.memory_id >= 0 ? 4 : 0) }, tensor);
+			writer.link(evalue[1], tensor_table);
+			writer.put<int8_t>(tensor[0], (int8_t)ExecuTorchScalarType::FLOAT32);
+			size_t sizes = writer.vector(value.shape.size(), 4);
+			writer.link(tensor[2], sizes);
+			int64_t element_count = 1;
+			for (size_t d = 0; d < value.shape.size(); d++) {
+				writer.put<int32_t>(sizes + 4 + 4 * d, value.shape[d]);
+				element_count *= value.shape[d];
+			}
+			if (!value.data.empty()) {
+				writer.put<uint32_t>(tensor[5], (uint32_t)constants.size());
+				constants.push_back(&value.data);
+			}
+			if (value.memory_id >= 0) {
+				std::vector<size_t> allocation;
+				size_t allocation_table = writer.table({ 4, 4 }, allocation);
+				writer.link(tensor[6], allocation_table);
+				writer.put<uint32_t>(allocation[0], (uint32_t)value.memory_id);
+				writer.put<uint32_t>(allocation[1], value.memory_offset);
+				if ((size_t)value.memory_id >= arena_bytes.size()) {
+					arena_bytes.resize(value.memory_id + 1, 0);
+				}
+				arena_bytes[value.memory_id] = std::max(arena_bytes[value.memory_id], (int64_t)value.memory_offset + element_count * (int64_t)sizeof(float));
+			}
+		}
+	}
+
+	const std::vector<int32_t> *io[2] = { &inputs, &outputs };
+	for (int k = 0; k < 2; k++) {
+		size_t list = writer.vector(io[k]->size(), 4);
+		writer.link(plan[3 + k], list);
+		for (size_t i = 0; i < io[k]->size(); i++) {
+			writer.put<int32_t>(list + 4 + 4 * i, (*io[k])[i]);
+		}
+	}
+
+	// One operator entry per distinct name and overload
+	std::vector<std::pair<String, String>> operator_names;
+	std::vector<int32_t> op_indices;
+	for (const GraphCall &call : calls) {
+		std::pair<String, String> name(call.name, call.overload);
+		size_t index = std::find(operator_names.begin(), operator_names.end(), name) - operator_names.begin();
+		if (index == operator_names.size()) {
+			operator_names.push_back(name);
+		}
+		op_indices.push_back((int32_t)index);
+	}
+	size_t operators = writer.vector(operator_names.size(), 4);
+	writer.link(plan[6], operators);
+	for (size_t i = 0; i < operator_names.size(); i++) {
+		size_t op = writer.table({ 4, 4 }, slots);
+		writer.link(operators + 4 + 4 * i, op);
+		size_t overload_slot = slots[1];
+		writer.link(slots[0], writer.string(operator_names[i].first));
+		writer.link(overload_slot, writer.string(operator_names[i].second));
+	}
+
+	size_t chains = writer.vector(1, 4);
+	writer.link(plan[5], chains);
+	std::vector<size_t> chain;
+	size_t chain_table = writer.table({ 0, 0, 4 }, chain);
+	writer.link(chains + 4, chain_table);
+	size_t instructions = writer.vector(calls.size(), 4);
+	writer.link(chain[2], instructions);
+	for (size_t i = 0; i < calls.size(); i++) {
+		std::vector<size_t> instruction;
+		size_t instruction_table = writer.table({ 1, 4 }, instruction);
+		writer.link(instructions + 4 + 4 * i, instruction_table);
+		writer.put<uint8_t>(instruction[0], 1); // KernelCall
+
+		std::vector<size_t> call;
+		size_t call_table = writer.table({ 4, 4 }, call);
+		writer.link(instruction[1], call_table);
+		writer.put<int32_t>(call[0], op_indices[i]);
+		std::vector<int32_t> call_args = calls[i].args;
+		call_args.push_back(call_args.back());
+		size_t args = writer.vector(call_args.size(), 4);
+		writer.link(call[1], args);
+		for (size_t j = 0; j < call_args.size(); j++) {
+			writer.put<int32_t>(args + 4 + 4 * j, call_args[j]);
+		}
+	}
+
+	size_t buffer_sizes = writer.vector(arena_bytes.size(), 8);
+	writer.link(plan[8], buffer_sizes);
+	for (size_t id = 0; id < arena_bytes.size(); id++) {
+		writer.put<int64_t>(buffer_sizes + 4 + 8 * id, arena_bytes[id]);
+	}
+
+	size_t buffer_list = writer.vector(constants.size(), 4);
+	writer.link(program[2], buffer_list);
+	for (size_t i = 0; i < constants.size(); i++) {
+		size_t buffer = writer.table({ 4 }, slots);
+		writer.link(buffer_list + 4 + 4 * i, buffer);
+		size_t storage_slot = slots[0];
+		size_t count = constants[i] ? constants[i]->size() : 0;
+		size_t storage = writer.vector(count * sizeof(float), 1);
+		writer.link(storage_slot, storage);
+		for (size_t j = 0; j < count; j++) {
+			writer.put<float>(storage + 4 + 4 * j, (*constants[i])[j]);
+		}
+	}
+
+	return writer.finish();
+}
+
+// Runs a program on the native executor and returns its outputs as float32
+static std::vector<PackedFloat32Array> run_native(const PackedByteArray &data, const std::vector<ExecuTorchTensor> &inputs, int *r_step_count = nullptr) {
+	ExecuTorchNativeExecutor executor;
+	REQUIRE_MESSAGE(executor.load(data.ptr(), data.size()) == OK, executor.get_unsupported_reason().utf8().get_data());
+	if (r_step_count) {
+		*r_step_count = executor.get_step_count();
+	}
+	std::vector<ExecuTorchTensor> outputs;
+	REQUIRE(executor.execute(inputs, outputs) == OK);
+	std::vector<PackedFloat32Array> result(outputs.size());
+	for (size_t i = 0; i < outputs.size(); i++) {
+		REQUIRE(outputs[i].to_float32(result[i]) == OK);
+	}
+	return result;
+}
+
+static String native_unsupported_reason(const PackedByteArray &data) {
+	ExecuTorchNativeExecutor executor;
+	CHECK(executor.load(data.ptr(), data.size()) == ERR_UNAVAILABLE);
+	return executor.get_unsupported_reason();
+}
+
+TEST_SUITE("[ExecuTorch] ExecuTorchPTEParser Tests") {
+	TEST_CASE("ExecuTorchPTEParser - Method Signatures") {
+		PackedByteArray data = make_linear_program();
+		ExecuTorchProgramInfo info;
+		REQUIRE(ExecuTorchPTEParser::parse(data.ptr(), data.size(), info) == OK);
+		REQUIRE(info.methods.size() == 1);
+
+		const ExecuTorchMethodInfo *method = info.find_method("forward");
+		REQUIRE(method != nullptr);
+		REQUIRE(method->inputs.size() == 2);
+		REQUIRE(method->outputs.size() == 1);
+
+		CHECK(method->inputs[0].name == "input_0");
+		CHECK(method->inputs[0].dtype == ExecuTorchScalarType::FLOAT32);
+		CHECK(method->inputs[0].shape == Vector<int64_t>({ 1, 3 }));
+		CHECK(method->inputs[0].dim_order.size() == 2);
+		CHECK_FALSE(method->inputs[0].is_dynamic());
+
+		CHECK(method->inputs[1].dtype == ExecuTorchScalarType::INT8);
+		CHECK(method->inputs[1].dynamism == ExecuTorchShapeDynamism::DYNAMIC_BOUND);
+		CHECK(method->inputs[1].get_byte_size() == 4);
+
+		CHECK(method->outputs[0].name == "output_0");
+		CHECK(method->operators.size() == 1);
+		CHECK(method->operators[0] == "aten::linear.out");
+		CHECK(method->non_const_buffer_sizes.size() == 2);
+		CHECK(method->non_const_buffer_sizes[1] == 96);
+	}
+
+	TEST_CASE("ExecuTorchPTEParser - Names From Container Metadata") {
+		// forward(*, obs, mask): a tuple of (empty args, kwargs dict)
+		String spec = "[1, {\"type\": \"builtins.tuple\", \"context\": \"null\", \"children_spec\": ["
+					  "{\"type\": \"builtins.tuple\", \"context\": \"null\", \"children_spec\": []}, "
+					  "{\"type\": \"builtins.dict\", \"context\": \"[\\\"obs\\\", \\\"mask\\\"]\", \"children_spec\": ["
+					  "{\"type\": null, \"context\": null, \"children_spec\": []}, "
+					  "{\"type\": null, \"context\": null, \"children_spec\": []}]}]}]";
+		PackedByteArray data = make_program({ { ExecuTorchScalarType::FLOAT32, { 2 }, ExecuTorchShapeDynamism::STATIC },
+													{ ExecuTorchScalarType::BOOL, { 2 }, ExecuTorchShapeDynamism::STATIC } },
+				{ 0, 1 }, { 0 }, spec);
+
+		ExecuTorchProgramInfo info;
+		REQUIRE(ExecuTorchPTEParser::parse(data.ptr(), data.size(), info) == OK);
+		CHECK(info.methods[0].inputs[0].name == "obs");
+		CHECK(info.methods[0].inputs[1].name == "mask");
+	}
+
+	TEST_CASE("ExecuTorchPTEParser - Malformed Buffers") {
+		PackedByteArray data = make_linear_program();
+		ExecuTorchProgramInfo info;
+
+		SUBCASE("Foreign Data") {
+			PackedByteArray foreign;
+			foreign.resize(64);
+			foreign.fill(0x42);
+			CHECK_FALSE(ExecuTorchPTEParser::has_program_identifier(foreign.ptr(), foreign.size()));
+			ERR_PRINT_OFF;
+			CHECK(ExecuTorchPTEParser::parse(foreign.ptr(), foreign.size(), info) == ERR_FILE_UNRECOGNIZED);
+			ERR_PRINT_ON;
+		}
+
+		SUBCASE("Every Truncation Fails") {
+			ERR_PRINT_OFF;
+			bool any_accepted = false;
+			for (int64_t size = 0; size < data.size(); size++) {
+				any_accepted |= ExecuTorchPTEParser::parse(data.ptr(), size, info) == OK;
+			}
+			ERR_PRINT_ON;
+			CHECK_FALSE(any_accepted);
+		}
+	}
+
+	TEST_CASE("ExecuTorchPTEParser - Method Graph") {
+		PackedByteArray data = make_mlp_program();
+		ExecuTorchMethodGraph graph;
+		REQUIRE(ExecuTorchPTEParser::parse_graph(data.ptr(), data.size(), "forward", graph) == OK);
+
+		REQUIRE(graph.values.size() == 5);
+		CHECK(graph.operators.size() == 2);
+		CHECK(graph.operators[1] == "aten::relu.out");
+		CHECK(graph.chain_count == 1);
+		REQUIRE(graph.instructions.size() == 2);
+		CHECK(graph.instructions[0].type == ExecuTorchInstructionInfo::TYPE_KERNEL);
+		CHECK(graph.instructions[0].args == Vector<int32_t>({ 0, 1, 2, 3, 3 }));
+
+		CHECK(graph.values[0].data_offset == -1);
+		REQUIRE(graph.values[1].data_offset > 0);
+		float first_weight;
+		memcpy(&first_weight, data.ptr() + graph.values[1].data_offset, sizeof(float));
+		CHECK(first_weight == 1.0f);
+
+		CHECK(ExecuTorchPTEParser::parse_graph(data.ptr(), data.size(), "backward", graph) == ERR_DOES_NOT_EXIST);
+	}
+
+	TEST_CASE("ExecuTorchNativeExecutor - Small MLP") {
+		ExecuTorchTensor input = ExecuTorchTensor::from_float32(PackedFloat32Array({ 1.0f, 2.0f, 3.0f }), Vector<int64_t>({ 1, 3 }));
+		std::vector<ExecuTorchTensor> outputs;
+
+		SUBCASE("Linear And ReLU") {
+			PackedByteArray data = make_mlp_program();
+			ExecuTorchNativeExecutor executor;
+			REQUIRE(executor.load(data.ptr(), data.size()) == OK);
+			CHECK(executor.get_step_count() == 2);
+			REQUIRE(executor.execute({ input }, outputs) == OK);
+
+			// linear gives [-1.5, 4.0]
+			PackedFloat32Array values;
+			REQUIRE(outputs.size() == 1);
+			REQUIRE(outputs[0].to_float32(values) == OK);
+			CHECK(outputs[0].shape == Vector<int64_t>({ 1, 2 }));
+			CHECK(values[0] == 0.0f);
+			CHECK(values[1] == 4.0f);
+		}
+
+		SUBCASE("Sigmoid") {
+			PackedByteArray data = make_mlp_program("aten::sigmoid");
+			ExecuTorchNativeExecutor executor;
+			REQUIRE(executor.load(data.ptr(), data.size()) == OK);
+			REQUIRE(executor.execute({ input }, outputs) == OK);
+			PackedFloat32Array values;
+			REQUIRE(outputs[0].to_float32(values) == OK);
+			CHECK(values[0] == doctest::Approx(1.0 / (1.0 + std::exp(1.5))));
+			CHECK(values[1] == doctest::Approx(1.0 / (1.0 + std::exp(-4.0))));
+		}
+
+		SUBCASE("Uncovered Ops Fall Back") {
+			PackedByteArray data = make_mlp_program("aten::gelu");
+			ExecuTorchNativeExecutor executor;
+			CHECK(executor.load(data.ptr(), data.size()) == ERR_UNAVAILABLE);
+			CHECK(executor.get_unsupported_reason().contains("aten::gelu.out"));
+			CHECK_FALSE(executor.is_loaded());
+
+			ExecuTorchModule module;
+			REQUIRE(module.load_from_buffer(data) == OK);
+			CHECK(module.get_backend_name() != "native");
+		}
+
+		SUBCASE("Through The Resource") {
+			Ref<ExecuTorchResource> resource;
+			resource.instantiate();
+			REQUIRE(resource->swap_model_data(make_mlp_program(), false) == OK);
+			Dictionary info = resource->get_memory_info();
+			CHECK(String(info["module_backend"]) == "native");
+			// The arenas are carved from the runtime and charged once, as activations
+			CHECK(int64_t(info["native_executor_bytes"]) > 0);
+			CHECK(int64_t(info["activation_bytes"]) == int64_t(info["native_executor_bytes"]));
+			CHECK(int64_t(info["runtime_usage_bytes"]) >= int64_t(info["activation_bytes"]));
+
+			Dictionary feed;
+			feed["input_0"] = PackedFloat32Array({ 1.0f, 2.0f, 3.0f });
+			PackedFloat32Array result = resource->forward(feed)["output_0"];
+			REQUIRE(result.size() == 2);
+			CHECK(result[1] == 4.0f);
+
+			resource->set_native_executor_enabled(false);
+			REQUIRE(resource->swap_model_data(make_mlp_program(), false) == OK);
+			CHECK(String(resource->get_memory_info()["module_backend"]) != "native");
+		}
+	}
+
+	TEST_CASE("ExecuTorchNativeExecutor - Operators") {
+		const int NUL = 1, INT = 2, BOOL = 3;
+		ExecuTorchTensor x23 = ExecuTorchTensor::from_float32(PackedFloat32Array({ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f }), Vector<int64_t>({ 2, 3 }));
+
+		SUBCASE("Broadcast Add And Mul") {
+			// h = x + b over rows, y = 0.5 * h with the scalar as the first operand
+			std::vector<GraphValue> values = { graph_tensor({ 2, 3 }), graph_tensor({ 3 }, { 10.0f, 20.0f, 30.0f }), graph_scalar(INT, 1),
+				graph_tensor({ 2, 3 }), graph_tensor({ 1 }, { 0.5f }), graph_tensor({ 2, 3 }) };
+			int steps = 0;
+			std::vector<PackedFloat32Array> result = run_native(make_graph_program(values, { 0 }, { 5 }, { { "aten::add", "out", { 0, 1, 2, 3 } }, { "aten::mul", "out", { 4, 3, 5 } } }), { x23 }, &steps);
+			CHECK(steps == 2);
+			REQUIRE(result.size() == 1);
+			CHECK(result[0] == PackedFloat32Array({ 5.5f, 11.0f, 16.5f, 7.0f, 12.5f, 18.0f }));
+
+			// A [2, 1] operand repeats along the last dim, which the kernels do not cover
+			values[1] = graph_tensor({ 2, 1 }, { 1.0f, 2.0f });
+			CHECK(native_unsupported_reason(make_graph_program(values, { 0 }, { 3 }, { { "aten::add", "out", { 0, 1, 2, 3 } } })).contains("leading dimension"));
+		}
+
+		SUBCASE("Softmax Over A Leading Dim") {
+			ExecuTorchTensor input = ExecuTorchTensor::from_float32(PackedFloat32Array({ 1.0f, 2.0f, 3.0f, 3.0f, 2.0f, 1.0f }), Vector<int64_t>({ 2, 3 }));
+			for (int64_t dim : { 0, -2 }) {
+				std::vector<GraphValue> values = { graph_tensor({ 2, 3 }), graph_scalar(INT, dim), graph_scalar(BOOL, 0), graph_tensor({ 2, 3 }) };
+				std::vector<PackedFloat32Array> result = run_native(make_graph_program(values, { 0 }, { 3 }, { { "aten::_softmax", "out", { 0, 1, 2, 3 } } }), { input });
+				REQUIRE(result[0].size() == 6);
+				CHECK(result[0][0] == doctest::Approx(1.0 / (1.0 + std::exp(2.0))));
+				CHECK(result[0][1] == doctest::Approx(0.5));
+				CHECK(result[0][5] == doctest::Approx(1.0 / (1.0 + std::exp(2.0))));
+				for (int column = 0; column < 3; column++) {
+					CHECK(result[0][column] + result[0][3 + column] == doctest::Approx(1.0));
+				}
+			}
+
+			std::vector<GraphValue> values = { graph_tensor({ 2, 3 }), graph_scalar(INT, 2), graph_scalar(NUL, 0), graph_tensor({ 2, 3 }) };
+			CHECK(native_unsupported_reason(make_graph_program(values, { 0 }, { 3 }, { { "aten::softmax", "int_out", { 0, 1, 2, 3 } } })).contains("out of range"));
+		}
+
+		SUBCASE("Addmm And Mm Fold The Transpose") {
+			// A constant mat2 is transposed once at load, leaving one step per call
+			std::vector<GraphValue> values = { graph_tensor({ 2 }, { 0.5f, -1.0f }), graph_tensor({ 1, 3 }), graph_tensor({ 3, 2 }, { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f }),
+				graph_scalar(INT, 1), graph_scalar(INT, 1), graph_tensor({ 1, 2 }) };
+			ExecuTorchTensor ones = ExecuTorchTensor::from_float32(PackedFloat32Array({ 1.0f, 1.0f, 1.0f }), Vector<int64_t>({ 1, 3 }));
+			int steps = 0;
+			std::vector<PackedFloat32Array> result = run_native(make_graph_program(values, { 1 }, { 5 }, { { "aten::addmm", "out", { 0, 1, 2, 3, 4, 5 } } }), { ones }, &steps);
+			CHECK(steps == 1);
+			CHECK(result[0] == PackedFloat32Array({ 9.5f, 11.0f }));
+
+			values[3] = graph_scalar(INT, 2);
+			CHECK(native_unsupported_reason(make_graph_program(values, { 1 }, { 5 }, { { "aten::addmm", "out", { 0, 1, 2, 3, 4, 5 } } })).contains("beta = alpha = 1"));
+
+			// Both operands are inputs, so the transpose runs on every call
+			values = { graph_tensor({ 2, 3 }), graph_tensor({ 3, 2 }), graph_tensor({ 2, 2 }) };
+			ExecuTorchTensor mat2 = ExecuTorchTensor::from_float32(PackedFloat32Array({ 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f }), Vector<int64_t>({ 3, 2 }));
+			result = run_native(make_graph_program(values, { 0, 1 }, { 2 }, { { "aten::mm", "out", { 0, 1, 2 } } }), { x23, mat2 }, &steps);
+			CHECK(steps == 2);
+			CHECK(result[0] == PackedFloat32Array({ 4.0f, 5.0f, 10.0f, 11.0f }));
+		}
+
+		SUBCASE("Permute And Transpose Copies") {
+			std::vector<GraphValue> values = { graph_tensor({ 2, 3 }), graph_tensor({ 3, 2 }), graph_scalar(INT, 1), graph_scalar(INT, 0),
+				graph_int_list({ 2, 3 }), graph_tensor({ 2, 3 }), graph_int_list({ 3, 2 }), graph_tensor({ 2, 3 }) };
+			std::vector<PackedFloat32Array> result = run_native(make_graph_program(values, { 0 }, { 1, 5, 7 },
+																		{ { "aten::t_copy", "out", { 0, 1 } }, { "aten::permute_copy", "out", { 1, 4, 5 } }, { "aten::permute_copy", "out", { 5, 6, 7 } } }),
+					{ x23 });
+			REQUIRE(result.size() == 3);
+			CHECK(result[0] == PackedFloat32Array({ 1.0f, 4.0f, 2.0f, 5.0f, 3.0f, 6.0f }));
+			CHECK(result[1] == PackedFloat32Array({ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f }));
+			// An identity permutation is a plain copy
+			CHECK(result[2] == result[1]);
+
+			values = { graph_tensor({ 1, 2, 3 }), graph_scalar(INT, 0), graph_scalar(INT, 2), graph_scalar(INT, 1), graph_int_list({ 1, 2, 3 }), graph_tensor({ 1, 3, 2 }) };
+			CHECK(native_unsupported_reason(make_graph_program(values, { 0 }, { 5 }, { { "aten::permute_copy", "out", { 0, 4, 5 } } })).contains("more than two dimensions"));
+		}
+
+		SUBCASE("Tanh") {
+			ExecuTorchTensor input = ExecuTorchTensor::from_float32(PackedFloat32Array({ -1.0f, 0.0f, 2.0f }), Vector<int64_t>({ 1, 3 }));
+			std::vector<PackedFloat32Array> result = run_native(make_graph_program({ graph_tensor({ 1, 3 }), graph_tensor({ 1, 3 }) }, { 0 }, { 1 }, { { "aten::tanh", "out", { 0, 1 } } }), { input });
+			REQUIRE(result[0].size() == 3);
+			CHECK(result[0][0] == doctest::Approx(std::tanh(-1.0)));
+			CHECK(result[0][1] == 0.0f);
+			CHECK(result[0][2] == doctest::Approx(std::tanh(2.0)));
+		}
+
+		SUBCASE("Planned Arenas") {
+			// y = 2x + 1, with y planned over x once x is dead
+			auto make_program = [&](bool planned, uint32_t hidden_offset) {
+				std::vector<GraphValue> values = { planned ? graph_planned({ 1, 4 }, 1, 0) : graph_tensor({ 1, 4 }), graph_tensor({ 1 }, { 2.0f }),
+					planned ? graph_planned({ 1, 4 }, 1, hidden_offset) : graph_tensor({ 1, 4 }), graph_tensor({ 1 }, { 1.0f }), graph_scalar(INT, 1),
+					planned ? graph_planned({ 1, 4 }, 1, 0) : graph_tensor({ 1, 4 }) };
+				return make_graph_program(values, { 0 }, { 5 }, { { "aten::mul", "out", { 0, 1, 2 } }, { "aten::add", "out", { 2, 3, 4, 5 } } });
+			};
+			ExecuTorchTensor input = ExecuTorchTensor::from_float32(PackedFloat32Array({ 1.0f, 2.0f, 3.0f, 4.0f }), Vector<int64_t>({ 1, 4 }));
+
+			PackedByteArray planned = make_program(true, 16);
+			ExecuTorchMethodGraph graph;
+			REQUIRE(ExecuTorchPTEParser::parse_graph(planned.ptr(), planned.size(), "forward", graph) == OK);
+			CHECK(graph.values[2].tensor.memory_id == 1);
+			CHECK(graph.values[2].tensor.memory_offset == 16);
+
+			// The output overwrote the input's slot, so a second call must start from its own input
+			ExecuTorchNativeExecutor planned_executor;
+			REQUIRE(planned_executor.load(planned.ptr(), planned.size()) == OK);
+			std::vector<ExecuTorchTensor> outputs;
+			PackedFloat32Array values;
+			for (int call = 0; call < 2; call++) {
+				REQUIRE(planned_executor.execute({ input }, outputs) == OK);
+				REQUIRE(outputs[0].to_float32(values) == OK);
+				CHECK(values == PackedFloat32Array({ 3.0f, 5.0f, 7.0f, 9.0f }));
+			}
+
+			ExecuTorchNativeExecutor unplanned_executor;
+			PackedByteArray unplanned = make_program(false, 0);
+			REQUIRE(unplanned_executor.load(unplanned.ptr(), unplanned.size()) == OK);
+			CHECK(planned_executor.get_memory_bytes() < unplanned_executor.get_memory_bytes());
+
+			CHECK(native_unsupported_reason(make_program(true, 2)).contains("unaligned"));
+		}
+	}
+
+	TEST_CASE("ExecuTorchResource - Parsed Metadata") {
+		Ref<ExecuTorchResource> resource;
+		resource.instantiate();
+		REQUIRE(resource->swap_model_data(make_linear_program(), false) == OK);
+
+		Array inputs = resource->get_input_info();
+		REQUIRE(inputs.size() == 2);
+		CHECK(int(Dictionary(inputs[1])["dtype"]) == ExecuTorchResource::TENSOR_TYPE_INT8);
+		CHECK(int(Dictionary(inputs[1])["dynamism"]) == (int)ExecuTorchShapeDynamism::DYNAMIC_BOUND);
+		CHECK(resource->get_output_names().size() == 1);
+		CHECK(String(resource->get_output_names()[0]) == "output_0");
+
+		SUBCASE("Inputs Conform To Declared Types") {
+			PackedFloat32Array features = { 1.0f, 2.0f, 3.0f };
+			PackedFloat32Array mask = { 1.0f, 0.0f };
+
+			Dictionary feed;
+			feed["input_0"] = features;
+			feed["input_1"] = mask; // Cast to int8, within the bound of 4
+			Dictionary result = resource->forward(feed);
+			CHECK(result.has("output_0"));
+
+			ERR_PRINT_OFF;
+			feed["input_0"] = PackedFloat32Array({ 1.0f, 2.0f });
+			CHECK(resource->forward(feed).is_empty());
+			feed["input_0"] = features;
+			feed["input_1"] = PackedFloat32Array({ 1.0f, 1.0f, 1.0f, 1.0f, 1.0f });
+			CHECK(resource->forward(feed).is_empty());
+			ERR_PRINT_ON;
+		}
+
+		SUBCASE("Raw Bytes Read As The Declared Type") {
+			Dictionary feed;
+			feed["input_0"] = PackedFloat32Array({ 1.0f, 2.0f, 3.0f });
+			feed["input_1"] = PackedByteArray({ 0x80, 0xFF, 0x01, 0x7F }); // int8 -128, -1, 1, 127
+			Dictionary result = resource->forward(feed);
+
+			// The mock module maps every input through 2x + 3, so the second output shows how the bytes were read
+			REQUIRE(result.has("output_1"));
+			CHECK(PackedFloat32Array(result["output_1"]) == PackedFloat32Array({ -253.0f, 1.0f, 5.0f, 257.0f }));
+		}
+	}
+}
+
+} // namespace TestExecuTorchPTEParser
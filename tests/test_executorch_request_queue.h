@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  test_executorch_request_queue.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../executorch_request_queue.h"
+#include "test_executorch_common.h"
+
+#include "tests/test_macros.h"
+
+namespace TestExecuTorchRequestQueue {
+
+TEST_SUITE("[ExecuTorch] ExecuTorchRequestQueue Tests") {
+	TEST_CASE("ExecuTorchIndexRing - Bounded FIFO") {
+		ExecuTorchIndexRing ring;
+		ring.reserve(3);
+		CHECK(ring.get_capacity() == 4);
+
+		for (uint32_t i = 0; i < 4; i++) {
+			CHECK(ring.push(i));
+		}
+		CHECK_FALSE(ring.push(4));
+
+		uint32_t value = 0;
+		for (uint32_t i = 0; i < 4; i++) {
+			REQUIRE(ring.pop(value));
+			CHECK(value == i);
+		}
+		CHECK_FALSE(ring.pop(value));
+	}
+
+	TEST_CASE("ExecuTorchRequestQueue - Overflow Policies") {
+		Ref<ExecuTorchResource> model = TestExecuTorch::make_mock_model();
+
+		PackedFloat32Array values;
+		values.resize(8);
+		values.fill(0.5f);
+		ExecuTorchTensor input = ExecuTorchTensor::from_float32(values);
+		ExecuTorchRequestQueue queue(2, 1);
+		std::vector<ExecuTorchTensor> outputs;
+
+		SUBCASE("Round Trip") {
+			int64_t ticket = queue.submit(model, &input, 1);
+			REQUIRE(ticket != ExecuTorchRequestQueue::INVALID_TICKET);
+			REQUIRE(queue.take(ticket, outputs) == OK);
+			REQUIRE(outputs.size() == 1);
+			CHECK(outputs[0].get_element_count() == values.size());
+
+			ERR_PRINT_OFF;
+			CHECK(queue.take(ticket, outputs) == ERR_INVALID_PARAMETER);
+			ERR_PRINT_ON;
+			CHECK(queue.get_stats().in_flight == 0);
+		}
+
+		SUBCASE("Drop Counts And Keeps Slots") {
+			int64_t first = queue.submit(model, &input, 1, ExecuTorchRequestQueue::OVERFLOW_DROP);
+			int64_t second = queue.submit(model, &input, 1, ExecuTorchRequestQueue::OVERFLOW_DROP);
+			CHECK(queue.submit(model, &input, 1, ExecuTorchRequestQueue::OVERFLOW_DROP) == ExecuTorchRequestQueue::INVALID_TICKET);
+
+			ExecuTorchRequestQueue::Stats stats = queue.get_stats();
+			CHECK(stats.dropped == 1);
+			CHECK(stats.capacity == 2);
+			CHECK(queue.take(first, outputs) == OK);
+			queue.cancel(second);
+		}
+
+		SUBCASE("Grow Adds Slots") {
+			std::vector<int64_t> tickets;
+			for (int i = 0; i < 5; i++) {
+				tickets.push_back(queue.submit(model, &input, 1, ExecuTorchRequestQueue::OVERFLOW_GROW));
+			}
+
+			ExecuTorchRequestQueue::Stats stats = queue.get_stats();
+			CHECK(stats.capacity == 8); // 2, then 2 more, then 4 more
+			CHECK(stats.grown == 2);
+			CHECK(stats.in_flight == 5);
+			for (int64_t ticket : tickets) {
+				CHECK(queue.take(ticket, outputs) == OK);
+			}
+		}
+	}
+}
+
+} // namespace TestExecuTorchRequestQueue
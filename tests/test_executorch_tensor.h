@@ -0,0 +1,309 @@
+/**************************************************************************/
+/*  test_executorch_tensor.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../executorch_kernels.h"
+#include "../executorch_resource.h"
+#include "../executorch_tensor.h"
+
+#include "tests/test_macros.h"
+
+namespace TestExecuTorchTensor {
+
+TEST_SUITE("[ExecuTorch] ExecuTorchTensor Tests") {
+	TEST_CASE("ExecuTorchKernels - Conversion Kernels") {
+		// 37 elements exercises both the vector loop and the scalar tail.
+		PackedFloat32Array values;
+		for (int i = 0; i < 37; i++) {
+			values.push_back((i - 18) * 0.25f);
+		}
+
+		SUBCASE("Float16 Round Trip") {
+			Vector<uint16_t> half;
+			half.resize(values.size());
+			PackedFloat32Array back;
+			back.resize(values.size());
+			ExecuTorchKernels::float32_to_float16(values.ptr(), half.ptrw(), values.size());
+			ExecuTorchKernels::float16_to_float32(half.ptr(), back.ptrw(), values.size());
+
+			// Quarter steps in this range are exact in fp16.
+			CHECK(back == values);
+			CHECK(ExecuTorchKernels::float32_to_float16_scalar(1.0f) == 0x3C00);
+			CHECK(ExecuTorchKernels::float32_to_float16_scalar(65520.0f) == 0x7C00);
+		}
+
+		SUBCASE("BFloat16 Round Trip") {
+			Vector<uint16_t> half;
+			half.resize(values.size());
+			PackedFloat32Array back;
+			back.resize(values.size());
+			ExecuTorchKernels::float32_to_bfloat16(values.ptr(), half.ptrw(), values.size());
+			ExecuTorchKernels::bfloat16_to_float32(half.ptr(), back.ptrw(), values.size());
+
+			CHECK(back == values);
+			CHECK(ExecuTorchKernels::float32_to_bfloat16_scalar(1.0f) == 0x3F80);
+		}
+
+		SUBCASE("Int8 Quantize and Dequantize") {
+			Vector<int8_t> quantized;
+			quantized.resize(values.size());
+			PackedFloat32Array back;
+			back.resize(values.size());
+			ExecuTorchKernels::quantize_int8(values.ptr(), quantized.ptrw(), values.size(), 0.25f, 3);
+			ExecuTorchKernels::dequantize_int8(quantized.ptr(), back.ptrw(), values.size(), 0.25f, 3);
+
+			CHECK(quantized[0] == -18 + 3);
+			CHECK(back == values);
+
+			// Saturates instead of wrapping.
+			float big[2] = { 1000.0f, -1000.0f };
+			int8_t clamped[2];
+			ExecuTorchKernels::quantize_int8(big, clamped, 2, 1.0f, 0);
+			CHECK(clamped[0] == 127);
+			CHECK(clamped[1] == -128);
+		}
+
+		SUBCASE("UInt8 Quantize and Dequantize") {
+			Vector<uint8_t> quantized;
+			quantized.resize(values.size());
+			PackedFloat32Array back;
+			back.resize(values.size());
+			ExecuTorchKernels::quantize_uint8(values.ptr(), quantized.ptrw(), values.size(), 0.25f, 128);
+			ExecuTorchKernels::dequantize_uint8(quantized.ptr(), back.ptrw(), values.size(), 0.25f, 128);
+
+			CHECK(quantized[0] == 128 - 18);
+			CHECK(back == values);
+		}
+	}
+
+	TEST_CASE("ExecuTorchKernels - Instruction Set Levels") {
+		ExecuTorchKernels::Level detected = ExecuTorchKernels::get_level();
+		CHECK(ExecuTorchKernels::is_level_supported(detected));
+		CHECK(ExecuTorchKernels::is_level_supported(ExecuTorchKernels::LEVEL_SCALAR));
+
+		// 100 elements reach the main loop of every level plus a tail
+		PackedFloat32Array values;
+		for (int i = 0; i < 100; i++) {
+			values.push_back((i - 50) * 3.37f);
+		}
+
+		Vector<uint16_t> expected_half;
+		Vector<int8_t> expected_quantized;
+		PackedFloat32Array expected_affine;
+		for (int level = ExecuTorchKernels::LEVEL_SCALAR; level <= ExecuTorchKernels::LEVEL_NEON; level++) {
+			if (!ExecuTorchKernels::is_level_supported((ExecuTorchKernels::Level)level)) {
+				continue;
+			}
+			REQUIRE(ExecuTorchKernels::set_level((ExecuTorchKernels::Level)level) == level);
+
+			Vector<uint16_t> half;
+			half.resize(values.size());
+			Vector<int8_t> quantized;
+			quantized.resize(values.size());
+			PackedFloat32Array affine;
+			affine.resize(values.size());
+			ExecuTorchKernels::float32_to_float16(values.ptr(), half.ptrw(), values.size());
+			ExecuTorchKernels::quantize_int8(values.ptr(), quantized.ptrw(), values.size(), 0.7f, -5);
+			ExecuTorchKernels::affine_float32(values.ptr(), affine.ptrw(), values.size(), 2.0f, 3.0f);
+
+			if (level == ExecuTorchKernels::LEVEL_SCALAR) {
+				expected_half = half;
+				expected_quantized = quantized;
+				expected_affine = affine;
+			} else {
+				CHECK_MESSAGE(half == expected_half, ExecuTorchKernels::get_level_name((ExecuTorchKernels::Level)level));
+				CHECK_MESSAGE(quantized == expected_quantized, ExecuTorchKernels::get_level_name((ExecuTorchKernels::Level)level));
+				CHECK_MESSAGE(affine == expected_affine, ExecuTorchKernels::get_level_name((ExecuTorchKernels::Level)level));
+			}
+		}
+
+		// Forcing a level the CPU lacks steps down to one it has
+		ExecuTorchKernels::Level forced = ExecuTorchKernels::set_level(ExecuTorchKernels::LEVEL_NEON);
+		CHECK(ExecuTorchKernels::is_level_supported(forced));
+
+		ExecuTorchKernels::set_level(detected);
+	}
+
+	TEST_CASE("ExecuTorchKernels - Packed GEMM") {
+		ExecuTorchKernels::Level detected = ExecuTorchKernels::get_level();
+
+		// 300 features cross a depth block, 21 outputs pad the second panel, 7 rows leave a partial tile
+		const size_t rows = 7, in_features = 300, out_features = 21;
+		Vector<float> input, weight, bias;
+		for (size_t i = 0; i < rows * in_features; i++) {
+			input.push_back(((i * 37) % 101) / 50.0f - 1.0f);
+		}
+		for (size_t i = 0; i < out_features * in_features; i++) {
+			weight.push_back(((i * 53) % 97) / 48.0f - 1.0f);
+		}
+		for (size_t o = 0; o < out_features; o++) {
+			bias.push_back(o * 0.25f);
+		}
+		Vector<float> packed;
+		packed.resize(ExecuTorchKernels::get_gemm_packed_size(in_features, out_features));
+		ExecuTorchKernels::pack_gemm_weights(weight.ptr(), packed.ptrw(), in_features, out_features);
+
+		for (int level = ExecuTorchKernels::LEVEL_SCALAR; level <= ExecuTorchKernels::LEVEL_NEON; level++) {
+			if (!ExecuTorchKernels::is_level_supported((ExecuTorchKernels::Level)level)) {
+				continue;
+			}
+			ExecuTorchKernels::set_level((ExecuTorchKernels::Level)level);
+			Vector<float> output;
+			output.resize(rows * out_features);
+			ExecuTorchKernels::gemm_packed_float32(input.ptr(), packed.ptr(), bias.ptr(), output.ptrw(), rows, in_features, out_features);
+
+			for (size_t r = 0; r < rows; r++) {
+				for (size_t o = 0; o < out_features; o++) {
+					double expected = bias[o];
+					for (size_t i = 0; i < in_features; i++) {
+						expected += (double)input[r * in_features + i] * weight[o * in_features + i];
+					}
+					CHECK_MESSAGE(output[r * out_features + o] == doctest::Approx(expected).epsilon(1e-4), ExecuTorchKernels::get_level_name((ExecuTorchKernels::Level)level));
+				}
+			}
+		}
+
+		ExecuTorchKernels::set_level(detected);
+	}
+
+	TEST_CASE("ExecuTorchTensor - Variant Wrapping") {
+		SUBCASE("Packed Float Array Is Not Copied") {
+			PackedFloat32Array values;
+			values.resize(1024);
+			values.fill(1.5f);
+
+			ExecuTorchTensor tensor;
+			CHECK(ExecuTorchTensor::from_variant(values, tensor) == OK);
+			CHECK(tensor.dtype == ExecuTorchScalarType::FLOAT32);
+			CHECK(tensor.get_element_count() == 1024);
+			CHECK(tensor.get_data() == (const uint8_t *)values.ptr());
+
+			PackedFloat32Array view;
+			CHECK(tensor.to_float32(view) == OK);
+			CHECK(view.ptr() == values.ptr());
+		}
+
+		SUBCASE("Dictionary Reinterprets Raw Bytes") {
+			PackedFloat32Array values = { 1.0f, -2.0f, 0.5f, 4.0f };
+			PackedByteArray half = ExecuTorchResource::encode_tensor(values, ExecuTorchResource::TENSOR_TYPE_FLOAT16);
+			CHECK(half.size() == 8);
+
+			Dictionary description;
+			description["data"] = half;
+			description["dtype"] = ExecuTorchResource::TENSOR_TYPE_FLOAT16;
+			description["shape"] = PackedInt64Array({ 2, 2 });
+
+			ExecuTorchTensor tensor;
+			CHECK(ExecuTorchTensor::from_variant(description, tensor) == OK);
+			CHECK(tensor.dtype == ExecuTorchScalarType::FLOAT16);
+			CHECK(tensor.get_element_count() == 4);
+
+			PackedFloat32Array decoded;
+			CHECK(tensor.to_float32(decoded) == OK);
+			CHECK(decoded == values);
+		}
+
+		SUBCASE("Mismatched Shape Is Rejected") {
+			Dictionary description;
+			PackedByteArray bytes;
+			bytes.resize(6);
+			description["data"] = bytes;
+			description["dtype"] = ExecuTorchResource::TENSOR_TYPE_FLOAT16;
+			description["shape"] = PackedInt64Array({ 4 });
+
+			ExecuTorchTensor tensor;
+			ERR_PRINT_OFF;
+			CHECK(ExecuTorchTensor::from_variant(description, tensor) != OK);
+			ERR_PRINT_ON;
+		}
+
+		SUBCASE("Encode and Decode Helpers") {
+			PackedFloat32Array values = { 0.0f, 0.5f, 1.0f, -1.0f };
+			PackedByteArray quantized = ExecuTorchResource::encode_tensor(values, ExecuTorchResource::TENSOR_TYPE_INT8, 0.5f, 0);
+			CHECK(quantized.size() == 4);
+			CHECK(ExecuTorchResource::decode_tensor(quantized, ExecuTorchResource::TENSOR_TYPE_INT8, 0.5f, 0) == values);
+
+			PackedByteArray bf16 = ExecuTorchResource::encode_tensor(values, ExecuTorchResource::TENSOR_TYPE_BFLOAT16);
+			CHECK(ExecuTorchResource::decode_tensor(bf16, ExecuTorchResource::TENSOR_TYPE_BFLOAT16) == values);
+		}
+
+		SUBCASE("Integer Encode Saturates") {
+			PackedFloat32Array values = { NAN, 1e10f, -1e10f, 2.7f, -2.7f };
+			PackedByteArray int16 = ExecuTorchResource::encode_tensor(values, ExecuTorchResource::TENSOR_TYPE_INT16);
+			CHECK(ExecuTorchResource::decode_tensor(int16, ExecuTorchResource::TENSOR_TYPE_INT16) == PackedFloat32Array({ 0.0f, 32767.0f, -32768.0f, 2.0f, -2.0f }));
+
+			PackedByteArray int32 = ExecuTorchResource::encode_tensor(values, ExecuTorchResource::TENSOR_TYPE_INT32);
+			PackedFloat32Array decoded = ExecuTorchResource::decode_tensor(int32, ExecuTorchResource::TENSOR_TYPE_INT32);
+			REQUIRE(decoded.size() == 5);
+			CHECK(decoded[0] == 0.0f);
+			CHECK(decoded[1] == (float)INT32_MAX);
+			CHECK(decoded[2] == (float)INT32_MIN);
+		}
+	}
+
+	TEST_CASE("ExecuTorchModule - Reduced Precision Inputs") {
+		ExecuTorchModule module;
+		PackedByteArray mock_data;
+		mock_data.resize(32);
+		mock_data.fill(0x42);
+		REQUIRE(module.load_from_buffer(mock_data) == OK);
+
+		SUBCASE("Float16 Input") {
+			Dictionary input;
+			input["data"] = ExecuTorchResource::encode_tensor(PackedFloat32Array({ 1.0f, 2.0f }), ExecuTorchResource::TENSOR_TYPE_FLOAT16);
+			input["dtype"] = ExecuTorchResource::TENSOR_TYPE_FLOAT16;
+
+			Dictionary inputs;
+			inputs["input_0"] = input;
+			Dictionary outputs = module.forward(inputs);
+
+			REQUIRE(outputs.has("output_0"));
+			PackedFloat32Array result = outputs["output_0"];
+			CHECK(result == PackedFloat32Array({ 5.0f, 7.0f }));
+		}
+
+		SUBCASE("Int8 Input") {
+			Dictionary input;
+			input["data"] = ExecuTorchResource::encode_tensor(PackedFloat32Array({ -1.0f, 0.5f }), ExecuTorchResource::TENSOR_TYPE_INT8, 0.5f, 0);
+			input["dtype"] = ExecuTorchResource::TENSOR_TYPE_INT8;
+			input["scale"] = 0.5f;
+
+			Dictionary inputs;
+			inputs["input_0"] = input;
+			Dictionary outputs = module.forward(inputs);
+
+			REQUIRE(outputs.has("output_0"));
+			PackedFloat32Array result = outputs["output_0"];
+			CHECK(result == PackedFloat32Array({ 1.0f, 4.0f }));
+		}
+	}
+}
+} // namespace TestExecuTorchTensor
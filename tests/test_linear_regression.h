@@ -48,5 +48,124 @@ TEST_SUITE("[SceneTree][ExecuTorch] Linear Regression Tests") {
 			memdelete(regression);
 		}
 	}
+
+	TEST_CASE("ExecuTorchLinearRegression - Multivariate") {
+		ExecuTorchLinearRegression *regression = memnew(ExecuTorchLinearRegression);
+
+		SUBCASE("Scalar Batch") {
+			// The default 1x1 model maps every value of the batch
+			PackedFloat32Array outputs = regression->predict_batch(PackedFloat32Array({ 0.0f, 1.0f, -2.0f }));
+			CHECK(outputs == PackedFloat32Array({ 3.0f, 5.0f, -1.0f }));
+		}
+
+		SUBCASE("Weight Matrix") {
+			// y0 = x0 + 2 x1 - x2, y1 = 0.5 x2 + 1
+			REQUIRE(regression->set_parameters(PackedFloat32Array({ 1.0f, 2.0f, -1.0f, 0.0f, 0.0f, 0.5f }), PackedFloat32Array({ 0.0f, 1.0f })) == OK);
+			CHECK(regression->get_input_features() == 3);
+			CHECK(regression->get_output_features() == 2);
+			CHECK(regression->get_slope() == 1.0);
+
+			PackedFloat32Array outputs = regression->predict_batch(PackedFloat32Array({ 1.0f, 1.0f, 1.0f, 2.0f, 0.0f, 4.0f }));
+			CHECK(outputs == PackedFloat32Array({ 2.0f, 1.5f, -2.0f, 3.0f }));
+
+			ERR_PRINT_OFF;
+			CHECK(regression->predict_batch(PackedFloat32Array({ 1.0f, 2.0f })).is_empty());
+			CHECK(regression->set_parameters(PackedFloat32Array({ 1.0f, 2.0f, 3.0f }), PackedFloat32Array({ 0.0f, 1.0f })) == ERR_INVALID_PARAMETER);
+			ERR_PRINT_ON;
+		}
+
+		SUBCASE("Properties Set One At A Time") {
+			regression->set_input_features(2);
+			CHECK_FALSE(regression->is_valid());
+			regression->set_weights(PackedFloat32Array({ 1.0f, 1.0f }));
+			CHECK(regression->is_valid());
+			CHECK(regression->predict_batch(PackedFloat32Array({ 2.0f, 5.0f })) == PackedFloat32Array({ 10.0f }));
+		}
+
+		memdelete(regression);
+	}
+
+	TEST_CASE("ExecuTorchLinearRegression - Fitting") {
+		ExecuTorchLinearRegression *regression = memnew(ExecuTorchLinearRegression);
+		REQUIRE(regression->set_parameters(PackedFloat32Array({ 0.0f, 0.0f }), PackedFloat32Array({ 0.0f })) == OK);
+
+		// y = 2 x0 - 3 x1 + 0.5
+		PackedFloat32Array xs, ys;
+		for (int i = 0; i < 1000; i++) {
+			float x0 = (i % 17) / 4.0f - 2.0f;
+			float x1 = ((i * 7) % 23) / 5.0f - 2.0f;
+			xs.push_back(x0);
+			xs.push_back(x1);
+			ys.push_back(2.0f * x0 - 3.0f * x1 + 0.5f);
+		}
+
+		SUBCASE("Streamed Batches") {
+			for (int batch = 0; batch < 4; batch++) {
+				REQUIRE(regression->fit_stream(xs.slice(batch * 500, (batch + 1) * 500), ys.slice(batch * 250, (batch + 1) * 250)) == OK);
+			}
+			CHECK(regression->get_fit_sample_count() == 1000);
+			REQUIRE(regression->solve_fit() == OK);
+
+			PackedFloat32Array weights = regression->get_weights();
+			CHECK(weights[0] == doctest::Approx(2.0).epsilon(1e-4));
+			CHECK(weights[1] == doctest::Approx(-3.0).epsilon(1e-4));
+			CHECK(regression->get_intercept() == doctest::Approx(0.5).epsilon(1e-4));
+		}
+
+		SUBCASE("Too Few Samples") {
+			REQUIRE(regression->fit_stream(PackedFloat32Array({ 1.0f, 2.0f }), PackedFloat32Array({ 3.0f })) == OK);
+			ERR_PRINT_OFF;
+			CHECK(regression->solve_fit() == ERR_CANT_RESOLVE);
+			CHECK(regression->fit_stream(PackedFloat32Array({ 1.0f, 2.0f }), PackedFloat32Array()) == ERR_INVALID_PARAMETER);
+			ERR_PRINT_ON;
+
+			regression->set_ridge(0.1);
+			CHECK(regression->solve_fit() == OK);
+		}
+
+		SUBCASE("Shape Change Restarts The Sums") {
+			REQUIRE(regression->fit_stream(xs, ys) == OK);
+
+			// One feature and two outputs keeps z = [x, 1, y] four wide
+			REQUIRE(regression->set_parameters(PackedFloat32Array({ 0.0f, 0.0f }), PackedFloat32Array({ 0.0f, 0.0f })) == OK);
+			ERR_PRINT_OFF;
+			CHECK(regression->solve_fit() == ERR_UNCONFIGURED);
+			ERR_PRINT_ON;
+
+			// y = [2 x + 1, -x]
+			PackedFloat32Array features, pairs;
+			for (int i = 0; i < 10; i++) {
+				features.push_back(float(i));
+				pairs.push_back(2.0f * i + 1.0f);
+				pairs.push_back(-float(i));
+			}
+			REQUIRE(regression->fit_stream(features, pairs) == OK);
+			CHECK(regression->get_fit_sample_count() == 10);
+			REQUIRE(regression->solve_fit() == OK);
+			PackedFloat32Array weights = regression->get_weights();
+			PackedFloat32Array bias = regression->get_bias();
+			REQUIRE(weights.size() == 2);
+			CHECK(weights[0] == doctest::Approx(2.0).epsilon(1e-4));
+			CHECK(weights[1] == doctest::Approx(-1.0).epsilon(1e-4));
+			CHECK(bias[0] == doctest::Approx(1.0).epsilon(1e-4));
+			CHECK(bias[1] == doctest::Approx(0.0).epsilon(1e-4));
+		}
+
+		SUBCASE("Recursive Least Squares") {
+			REQUIRE(regression->fit_recursive(xs, ys) == OK);
+			CHECK(regression->get_slope() == doctest::Approx(2.0).epsilon(1e-3));
+			CHECK(regression->get_intercept() == doctest::Approx(0.5).epsilon(1e-3));
+
+			// With forgetting the model follows a shifted target
+			regression->set_forgetting_factor(0.99);
+			for (int i = 0; i < ys.size(); i++) {
+				ys.set(i, ys[i] + 10.0f);
+			}
+			REQUIRE(regression->fit_recursive(xs, ys) == OK);
+			CHECK(regression->get_intercept() == doctest::Approx(10.5).epsilon(1e-2));
+		}
+
+		memdelete(regression);
+	}
 } // TEST_SUITE
 } // namespace TestLinearRegression